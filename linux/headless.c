@@ -0,0 +1,321 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "../src/UI/Window.h"
+#include "../src/core/time.h"
+#include "../src/Data/CityInfo.h"
+#include "../src/Game.h"
+#include "../src/GameFile.h"
+#include "../src/GameTick.h"
+#include "../src/System.h"
+
+#include "core/jobs.h"
+#include "core/profiler.h"
+#include "core/trace.h"
+
+#include "game/settings.h"
+#include "game/time.h"
+
+#include <execinfo.h>
+#include <signal.h>
+
+// Batch simulation runner: no SDL video, audio or window, ticks are driven directly
+
+#define MAX_RUNS 1024
+
+enum {
+	RunStatus_Ok = 0,
+	RunStatus_LoadFailed = 1,
+	RunStatus_WriteFailed = 2,
+	RunStatus_Crashed = 3,
+};
+
+static const char *statusNames[] = {
+	"ok", "load-failed", "write-failed", "crashed"
+};
+
+struct Run {
+	const char *savedGameToLoad;
+	const char *savedGameToWrite;
+	int ticks;
+	pid_t pid;
+	int resultFd;
+};
+
+struct RunResult {
+	int status;
+	double wallMillis;
+	int year;
+	int month;
+	int population;
+	int treasury;
+	int ratingCulture;
+	int ratingProsperity;
+	int ratingPeace;
+	int ratingFavor;
+};
+
+static struct Run runs[MAX_RUNS];
+static struct RunResult results[MAX_RUNS];
+static int numRuns;
+static int workersPerRun;
+
+static void handler(int sig)
+{
+	void *array[100];
+	size_t size = backtrace(array, 100);
+	fprintf(stderr, "Error: signal %d:\n", sig);
+	backtrace_symbols_fd(array, size, STDERR_FILENO);
+	_exit(1);
+}
+
+// System callbacks: nothing to do without a window
+
+void System_resize(int width, int height)
+{
+}
+
+void System_toggleFullscreen()
+{
+}
+
+void System_initCursors()
+{
+}
+
+void System_setCursor(int cursorId)
+{
+}
+
+void System_exit()
+{
+}
+
+static double nowMillis()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void simulate(struct Run *run, struct RunResult *result, int profile, int trace)
+{
+	char profileCsv[300];
+	char traceFile[300];
+	memset(result, 0, sizeof(struct RunResult));
+	if (!GameFile_loadSavedGame(run->savedGameToLoad)) {
+		result->status = RunStatus_LoadFailed;
+		return;
+	}
+	UI_Window_goTo(Window_City);
+	time_set_millis(0);
+	if (profile) {
+		snprintf(profileCsv, sizeof(profileCsv), "%s.profile.csv", run->savedGameToLoad);
+		GameTick_enableProfiler(profileCsv);
+	}
+	if (trace) {
+		snprintf(traceFile, sizeof(traceFile), "%s.trace", run->savedGameToLoad);
+		trace_enable(TRACE_LEVEL_DEBUG, traceFile);
+	}
+
+	double start = nowMillis();
+	for (int i = 1; i <= run->ticks; i++) {
+		time_set_millis(2 * i);
+		GameTick_doTick();
+	}
+	result->wallMillis = nowMillis() - start;
+	profiler_finish();
+	trace_finish();
+
+	result->year = game_time_year();
+	result->month = game_time_month();
+	result->population = Data_CityInfo.population;
+	result->treasury = Data_CityInfo.treasury;
+	result->ratingCulture = Data_CityInfo.ratingCulture;
+	result->ratingProsperity = Data_CityInfo.ratingProsperity;
+	result->ratingPeace = Data_CityInfo.ratingPeace;
+	result->ratingFavor = Data_CityInfo.ratingFavor;
+
+	if (run->savedGameToWrite && !GameFile_writeSavedGame(run->savedGameToWrite)) {
+		result->status = RunStatus_WriteFailed;
+	}
+}
+
+static void startRun(struct Run *run, int verbose, int profile, int trace)
+{
+	int fds[2];
+	if (pipe(fds) != 0) {
+		perror("pipe");
+		exit(1);
+	}
+	fflush(stdout);
+	run->pid = fork();
+	if (run->pid < 0) {
+		perror("fork");
+		exit(1);
+	}
+	if (run->pid == 0) {
+		close(fds[0]);
+		if (workersPerRun > 0) {
+			jobs_start(workersPerRun);
+		}
+		signal(SIGSEGV, handler);
+		if (!verbose) {
+			freopen("/dev/null", "w", stdout);
+		}
+		struct RunResult result;
+		simulate(run, &result, profile, trace);
+		if (write(fds[1], &result, sizeof(result)) != sizeof(result)) {
+			_exit(1);
+		}
+		_exit(0);
+	}
+	close(fds[1]);
+	run->resultFd = fds[0];
+}
+
+static void finishRun(pid_t pid)
+{
+	for (int i = 0; i < numRuns; i++) {
+		if (runs[i].pid == pid) {
+			if (read(runs[i].resultFd, &results[i], sizeof(struct RunResult)) != sizeof(struct RunResult)) {
+				memset(&results[i], 0, sizeof(struct RunResult));
+				results[i].status = RunStatus_Crashed;
+			}
+			close(runs[i].resultFd);
+			runs[i].pid = 0;
+			return;
+		}
+	}
+}
+
+static void printResults()
+{
+	printf("save,ticks,wall_ms,ticks_per_sec,status,year,month,population,treasury,culture,prosperity,peace,favor\n");
+	for (int i = 0; i < numRuns; i++) {
+		struct RunResult *r = &results[i];
+		double ticksPerSecond = r->wallMillis > 0 ? runs[i].ticks * 1000.0 / r->wallMillis : 0;
+		printf("%s,%d,%.1f,%.1f,%s,%d,%d,%d,%d,%d,%d,%d,%d\n",
+			runs[i].savedGameToLoad, runs[i].ticks, r->wallMillis, ticksPerSecond,
+			statusNames[r->status], r->year, r->month, r->population, r->treasury,
+			r->ratingCulture, r->ratingProsperity, r->ratingPeace, r->ratingFavor);
+	}
+}
+
+static int parseRun(char *arg, struct Run *run)
+{
+	// Format: <save>:<ticks>[:<output save>]
+	char *ticks = strchr(arg, ':');
+	if (!ticks) {
+		return 0;
+	}
+	*ticks++ = 0;
+	char *output = strchr(ticks, ':');
+	if (output) {
+		*output++ = 0;
+	}
+	run->savedGameToLoad = arg;
+	run->savedGameToWrite = output && *output ? output : 0;
+	run->ticks = atoi(ticks);
+	return run->ticks > 0;
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr, "Usage: %s [-j jobs] [-d datadir] [-p] [-s] [-t] [-v] [-w workers] <save>:<ticks>[:<output save>] ...\n", program);
+	fprintf(stderr, "  -j jobs     number of simulations to run in parallel (default 1)\n");
+	fprintf(stderr, "  -d datadir  game data directory (default ../data)\n");
+	fprintf(stderr, "  -p          write tick timings of each run to <save>.profile.csv\n");
+	fprintf(stderr, "  -s          spread the building updates over the ticks of a day\n");
+	fprintf(stderr, "  -t          write trace events of each run to <save>.trace\n");
+	fprintf(stderr, "  -v          do not suppress game output of the simulations\n");
+	fprintf(stderr, "  -w workers  worker threads of each run for the parallel city updates,\n");
+	fprintf(stderr, "              0 runs them serially (default: processors / jobs)\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *dataDir = "../data";
+	int jobs = 1;
+	int verbose = 0;
+	int profile = 0;
+	int trace = 0;
+	int spread = 0;
+	int workers = -1;
+	int opt;
+	while ((opt = getopt(argc, argv, "j:d:pstvw:")) != -1) {
+		switch (opt) {
+			case 'j': jobs = atoi(optarg); break;
+			case 'd': dataDir = optarg; break;
+			case 'p': profile = 1; break;
+			case 's': spread = 1; break;
+			case 't': trace = 1; break;
+			case 'v': verbose = 1; break;
+			case 'w': workers = atoi(optarg); break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+	if (jobs < 1) {
+		jobs = 1;
+	}
+	for (int i = optind; i < argc; i++) {
+		if (numRuns >= MAX_RUNS || !parseRun(argv[i], &runs[numRuns])) {
+			usage(argv[0]);
+			return 1;
+		}
+		numRuns++;
+	}
+	if (numRuns <= 0) {
+		usage(argv[0]);
+		return 1;
+	}
+	signal(SIGSEGV, handler);
+
+	if (chdir(dataDir) != 0) {
+		fprintf(stderr, "Data directory %s not found\n", dataDir);
+		return 1;
+	}
+	if (!Game_preInit()) {
+		return 1;
+	}
+	if (!Game_init()) {
+		return 2;
+	}
+	GameTick_setSpreadUpdates(spread);
+	// Worker threads do not survive fork(): each run starts its own share of them
+	workersPerRun = workers >= 0 ? workers : jobs_num_workers() / jobs;
+	jobs_stop();
+	// Parallel runs would all write last.sav
+	if (setting_monthly_autosave()) {
+		setting_toggle_monthly_autosave();
+	}
+
+	// Game data is loaded once, each run gets its own copy of the game state
+	int active = 0;
+	for (int i = 0; i < numRuns; i++) {
+		if (active >= jobs) {
+			finishRun(wait(0));
+			active--;
+		}
+		startRun(&runs[i], verbose, profile, trace);
+		active++;
+	}
+	while (active > 0) {
+		finishRun(wait(0));
+		active--;
+	}
+
+	printResults();
+	// Game_exit() is not called on purpose: batch runs must not save settings
+	for (int i = 0; i < numRuns; i++) {
+		if (results[i].status != RunStatus_Ok) {
+			return 3;
+		}
+	}
+	return 0;
+}
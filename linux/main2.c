@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "../src/UI/Window.h"
@@ -17,8 +18,11 @@
 #include "../src/Graphics.h" // debug
 #include "../src/System.h"
 #include "../src/Game.h"
+#include "../src/GameTick.h"
 
+#include "core/jobs.h"
 #include "core/lang.h"
+#include "core/trace.h"
 #include "game/settings.h"
 #include "graphics/mouse.h"
 
@@ -159,6 +163,20 @@ void System_initCursors()
 
 #include "../src/GameFile.h"
 
+static void initDiagnostics()
+{
+	// Tick timings are written to this CSV file on exit
+	const char *profileCsv = getenv("JULIUS_PROFILE");
+	if (profileCsv) {
+		GameTick_enableProfiler(profileCsv);
+	}
+	// All trace events are written to this binary file on exit, see julius-tracedump
+	const char *traceFile = getenv("JULIUS_TRACE");
+	if (traceFile) {
+		trace_enable(TRACE_LEVEL_DEBUG, traceFile);
+	}
+}
+
 void runTicks(int ticks)
 {
 	int originalSpeed = setting_game_speed();
@@ -172,7 +190,7 @@ void runTicks(int ticks)
 	setting_reset_speeds(originalSpeed, setting_scroll_speed());
 }
 
-int runAutopilot(const char *savedGameToLoad, const char *savedGameToWrite, int ticksToRun)
+int runAutopilot(const char *savedGameToLoad, const char *savedGameToWrite, int ticksToRun, int serial)
 {
 	autopilot = 1;
 	printf("Running autopilot: %s --> %s in %d ticks\n", savedGameToLoad, savedGameToWrite, ticksToRun);
@@ -188,6 +206,11 @@ int runAutopilot(const char *savedGameToLoad, const char *savedGameToWrite, int
 	if (!Game_init()) {
 		return 2;
 	}
+	if (serial) {
+		// the parallel city updates run on this thread, for comparing saves
+		jobs_stop();
+	}
+	initDiagnostics();
 	
 	GameFile_loadSavedGame(savedGameToLoad);
 	runTicks(ticksToRun);
@@ -202,6 +225,42 @@ int runAutopilot(const char *savedGameToLoad, const char *savedGameToWrite, int
 
 Uint32 last;
 
+// Longest time a frame waits for the simulation thread before showing the previous frame again
+#define FRAME_WAIT_MILLIS 10
+#define MAX_PENDING_EVENTS 128
+
+static struct {
+	SDL_Event events[MAX_PENDING_EVENTS];
+	int size;
+} pendingInput;
+
+static void handleInputEvent(SDL_Event *event);
+
+static void handlePendingInput()
+{
+	for (int i = 0; i < pendingInput.size; i++) {
+		handleInputEvent(&pendingInput.events[i]);
+	}
+	pendingInput.size = 0;
+}
+
+// Input changes game state, so it is only handled while the simulation thread is idle
+static void queueInputEvent(SDL_Event *event)
+{
+	// only the last position of a mouse move matters, so moves do not fill the queue
+	if (event->type == SDL_MOUSEMOTION && pendingInput.size > 0 &&
+		pendingInput.events[pendingInput.size - 1].type == SDL_MOUSEMOTION) {
+		pendingInput.events[pendingInput.size - 1] = *event;
+		return;
+	}
+	if (pendingInput.size >= MAX_PENDING_EVENTS) {
+		// keys and clicks must not be lost
+		Runner_waitUntilIdle(-1);
+		handlePendingInput();
+	}
+	pendingInput.events[pendingInput.size++] = *event;
+}
+
 void refresh()
 {
 	static Uint32 lastFpsTime = 0;
@@ -209,14 +268,17 @@ void refresh()
 	static int numFrames = 0;
 	
 	Uint32 now = SDL_GetTicks();
-	time_set_millis(now);
-	Runner_run();
-	
-	// debug
-	Uint32 then = SDL_GetTicks();
-	
-	Runner_draw();
-	numFrames++;
+	Uint32 then = now;
+	if (Runner_waitUntilIdle(FRAME_WAIT_MILLIS)) {
+		// debug
+		then = SDL_GetTicks();
+		handlePendingInput();
+		Runner_draw();
+		numFrames++;
+		// ticks for the next frame run while this one is presented
+		time_set_millis(now);
+		Runner_runAsync();
+	}
 	Uint32 then2 = SDL_GetTicks();
 	if (then2 - lastFpsTime > 1000) {
 		lastFps = numFrames;
@@ -413,6 +475,50 @@ void createSurface(int width, int height, int fullscreen)
 	}
 }
 
+static void handleInputEvent(SDL_Event *event)
+{
+	switch (event->type) {
+		case SDL_KEYDOWN:
+			printf("Key: sym %d\n", event->key.keysym.sym);
+			handleKey(&event->key);
+			break;
+		
+		case SDL_KEYUP:
+			handleKeyUp(&event->key);
+			break;
+		
+		case SDL_TEXTINPUT:
+			handleText(&event->text);
+			break;
+		
+		case SDL_MOUSEMOTION:
+			mouse_set_position(event->motion.x, event->motion.y);
+			break;
+		
+		case SDL_MOUSEBUTTONDOWN:
+			mouse_set_position(event->motion.x, event->motion.y);
+			if (event->button.button == SDL_BUTTON_LEFT) {
+				mouse_set_left_down(1);
+			} else if (event->button.button == SDL_BUTTON_RIGHT) {
+				mouse_set_right_down(1);
+			}
+			break;
+		
+		case SDL_MOUSEBUTTONUP:
+			mouse_set_position(event->button.x, event->button.y);
+			if (event->button.button == SDL_BUTTON_LEFT) {
+				mouse_set_left_down(0);
+			} else if (event->button.button == SDL_BUTTON_RIGHT) {
+				mouse_set_right_down(0);
+			}
+			break;
+		
+		case SDL_MOUSEWHEEL:
+			mouse_set_scroll(event->wheel.y > 0 ? SCROLL_UP : event->wheel.y < 0 ? SCROLL_DOWN : SCROLL_NONE);
+			break;
+	}
+}
+
 void mainLoop()
 {
 	SDL_Event event;
@@ -440,6 +546,7 @@ void mainLoop()
 						case SDL_WINDOWEVENT_SIZE_CHANGED:
 						//case SDL_WINDOWEVENT_RESIZED:
 							printf("System resize to %d x %d\n", event.window.data1, event.window.data2);
+							Runner_waitUntilIdle(-1);
 							createSurface(event.window.data1, event.window.data2, setting_fullscreen());
 							UI_Window_requestRefresh();
 							break;
@@ -447,42 +554,13 @@ void mainLoop()
 					break;
 				
 				case SDL_KEYDOWN:
-					printf("Key: sym %d\n", event.key.keysym.sym);
-					handleKey(&event.key);
-					break;
-				
 				case SDL_KEYUP:
-					handleKeyUp(&event.key);
-					break;
-				
 				case SDL_TEXTINPUT:
-					handleText(&event.text);
-					break;
-				
 				case SDL_MOUSEMOTION:
-					mouse_set_position(event.motion.x, event.motion.y);
-					break;
-				
 				case SDL_MOUSEBUTTONDOWN:
-					mouse_set_position(event.motion.x, event.motion.y);
-					if (event.button.button == SDL_BUTTON_LEFT) {
-						mouse_set_left_down(1);
-					} else if (event.button.button == SDL_BUTTON_RIGHT) {
-						mouse_set_right_down(1);
-					}
-					break;
-				
 				case SDL_MOUSEBUTTONUP:
-					mouse_set_position(event.button.x, event.button.y);
-					if (event.button.button == SDL_BUTTON_LEFT) {
-						mouse_set_left_down(0);
-					} else if (event.button.button == SDL_BUTTON_RIGHT) {
-						mouse_set_right_down(0);
-					}
-					break;
-				
 				case SDL_MOUSEWHEEL:
-					mouse_set_scroll(event.wheel.y > 0 ? SCROLL_UP : event.wheel.y < 0 ? SCROLL_DOWN : SCROLL_NONE);
+					queueInputEvent(&event);
 					break;
 
 				case SDL_QUIT:
@@ -573,6 +651,7 @@ int runPerformance(const char *savedGameToLoad, int ticksToRun)
     if (!Game_init()) {
         return 2;
     }
+    initDiagnostics();
 
     GameFile_loadSavedGame(savedGameToLoad);
     
@@ -602,8 +681,8 @@ int runPerformance(const char *savedGameToLoad, int ticksToRun)
 
 int main(int argc, char **argv)
 {
-	if (argc == 4) {
-		return runAutopilot(argv[1], argv[2], atoi(argv[3]));
+	if (argc == 4 || (argc == 5 && strcmp(argv[4], "serial") == 0)) {
+		return runAutopilot(argv[1], argv[2], atoi(argv[3]), argc == 5);
 	} else if (argc == 3) {
         return runPerformance(argv[1], atoi(argv[2]));
     }
@@ -637,8 +716,11 @@ int main(int argc, char **argv)
 	if (!Game_init()) {
 		return 2;
 	}
+	initDiagnostics();
 
+	Runner_startThread();
 	mainLoop();
+	Runner_stopThread();
 	
 	printf("Quiting SDL.\n");
 	
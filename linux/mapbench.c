@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/Building.h"
+#include "../src/Desirability.h"
+#include "../src/Grid.h"
+#include "../src/Routing.h"
+#include "../src/Terrain.h"
+#include "../src/System.h"
+#include "../src/Data/Building.h"
+#include "../src/Data/Grid.h"
+#include "../src/Data/Settings.h"
+
+#include "building/model.h"
+#include "building/type.h"
+
+// Map-sized work on a synthetic city: routing grid rebuilds, distance and
+// route queries, and full desirability updates. Build with -DGRID_SIZE=...
+// to compare grid sizes.
+
+#define BLOCK_SIZE 4
+
+// System callbacks: nothing to do without a window
+
+void System_resize(int width, int height)
+{
+}
+
+void System_toggleFullscreen()
+{
+}
+
+void System_initCursors()
+{
+}
+
+void System_setCursor(int cursorId)
+{
+}
+
+void System_exit()
+{
+}
+
+static unsigned int randomState = 1;
+
+static int nextRandom(int max)
+{
+	randomState = randomState * 1103515245 + 12345;
+	return (randomState >> 16) % max;
+}
+
+static double nowMillis()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int addHouse(int x, int y)
+{
+	int buildingId = Building_create(BUILDING_HOUSE_SMALL_TENT, x, y);
+	if (!buildingId) {
+		return 0;
+	}
+	Data_Buildings[buildingId].state = BuildingState_InUse;
+	Building_updateIndex(buildingId);
+	Terrain_addBuildingToGrids(buildingId, x, y, 1, 0, Terrain_Building);
+	if (buildingId > Data_Buildings_Extra.highestBuildingIdInUse) {
+		Data_Buildings_Extra.highestBuildingIdInUse = buildingId;
+	}
+	return 1;
+}
+
+// Road grid with one house per block, scattered rubble and a river across the middle
+static int createCity(int size)
+{
+	Data_Settings_Map.width = size;
+	Data_Settings_Map.height = size;
+	Data_Settings_Map.gridStartOffset = GRID_SIZE * ((GRID_SIZE - size) / 2) + (GRID_SIZE - size) / 2;
+	Data_Settings_Map.gridBorderSize = GRID_SIZE - size;
+
+	Grid_clearShortGrid(Data_Grid_graphicIds);
+	Grid_clearShortGrid(Data_Grid_buildingIds);
+	Grid_clearShortGrid(Data_Grid_figureIds);
+	Grid_clearShortGrid(Data_Grid_terrain);
+	Grid_clearUByteGrid(Data_Grid_bitfields);
+	Grid_clearUByteGrid(Data_Grid_edge);
+	Grid_clearByteGrid(Data_Grid_desirability);
+	Building_clearList();
+	Data_Buildings_Extra.highestBuildingIdInUse = 0;
+
+	int numHouses = 0;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			int gridOffset = GridOffset(x, y);
+			int isRoad = x % BLOCK_SIZE == 0 || y % BLOCK_SIZE == 0;
+			if (y >= size / 2 - 2 && y <= size / 2 + 1) {
+				Data_Grid_terrain[gridOffset] = x % (4 * BLOCK_SIZE) ? Terrain_Water : Terrain_Water | Terrain_Road;
+			} else if (isRoad) {
+				Data_Grid_terrain[gridOffset] = Terrain_Road;
+			} else if (x % BLOCK_SIZE == 1 && y % BLOCK_SIZE == 1) {
+				numHouses += addHouse(x, y);
+			} else if (nextRandom(8) == 0) {
+				Data_Grid_terrain[gridOffset] = Terrain_Rubble;
+			}
+		}
+	}
+	return numHouses;
+}
+
+static void rebuildRouting(int size)
+{
+	Routing_determineLandCitizen();
+	Routing_determineLandNonCitizen();
+	Routing_determineWater();
+	Routing_determineWalls();
+}
+
+static void queryDistance(int size)
+{
+	Routing_getDistance(size / 2, size / 4);
+}
+
+static void queryRoute(int size)
+{
+	int blocks = (size - 1) / BLOCK_SIZE;
+	int xSrc = BLOCK_SIZE * nextRandom(blocks);
+	int ySrc = BLOCK_SIZE * nextRandom(blocks);
+	int xDst = BLOCK_SIZE * nextRandom(blocks);
+	int yDst = BLOCK_SIZE * nextRandom(blocks);
+	Routing_findRouteOverLandCitizen(xSrc, ySrc, xDst, yDst);
+}
+
+static void updateDesirability(int size)
+{
+	Desirability_invalidate();
+	Desirability_update();
+}
+
+static void measure(const char *name, int size, int repeats, void (*work)(int))
+{
+	double start = nowMillis();
+	for (int i = 0; i < repeats; i++) {
+		work(size);
+	}
+	double total = nowMillis() - start;
+	printf("%d,%d,%s,%d,%.1f,%.3f\n", GRID_SIZE, size, name, repeats, total, total / repeats);
+}
+
+static void usage(const char *program)
+{
+	fprintf(stderr, "Usage: %s [-s size] [-n repeats] [-d datadir]\n", program);
+	fprintf(stderr, "  -s size     map width and height in tiles (default %d)\n", GRID_SIZE - 2);
+	fprintf(stderr, "  -n repeats  number of times each measurement is repeated (default 100)\n");
+	fprintf(stderr, "  -d datadir  game data directory with c3_model.txt; without it\n");
+	fprintf(stderr, "              buildings do not influence desirability\n");
+}
+
+int main(int argc, char **argv)
+{
+	int size = GRID_SIZE - 2;
+	int repeats = 100;
+	const char *dataDir = 0;
+	int opt;
+	while ((opt = getopt(argc, argv, "s:n:d:")) != -1) {
+		switch (opt) {
+			case 's': size = atoi(optarg); break;
+			case 'n': repeats = atoi(optarg); break;
+			case 'd': dataDir = optarg; break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+	if (size < 2 * BLOCK_SIZE || size > GRID_SIZE - 2 || repeats < 1) {
+		usage(argv[0]);
+		return 1;
+	}
+	if (dataDir && (chdir(dataDir) != 0 || !model_load())) {
+		fprintf(stderr, "Unable to load the building models from %s\n", dataDir);
+		return 1;
+	}
+
+	int numHouses = createCity(size);
+	rebuildRouting(size);
+	fprintf(stderr, "Grid %d, map %dx%d, %d houses\n", GRID_SIZE, size, size, numHouses);
+
+	printf("grid_size,map_size,operation,repeats,total_ms,avg_ms\n");
+	measure("routing_rebuild", size, repeats, rebuildRouting);
+	measure("routing_distance", size, repeats, queryDistance);
+	measure("routing_route", size, repeats, queryRoute);
+	measure("desirability_full", size, repeats, updateDesirability);
+	return 0;
+}
@@ -0,0 +1,31 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/trace.h"
+
+// Prints a binary trace file written by the game as text
+
+static trace_event events[TRACE_BUFFER_SIZE];
+
+int main(int argc, char **argv)
+{
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s <trace file> [event name filter]\n", argv[0]);
+		return 1;
+	}
+	const char *filter = argc > 2 ? argv[2] : 0;
+	int numEvents = trace_read_file(argv[1], events, TRACE_BUFFER_SIZE);
+	if (numEvents < 0) {
+		fprintf(stderr, "%s is not a valid trace file\n", argv[1]);
+		return 1;
+	}
+	char line[200];
+	for (int i = 0; i < numEvents; i++) {
+		trace_format_event(&events[i], line, sizeof(line));
+		if (!filter || strstr(line, filter)) {
+			printf("%s\n", line);
+		}
+	}
+	return 0;
+}
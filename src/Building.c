@@ -10,6 +10,7 @@
 #include "PlayerMessage.h"
 #include "Resource.h"
 #include "Routing.h"
+#include "Runner.h"
 #include "Sound.h"
 #include "Terrain.h"
 #include "TerrainGraphics.h"
@@ -20,20 +21,26 @@
 #include "Data/CityInfo.h"
 #include "Data/Constants.h"
 #include "Data/Grid.h"
+#include "Data/Routes.h"
 #include "Data/Scenario.h"
 #include "Data/Settings.h"
 #include "Data/State.h"
 #include "Data/Figure.h"
 
+#include "building/index.h"
 #include "building/properties.h"
+#include "building/spatial.h"
+#include "core/id_pool.h"
 #include "graphics/image.h"
 
 #include <string.h>
 
+static id_pool buildingIds;
+
 void Building_updateHighestIds()
 {
 	Data_Buildings_Extra.highestBuildingIdInUse = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (Data_Buildings[i].state != BuildingState_Unused) {
 			Data_Buildings_Extra.highestBuildingIdInUse = i;
 		}
@@ -48,19 +55,51 @@ void Building_clearList()
 	memset(Data_Buildings, 0, MAX_BUILDINGS * sizeof(struct Data_Building));
 	Data_Buildings_Extra.highestBuildingIdEver = 0;
 	Data_Buildings_Extra.createdSequence = 0;
+	building_index_clear();
+	building_spatial_clear();
+	Data_Buildings_Extra.capacity = MAX_BUILDINGS_LEGACY;
+	id_pool_init(&buildingIds, Data_Buildings_Extra.capacity);
+}
+
+void Building_updateIndex(int buildingId)
+{
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (b->state == BuildingState_Unused) {
+		building_index_remove(buildingId);
+		building_spatial_remove(buildingId);
+		id_pool_set_free(&buildingIds, buildingId);
+	} else {
+		building_index_add(buildingId, b->type);
+		building_spatial_update(buildingId, b->type, b->x, b->y);
+		id_pool_set_used(&buildingIds, buildingId);
+	}
+}
+
+void Building_rebuildIndex()
+{
+	building_index_clear();
+	building_spatial_clear();
+	id_pool_init(&buildingIds, Data_Buildings_Extra.capacity);
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
+		Building_updateIndex(i);
+	}
 }
 
 int Building_create(int type, int x, int y)
 {
-	int buildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (Data_Buildings[i].state == BuildingState_Unused && !Undo_isBuildingInList(i)) {
-			buildingId = i;
-			break;
-		}
+	// buildings on the undo list cannot be reused yet, there are at most a few of them
+	int buildingId = id_pool_first_free(&buildingIds);
+	while (buildingId && Undo_isBuildingInList(buildingId)) {
+		buildingId = id_pool_next_free(&buildingIds, buildingId);
+	}
+	if (!buildingId && Data_Buildings_Extra.capacity < MAX_BUILDINGS) {
+		// list is full: grow it, new IDs come after the existing ones
+		buildingId = Data_Buildings_Extra.capacity;
+		Data_Buildings_Extra.capacity += MAX_BUILDINGS_LEGACY;
+		id_pool_resize(&buildingIds, Data_Buildings_Extra.capacity);
 	}
 	if (!buildingId) {
-		UI_Warning_show(Warning_DataLimitReached);
+		Runner_callUi(UI_Warning_show, Warning_DataLimitReached, 0);
 		return 0;
 	}
 	
@@ -163,6 +202,7 @@ int Building_create(int type, int x, int y)
 	b->figureRoamDirection = b->houseGenerationDelay & 6;
 	b->fireProof = props->fire_proof;
 	b->isAdjacentToWater = Terrain_isAdjacentToWater(x, y, b->size);
+	Building_updateIndex(buildingId);
 
 	return buildingId;
 }
@@ -171,6 +211,9 @@ void Building_delete(int buildingId)
 {
 	Building_deleteData(buildingId);
 	memset(&Data_Buildings[buildingId], 0, sizeof(struct Data_Building));
+	building_index_remove(buildingId);
+	building_spatial_remove(buildingId);
+	id_pool_set_free(&buildingIds, buildingId);
 }
 
 void Building_deleteData(int buildingId)
@@ -212,7 +255,7 @@ void Building_GameTick_updateState()
 {
 	int landRecalc = 0;
 	int wallRecalc = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (b->state == BuildingState_Created) {
 			b->state = BuildingState_InUse;
@@ -239,8 +282,7 @@ void Building_GameTick_updateState()
 		TerrainGraphics_updateAllWalls();
 	}
 	if (landRecalc) {
-		Routing_determineLandCitizen();
-		Routing_determineLandNonCitizen();
+		Routing_updateLand();
 	}
 }
 
@@ -287,6 +329,7 @@ void Building_collapseOnFire(int buildingId, int hasPlague)
 		b->state = BuildingState_DeletedByGame;
 	} else {
 		b->type = BUILDING_BURNING_RUIN;
+		Building_updateIndex(buildingId);
 		b->figureId4 = 0;
 		b->taxIncomeOrStorage = 0;
 		b->fireDuration = (b->houseGenerationDelay & 7) + 1;
@@ -369,7 +412,7 @@ void Building_collapseLastPlaced()
 {
 	int highestSequence = 0;
 	int buildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (Data_Buildings[i].state == BuildingState_Created || Data_Buildings[i].state == BuildingState_InUse) {
 			if (Data_Buildings[i].createdSequence > highestSequence) {
 				highestSequence = Data_Buildings[i].createdSequence;
@@ -394,7 +437,7 @@ void Building_collapseLastPlaced()
 
 int Building_collapseFirstOfType(int buildingType)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].type == buildingType) {
 			int gridOffset = Data_Buildings[i].gridOffset;
 			Data_State.undoAvailable = 0;
@@ -465,7 +508,7 @@ void Building_destroyByEnemy(int x, int y, int gridOffset)
 
 void Building_setDesirability()
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -500,7 +543,7 @@ void Building_setDesirability()
 
 void Building_decayHousesCovered()
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (Data_Buildings[i].state != BuildingState_Unused &&
 			Data_Buildings[i].type != BUILDING_TOWER) {
 			if (Data_Buildings[i].housesCovered <= 1) {
@@ -517,7 +560,7 @@ void Building_determineGraphicIdsForOrientedBuildings()
 	int mapOrientation = Data_Settings_Map.orientation;
 	int mapOrientationIsTopOrBottom = mapOrientation == Dir_0_Top || mapOrientation == Dir_4_Bottom;
 	int graphicOffset;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (b->state == BuildingState_Unused) {
 			continue;
@@ -640,7 +683,7 @@ void BuildingStorage_resetBuildingIds()
 		Data_Building_Storages[i].buildingId = 0;
 	}
 	
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (Data_Buildings[i].state == BuildingState_Unused) {
 			continue;
 		}
@@ -658,11 +701,19 @@ void BuildingStorage_resetBuildingIds()
 	}
 }
 
+static void showCityBoxedIn(int gridOffset)
+{
+	UI_Warning_show(Warning_CityBoxedIn);
+	UI_Warning_show(Warning_CityBoxedInPeopleWillPerish);
+	CityView_goToGridOffset(gridOffset);
+}
+
 void Building_GameTick_checkAccessToRome()
 {
-	Routing_getDistance(Data_CityInfo.entryPointX, Data_CityInfo.entryPointY);
+	// the entry distances are repaired when the routing grid changes, no flood fill needed
+	++Data_Routes.totalRoutesCalculated;
 	int problemGridOffset = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	FOR_EACH_INDEXED_BUILDING(i) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -681,12 +732,12 @@ void Building_GameTick_checkAccessToRome()
 					}
 					b->state = BuildingState_Undo;
 				}
-			} else if (Data_Grid_routingDistance[GridOffset(xRoad, yRoad)]) {
+			} else if (Routing_getEntryDistance(GridOffset(xRoad, yRoad))) {
 				// reachable from rome
-				b->distanceFromEntry = Data_Grid_routingDistance[GridOffset(xRoad, yRoad)];
+				b->distanceFromEntry = Routing_getEntryDistance(GridOffset(xRoad, yRoad));
 				b->houseUnreachableTicks = 0;
 			} else if (Terrain_getClosestReachableRoadWithinRadius(b->x, b->y, b->size, 2, &xRoad, &yRoad)) {
-				b->distanceFromEntry = Data_Grid_routingDistance[GridOffset(xRoad, yRoad)];
+				b->distanceFromEntry = Routing_getEntryDistance(GridOffset(xRoad, yRoad));
 				b->houseUnreachableTicks = 0;
 			} else {
 				// no reachable road in radius
@@ -708,7 +759,7 @@ void Building_GameTick_checkAccessToRome()
 			int roadGridOffset = Terrain_getRoadToLargestRoadNetwork(b->x, b->y, 3, &xRoad, &yRoad);
 			if (roadGridOffset >= 0) {
 				b->roadNetworkId = Data_Grid_roadNetworks[roadGridOffset];
-				b->distanceFromEntry = Data_Grid_routingDistance[roadGridOffset];
+				b->distanceFromEntry = Routing_getEntryDistance(roadGridOffset);
 				b->roadAccessX = xRoad;
 				b->roadAccessY = yRoad;
 			}
@@ -724,7 +775,7 @@ void Building_GameTick_checkAccessToRome()
 			int roadGridOffset = Terrain_getRoadToLargestRoadNetworkHippodrome(b->x, b->y, 5, &xRoad, &yRoad);
 			if (roadGridOffset >= 0) {
 				b->roadNetworkId = Data_Grid_roadNetworks[roadGridOffset];
-				b->distanceFromEntry = Data_Grid_routingDistance[roadGridOffset];
+				b->distanceFromEntry = Routing_getEntryDistance(roadGridOffset);
 				b->roadAccessX = xRoad;
 				b->roadAccessY = yRoad;
 			}
@@ -733,13 +784,13 @@ void Building_GameTick_checkAccessToRome()
 			int roadGridOffset = Terrain_getRoadToLargestRoadNetwork(b->x, b->y, b->size, &xRoad, &yRoad);
 			if (roadGridOffset >= 0) {
 				b->roadNetworkId = Data_Grid_roadNetworks[roadGridOffset];
-				b->distanceFromEntry = Data_Grid_routingDistance[roadGridOffset];
+				b->distanceFromEntry = Routing_getEntryDistance(roadGridOffset);
 				b->roadAccessX = xRoad;
 				b->roadAccessY = yRoad;
 			}
 		}
 	}
-	if (!Data_Grid_routingDistance[Data_CityInfo.exitPointGridOffset]) {
+	if (!Routing_getEntryDistance(Data_CityInfo.exitPointGridOffset)) {
 		// no route through city
 		if (Data_CityInfo.population <= 0) {
 			return;
@@ -763,7 +814,7 @@ void Building_GameTick_checkAccessToRome()
 			Routing_determineLandNonCitizen();
 			Routing_determineWalls();
 			
-			if (Data_Grid_routingDistance[Data_CityInfo.exitPointGridOffset]) {
+			if (Routing_getCalculatedDistance(Data_CityInfo.exitPointGridOffset)) {
 				PlayerMessage_post(1, Message_116_RoadToRomeObstructed, 0, 0);
 				Data_State.undoAvailable = 0;
 				return;
@@ -772,49 +823,45 @@ void Building_GameTick_checkAccessToRome()
 		Building_collapseLastPlaced();
 	} else if (problemGridOffset) {
 		// parts of city disconnected
-		UI_Warning_show(Warning_CityBoxedIn);
-		UI_Warning_show(Warning_CityBoxedInPeopleWillPerish);
-		CityView_goToGridOffset(problemGridOffset);
+		Runner_callUi(showCityBoxedIn, problemGridOffset, 0);
 	}
 }
 
-void Building_Industry_updateProduction()
+void Building_Industry_updateProduction(int buildingId)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || !b->outputResourceId) {
-			continue;
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (!BuildingIsInUse(buildingId) || !b->outputResourceId) {
+		return;
+	}
+	b->data.industry.hasFullResource = 0;
+	if (b->housesCovered <= 0 || b->numWorkers <= 0) {
+		return;
+	}
+	if (b->subtype.workshopResource && !b->loadsStored) {
+		return;
+	}
+	if (b->data.industry.curseDaysLeft) {
+		b->data.industry.curseDaysLeft--;
+	} else {
+		if (b->data.industry.blessingDaysLeft) {
+			b->data.industry.blessingDaysLeft--;
 		}
-		b->data.industry.hasFullResource = 0;
-		if (b->housesCovered <= 0 || b->numWorkers <= 0) {
-			continue;
+		if (b->type == BUILDING_MARBLE_QUARRY) {
+			b->data.industry.progress += b->numWorkers / 2;
+		} else {
+			b->data.industry.progress += b->numWorkers;
 		}
-		if (b->subtype.workshopResource && !b->loadsStored) {
-			continue;
+		if (b->data.industry.blessingDaysLeft && BuildingIsFarm(b->type)) {
+			b->data.industry.progress += b->numWorkers;
 		}
-		if (b->data.industry.curseDaysLeft) {
-			b->data.industry.curseDaysLeft--;
-		} else {
-			if (b->data.industry.blessingDaysLeft) {
-				b->data.industry.blessingDaysLeft--;
-			}
-			if (b->type == BUILDING_MARBLE_QUARRY) {
-				b->data.industry.progress += b->numWorkers / 2;
-			} else {
-				b->data.industry.progress += b->numWorkers;
-			}
-			if (b->data.industry.blessingDaysLeft && BuildingIsFarm(b->type)) {
-				b->data.industry.progress += b->numWorkers;
-			}
-			int maxProgress = b->subtype.workshopResource ? 400 : 200;
-			if (b->data.industry.progress > maxProgress) {
-				b->data.industry.progress = maxProgress;
-			}
-			if (BuildingIsFarm(b->type)) {
-				TerrainGraphics_setBuildingFarm(i, b->x, b->y,
-					image_group(ID_Graphic_FarmCrops) + 5 * (b->outputResourceId - 1),
-					b->data.industry.progress);
-			}
+		int maxProgress = b->subtype.workshopResource ? 400 : 200;
+		if (b->data.industry.progress > maxProgress) {
+			b->data.industry.progress = maxProgress;
+		}
+		if (BuildingIsFarm(b->type)) {
+			TerrainGraphics_setBuildingFarm(buildingId, b->x, b->y,
+				image_group(ID_Graphic_FarmCrops) + 5 * (b->outputResourceId - 1),
+				b->data.industry.progress);
 		}
 	}
 }
@@ -824,7 +871,7 @@ void Building_Industry_updateDoubleWheatProduction()
 	if (Data_Scenario.climate == Climate_Northern) {
 		return;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || !b->outputResourceId) {
 			continue;
@@ -849,7 +896,7 @@ void Building_Industry_updateDoubleWheatProduction()
 
 void Building_Industry_witherFarmCropsFromCeres(int bigCurse)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->outputResourceId && BuildingIsFarm(b->type)) {
 			b->data.industry.progress = 0;
@@ -864,7 +911,7 @@ void Building_Industry_witherFarmCropsFromCeres(int bigCurse)
 
 void Building_Industry_blessFarmsFromCeres()
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->outputResourceId && BuildingIsFarm(b->type)) {
 			b->data.industry.progress = 200;
@@ -915,87 +962,89 @@ int BUILDING_MARKET_getDestinationGranaryWarehouse(int marketId)
 		resources[i].distance = 40;
 	}
 	struct Data_Building *market = &Data_Buildings[marketId];
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (!BuildingIsInUse(i)) {
-			continue;
-		}
-		struct Data_Building *b = &Data_Buildings[i];
-		if (b->type != BUILDING_GRANARY && b->type != BUILDING_WAREHOUSE) {
-			continue;
-		}
-		if (!b->hasRoadAccess || b->distanceFromEntry <= 0 ||
-			b->roadNetworkId != market->roadNetworkId) {
-			continue;
-		}
-		int distance = calc_maximum_distance(market->x, market->y, b->x, b->y);
-		if (distance >= 40) {
-			continue;
-		}
-		if (b->type == BUILDING_GRANARY) {
-			if (Data_Scenario.romeSuppliesWheat) {
+	// granaries only store food and warehouses only goods: visiting the types one after
+	// the other finds the same closest buildings as a single scan in ID order
+	const building_type storageTypes[] = {BUILDING_GRANARY, BUILDING_WAREHOUSE};
+	for (int t = 0; t < 2; t++) {
+		FOR_EACH_BUILDING_OF_TYPE(i, storageTypes[t]) {
+			if (!BuildingIsInUse(i)) {
 				continue;
 			}
-			// foods
-			if (b->data.storage.resourceStored[Resource_Wheat]) {
-				resources[Inventory_Wheat].numBuildings++;
-				if (distance < resources[Inventory_Wheat].distance) {
-					resources[Inventory_Wheat].distance = distance;
-					resources[Inventory_Wheat].buildingId = i;
-				}
+			struct Data_Building *b = &Data_Buildings[i];
+			if (!b->hasRoadAccess || b->distanceFromEntry <= 0 ||
+				b->roadNetworkId != market->roadNetworkId) {
+				continue;
 			}
-			if (b->data.storage.resourceStored[Resource_Vegetables]) {
-				resources[Inventory_Vegetables].numBuildings++;
-				if (distance < resources[Inventory_Vegetables].distance) {
-					resources[Inventory_Vegetables].distance = distance;
-					resources[Inventory_Vegetables].buildingId = i;
-				}
+			int distance = calc_maximum_distance(market->x, market->y, b->x, b->y);
+			if (distance >= 40) {
+				continue;
 			}
-			if (b->data.storage.resourceStored[Resource_Fruit]) {
-				resources[Inventory_Fruit].numBuildings++;
-				if (distance < resources[Inventory_Fruit].distance) {
-					resources[Inventory_Fruit].distance = distance;
-					resources[Inventory_Fruit].buildingId = i;
+			if (b->type == BUILDING_GRANARY) {
+				if (Data_Scenario.romeSuppliesWheat) {
+					continue;
 				}
-			}
-			if (b->data.storage.resourceStored[Resource_Meat]) {
-				resources[Inventory_Meat].numBuildings++;
-				if (distance < resources[Inventory_Meat].distance) {
-					resources[Inventory_Meat].distance = distance;
-					resources[Inventory_Meat].buildingId = i;
+				// foods
+				if (b->data.storage.resourceStored[Resource_Wheat]) {
+					resources[Inventory_Wheat].numBuildings++;
+					if (distance < resources[Inventory_Wheat].distance) {
+						resources[Inventory_Wheat].distance = distance;
+						resources[Inventory_Wheat].buildingId = i;
+					}
 				}
-			}
-		} else if (b->type == BUILDING_WAREHOUSE) {
-			// goods
-			if (!Data_CityInfo.resourceStockpiled[Resource_Wine] &&
-				Resource_getAmountStoredInWarehouse(i, Resource_Wine) > 0) {
-				resources[Inventory_Wine].numBuildings++;
-				if (distance < resources[Inventory_Wine].distance) {
-					resources[Inventory_Wine].distance = distance;
-					resources[Inventory_Wine].buildingId = i;
+				if (b->data.storage.resourceStored[Resource_Vegetables]) {
+					resources[Inventory_Vegetables].numBuildings++;
+					if (distance < resources[Inventory_Vegetables].distance) {
+						resources[Inventory_Vegetables].distance = distance;
+						resources[Inventory_Vegetables].buildingId = i;
+					}
 				}
-			}
-			if (!Data_CityInfo.resourceStockpiled[Resource_Oil] &&
-				Resource_getAmountStoredInWarehouse(i, Resource_Oil) > 0) {
-				resources[Inventory_Oil].numBuildings++;
-				if (distance < resources[Inventory_Oil].distance) {
-					resources[Inventory_Oil].distance = distance;
-					resources[Inventory_Oil].buildingId = i;
+				if (b->data.storage.resourceStored[Resource_Fruit]) {
+					resources[Inventory_Fruit].numBuildings++;
+					if (distance < resources[Inventory_Fruit].distance) {
+						resources[Inventory_Fruit].distance = distance;
+						resources[Inventory_Fruit].buildingId = i;
+					}
 				}
-			}
-			if (!Data_CityInfo.resourceStockpiled[Resource_Pottery] &&
-				Resource_getAmountStoredInWarehouse(i, Resource_Pottery) > 0) {
-				resources[Inventory_Pottery].numBuildings++;
-				if (distance < resources[Inventory_Pottery].distance) {
-					resources[Inventory_Pottery].distance = distance;
-					resources[Inventory_Pottery].buildingId = i;
+				if (b->data.storage.resourceStored[Resource_Meat]) {
+					resources[Inventory_Meat].numBuildings++;
+					if (distance < resources[Inventory_Meat].distance) {
+						resources[Inventory_Meat].distance = distance;
+						resources[Inventory_Meat].buildingId = i;
+					}
 				}
-			}
-			if (!Data_CityInfo.resourceStockpiled[Resource_Furniture] &&
-				Resource_getAmountStoredInWarehouse(i, Resource_Furniture) > 0) {
-				resources[Inventory_Furniture].numBuildings++;
-				if (distance < resources[Inventory_Furniture].distance) {
-					resources[Inventory_Furniture].distance = distance;
-					resources[Inventory_Furniture].buildingId = i;
+			} else if (b->type == BUILDING_WAREHOUSE) {
+				// goods
+				if (!Data_CityInfo.resourceStockpiled[Resource_Wine] &&
+					Resource_getAmountStoredInWarehouse(i, Resource_Wine) > 0) {
+					resources[Inventory_Wine].numBuildings++;
+					if (distance < resources[Inventory_Wine].distance) {
+						resources[Inventory_Wine].distance = distance;
+						resources[Inventory_Wine].buildingId = i;
+					}
+				}
+				if (!Data_CityInfo.resourceStockpiled[Resource_Oil] &&
+					Resource_getAmountStoredInWarehouse(i, Resource_Oil) > 0) {
+					resources[Inventory_Oil].numBuildings++;
+					if (distance < resources[Inventory_Oil].distance) {
+						resources[Inventory_Oil].distance = distance;
+						resources[Inventory_Oil].buildingId = i;
+					}
+				}
+				if (!Data_CityInfo.resourceStockpiled[Resource_Pottery] &&
+					Resource_getAmountStoredInWarehouse(i, Resource_Pottery) > 0) {
+					resources[Inventory_Pottery].numBuildings++;
+					if (distance < resources[Inventory_Pottery].distance) {
+						resources[Inventory_Pottery].distance = distance;
+						resources[Inventory_Pottery].buildingId = i;
+					}
+				}
+				if (!Data_CityInfo.resourceStockpiled[Resource_Furniture] &&
+					Resource_getAmountStoredInWarehouse(i, Resource_Furniture) > 0) {
+					resources[Inventory_Furniture].numBuildings++;
+					if (distance < resources[Inventory_Furniture].distance) {
+						resources[Inventory_Furniture].distance = distance;
+						resources[Inventory_Furniture].buildingId = i;
+					}
 				}
 			}
 		}
@@ -1179,7 +1228,7 @@ void BUILDING_DOCK_updateOpenWaterAccess()
 {
 	Routing_getDistanceWaterBoat(
 		Data_Scenario.riverEntryPoint.x, Data_Scenario.riverEntryPoint.y);
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && !b->houseSize && b->type == BUILDING_DOCK) {
 			if (Terrain_isAdjacentToOpenWater(b->x, b->y, 3)) {
@@ -1206,7 +1255,7 @@ void Building_Mercury_removeResources(int bigCurse)
 {
 	int maxStored = 0;
 	int maxBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i)) {
 			continue;
@@ -1257,7 +1306,7 @@ void Building_Mercury_fillGranary()
 {
 	int minStored = 10000;
 	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY) {
 			continue;
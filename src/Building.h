@@ -4,6 +4,8 @@
 void Building_updateHighestIds();
 
 void Building_clearList();
+void Building_updateIndex(int buildingId);
+void Building_rebuildIndex();
 int Building_create(int type, int x, int y);
 void Building_delete(int buildingId);
 void Building_deleteData(int buildingId);
@@ -30,7 +32,7 @@ void BuildingStorage_resetBuildingIds();
 
 void Building_GameTick_checkAccessToRome();
 
-void Building_Industry_updateProduction();
+void Building_Industry_updateProduction(int buildingId);
 void Building_Industry_updateDoubleWheatProduction();
 void Building_Industry_blessFarmsFromCeres();
 void Building_Industry_witherFarmCropsFromCeres(int bigCurse);
@@ -33,13 +33,13 @@ static void splitSize3(int buildingId);
 
 #define MAX_DIR 4
 
-static const int directionGridOffsets[] = {0, -163, -1, -162};
+static const int directionGridOffsets[] = {0, GridDelta(-1, -1), -1, GridDelta(0, -1)};
 static const int directionOffsetX[] = { 0, -1, -1, 0 };
 static const int directionOffsetY[] = { 0, -1, 0, -1 };
 static const int tileGridOffsets[] = {
-	0, 1, 162, 163, // 2x2
-	2, 164, 326, 325, 324, // 3x3
-	3, 165, 327, 489, 488, 487, 486 // 4x4
+	0, 1, GridDelta(0, 1), GridDelta(1, 1), // 2x2
+	2, GridDelta(2, 1), GridDelta(2, 2), GridDelta(1, 2), GridDelta(0, 2), // 3x3
+	3, GridDelta(3, 1), GridDelta(3, 2), GridDelta(3, 3), GridDelta(2, 3), GridDelta(1, 3), GridDelta(0, 3) // 4x4
 };
 
 static const int houseGraphicGroup[20] = {
@@ -159,6 +159,7 @@ void BuildingHouse_checkForCorruption(int buildingId)
 					b->gridOffset = gridOffset;
 					b->x = GridOffsetToX(gridOffset);
 					b->y = GridOffsetToY(gridOffset);
+					Building_updateIndex(buildingId);
 					return;
 				}
 			}
@@ -260,6 +261,7 @@ void BuildingHouse_expandToLargeInsula(int buildingId)
 	b->x = mergeData.x;
 	b->y = mergeData.y;
 	b->gridOffset = GridOffset(b->x, b->y);
+	Building_updateIndex(buildingId);
 	Terrain_addBuildingToGrids(buildingId, b->x, b->y, b->size, graphicId, Terrain_Building);
 }
 
@@ -281,6 +283,7 @@ void BuildingHouse_expandToLargeVilla(int buildingId)
 	b->x = mergeData.x;
 	b->y = mergeData.y;
 	b->gridOffset = GridOffset(b->x, b->y);
+	Building_updateIndex(buildingId);
 	Terrain_addBuildingToGrids(buildingId, b->x, b->y, b->size, graphicId, Terrain_Building);
 }
 
@@ -302,6 +305,7 @@ void BuildingHouse_expandToLargePalace(int buildingId)
 	b->x = mergeData.x;
 	b->y = mergeData.y;
 	b->gridOffset = GridOffset(b->x, b->y);
+	Building_updateIndex(buildingId);
 	Terrain_addBuildingToGrids(buildingId, b->x, b->y, b->size, graphicId, Terrain_Building);
 }
 
@@ -324,6 +328,7 @@ static void merge(int buildingId)
 	b->x = mergeData.x;
 	b->y = mergeData.y;
 	b->gridOffset = GridOffset(b->x, b->y);
+	Building_updateIndex(buildingId);
 	b->houseIsMerged = 1;
 	Terrain_addBuildingToGrids(buildingId, b->x, b->y, 2, graphicId, Terrain_Building);
 }
@@ -377,6 +382,7 @@ static void splitSize2(int buildingId)
 
 	// main tile
 	b->type = BUILDING_HOUSE_MEDIUM_INSULA;
+	Building_updateIndex(buildingId);
 	b->subtype.houseLevel = b->type - 10;
 	b->size = b->houseSize = 1;
 	b->houseIsMerged = 0;
@@ -412,6 +418,7 @@ static void splitSize3(int buildingId)
 
 	// main tile
 	b->type = BUILDING_HOUSE_MEDIUM_INSULA;
+	Building_updateIndex(buildingId);
 	b->subtype.houseLevel = b->type - 10;
 	b->size = b->houseSize = 1;
 	b->houseIsMerged = 0;
@@ -455,6 +462,7 @@ void BuildingHouse_devolveFromLargeVilla(int buildingId)
 
 	// main tile
 	b->type = BUILDING_HOUSE_MEDIUM_VILLA;
+	Building_updateIndex(buildingId);
 	b->subtype.houseLevel = b->type - 10;
 	b->size = b->houseSize = 2;
 	b->houseIsMerged = 0;
@@ -493,6 +501,7 @@ void BuildingHouse_devolveFromLargePalace(int buildingId)
 
 	// main tile
 	b->type = BUILDING_HOUSE_MEDIUM_PALACE;
+	Building_updateIndex(buildingId);
 	b->subtype.houseLevel = b->type - 10;
 	b->size = b->houseSize = 3;
 	b->houseIsMerged = 0;
@@ -520,6 +529,7 @@ void BuildingHouse_changeTo(int buildingId, int buildingType)
 {
 	struct Data_Building *b = &Data_Buildings[buildingId];
 	b->type = buildingType;
+	Building_updateIndex(buildingId);
 	b->subtype.houseLevel = b->type - 10;
 	int graphicId = image_group(houseGraphicGroup[b->subtype.houseLevel]);
 	if (b->houseIsMerged) {
@@ -538,6 +548,7 @@ void BuildingHouse_changeToVacantLot(int buildingId)
 {
 	struct Data_Building *b = &Data_Buildings[buildingId];
 	b->type = BUILDING_HOUSE_VACANT_LOT;
+	Building_updateIndex(buildingId);
 	b->subtype.houseLevel = b->type - 10;
 	int graphicId = image_group(ID_Graphic_HouseVacantLot);
 	if (b->houseIsMerged) {
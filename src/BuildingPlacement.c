@@ -540,8 +540,9 @@ static void addToTerrain(int type, int buildingId, int x, int y, int size,
 			}
 			break;
 	}
-	Routing_determineLandCitizen();
-	Routing_determineLandNonCitizen();
+	// footprint and border: gatehouses and towers also change the tiles around them
+	Routing_markLandDirty(x - 1, y - 1, size + 2);
+	Routing_updateLand();
 	Routing_determineWalls();
 }
 
@@ -727,8 +728,7 @@ static void placeHouses(int measureOnly, int xStart, int yStart, int xEnd, int y
 		if (needsRoadWarning) {
 			UI_Warning_show(Warning_HouseTooFarFromRoad);
 		}
-		Routing_determineLandCitizen();
-		Routing_determineLandNonCitizen();
+		Routing_updateLand();
 		UI_Window_requestRefresh();
 	}
 }
@@ -805,14 +805,14 @@ static void clearRegionConfirmed(int measureOnly, int xStart, int yStart, int xE
 				Data_Grid_terrain[gridOffset] &= Terrain_2e80;
 				Data_Grid_aqueducts[gridOffset] = 0;
 				itemsPlaced++;
-				if (Data_Grid_aqueducts[gridOffset - 162] == 5) {
-					Data_Grid_aqueducts[gridOffset - 162] = 1;
+				if (Data_Grid_aqueducts[gridOffset - GRID_SIZE] == 5) {
+					Data_Grid_aqueducts[gridOffset - GRID_SIZE] = 1;
 				}
 				if (Data_Grid_aqueducts[gridOffset + 1] == 6) {
 					Data_Grid_aqueducts[gridOffset + 1] = 2;
 				}
-				if (Data_Grid_aqueducts[gridOffset + 162] == 5) {
-					Data_Grid_aqueducts[gridOffset + 162] = 3;
+				if (Data_Grid_aqueducts[gridOffset + GRID_SIZE] == 5) {
+					Data_Grid_aqueducts[gridOffset + GRID_SIZE] = 3;
 				}
 				if (Data_Grid_aqueducts[gridOffset - 1] == 6) {
 					Data_Grid_aqueducts[gridOffset - 1] = 4;
@@ -1019,6 +1019,9 @@ static void placeGarden(int xStart, int yStart, int xEnd, int yEnd)
 			}
 		}
 	}
+	for (int y = yMin; y <= yMax; y++) {
+		Routing_markLandDirty(xMin, y, xMax - xMin + 1);
+	}
 	TerrainGraphics_updateAllGardens();
 }
 
@@ -1302,8 +1305,7 @@ void BuildingPlacement_place(int orientation, int xStart, int yStart, int xEnd,
 	} else if (type == BUILDING_GARDENS) {
 		placeGarden(xStart, yStart, xEnd, yEnd);
 		placementCost *= itemsPlaced;
-		Routing_determineLandCitizen();
-		Routing_determineLandNonCitizen();
+		Routing_updateLand();
 	} else if (type == BUILDING_LOW_BRIDGE) {
 		int length = TerrainBridge_addToSpriteGrid(xEnd, yEnd, 0);
 		if (length <= 1) {
@@ -65,6 +65,9 @@ void CityInfo_Resource_calculateFoodAndSupplyRomeWheat();
 void CityInfo_Resource_calculateFood();
 void CityInfo_Resource_housesConsumeFood();
 
+// Reads: active building counts, population per age
+// Writes: Data_CityInfo_CultureCoverage, cultureCoverageReligion, school and academy age population
+// A few dozen integer operations: too small for the job system, no random numbers are drawn
 void CityInfo_Culture_updateCoveragePercentages();
 void CityInfo_Culture_calculateDemandsForAdvisors();
 void CityInfo_Culture_calculateEntertainment();
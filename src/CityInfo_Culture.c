@@ -181,7 +181,7 @@ void CityInfo_Culture_calculateEntertainment()
 	Data_CityInfo.citywideAverageHealth = 0;
 
 	int numHouses = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->houseSize) {
 			numHouses++;
@@ -197,7 +197,7 @@ void CityInfo_Culture_calculateEntertainment()
 		Data_CityInfo.citywideAverageEducation /= numHouses;
 		Data_CityInfo.citywideAverageHealth /= numHouses;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i)) {
 			continue;
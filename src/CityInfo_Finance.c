@@ -11,7 +11,7 @@
 
 void CityInfo_Finance_decayTaxCollectorAccess()
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].houseTaxCoverage) {
 			Data_Buildings[i].houseTaxCoverage--;
 		}
@@ -32,7 +32,7 @@ static void collectMonthlyTaxes()
 	for (int i = 0; i < MAX_HOUSE_LEVELS; i++) {
 		Data_CityInfo.populationPerLevel[i] = 0;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i) || !Data_Buildings[i].houseSize) {
 			continue;
 		}
@@ -197,7 +197,7 @@ void CityInfo_Finance_handleYearChange()
 	Data_CityInfo.yearlyUncollectedTaxFromPatricians = 0;
 	
 	// reset tax income in building list
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].houseSize) {
 			Data_Buildings[i].taxIncomeOrStorage = 0;
 		}
@@ -283,7 +283,7 @@ void CityInfo_Finance_calculateEstimatedTaxes()
 {
 	Data_CityInfo.monthlyCollectedTaxFromPlebs = 0;
 	Data_CityInfo.monthlyCollectedTaxFromPatricians = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].houseSize && Data_Buildings[i].houseTaxCoverage) {
 			int isPatrician = Data_Buildings[i].subtype.houseLevel >= HOUSE_SMALL_VILLA;
 			int trm = difficulty_adjust_money(
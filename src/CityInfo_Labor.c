@@ -93,7 +93,7 @@ void CityInfo_Labor_calculateWorkersNeededPerCategory()
 		Data_CityInfo.laborCategory[cat].workersAllocated = 0;
 		Data_CityInfo.laborCategory[cat].workersNeeded = 0;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -217,7 +217,7 @@ void CityInfo_Labor_allocateWorkersToBuildings()
 static void setBuildingWorkerWeight()
 {
 	int waterPer10kPerBuilding = calc_percentage(100, Data_CityInfo.laborCategory[LaborCategory_Water].buildings);
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -245,7 +245,7 @@ static void allocateWorkersToBuildings()
 			Data_CityInfo.laborCategory[i].workersAllocated < Data_CityInfo.laborCategory[i].workersNeeded
 			? 1 : 0;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -286,7 +286,7 @@ static void allocateWorkersToBuildings()
 			}
 		}
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -334,8 +334,8 @@ static void allocateWorkersToWater()
 	}
 	int buildingId = startBuildingId;
 	startBuildingId = 0;
-	for (int guard = 1; guard < MAX_BUILDINGS; guard++, buildingId++) {
-		if (buildingId >= 2000) {
+	for (int guard = 1; guard < Data_Buildings_Extra.capacity; guard++, buildingId++) {
+		if (buildingId >= Data_Buildings_Extra.capacity) {
 			buildingId = 1;
 		}
 		if (!BuildingIsInUse(buildingId) ||
@@ -57,7 +57,7 @@ void CityInfo_Population_recordMonthlyPopulation()
 
 void CityInfo_Population_changeHappiness(int amount)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].houseSize) {
 			Data_Buildings[i].sentiment.houseHappiness += amount;
 			Data_Buildings[i].sentiment.houseHappiness =
@@ -68,7 +68,7 @@ void CityInfo_Population_changeHappiness(int amount)
 
 void CityInfo_Population_setMaxHappiness(int max)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].houseSize) {
 			if (Data_Buildings[i].sentiment.houseHappiness > max) {
 				Data_Buildings[i].sentiment.houseHappiness = max;
@@ -177,7 +177,7 @@ void CityInfo_Population_calculateSentiment()
 	int housesNeedingFood = 0;
 	int totalSentimentContributionFood = 0;
 	int totalSentimentPenaltyTents = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || !b->houseSize) {
 			continue;
@@ -247,7 +247,7 @@ void CityInfo_Population_calculateSentiment()
 
 	int totalSentiment = 0;
 	int totalHouses = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].houseSize &&
 			Data_Buildings[i].housePopulation) {
 			totalHouses++;
@@ -375,7 +375,7 @@ void CityInfo_Population_updateHealthRate()
 	}
 	int totalPopulation = 0;
 	int healthyPopulation = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || !b->houseSize || !b->housePopulation) {
 			continue;
@@ -446,7 +446,7 @@ static void healthCauseDisease(int totalPeople)
 	}
 	Data_Tutorial.tutorial3.disease = 1;
 	// kill people who don't have access to a doctor
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->houseSize && b->housePopulation) {
 			if (!b->data.house.clinic) {
@@ -459,7 +459,7 @@ static void healthCauseDisease(int totalPeople)
 		}
 	}
 	// kill people in tents
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->houseSize && b->housePopulation) {
 			if (b->subtype.houseLevel <= HOUSE_LARGE_TENT) {
@@ -472,7 +472,7 @@ static void healthCauseDisease(int totalPeople)
 		}
 	}
 	// kill anyone
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->houseSize && b->housePopulation) {
 			peopleToKill -= b->housePopulation;
@@ -424,7 +424,7 @@ static void calculateMaxProsperity()
 {
 	int points = 0;
 	int houses = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (Data_Buildings[i].state && Data_Buildings[i].houseSize) {
 			points += model_get_house(Data_Buildings[i].subtype.houseLevel)->prosperity;
 			houses++;
@@ -50,7 +50,7 @@ void CityInfo_Resource_calculateFood()
 	Data_CityInfo.foodInfoGranariesUnderstaffed = 0;
 	Data_CityInfo.foodInfoGranariesNotOperating = 0;
 	Data_CityInfo.foodInfoGranariesNotOperatingWithFood = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY) {
 			continue;
@@ -108,7 +108,7 @@ void CityInfo_Resource_calculateFoodAndSupplyRomeWheat()
 {
 	CityInfo_Resource_calculateFood();
 	if (Data_Scenario.romeSuppliesWheat) {
-		for (int i = 1; i < MAX_BUILDINGS; i++) {
+		for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 			if (BuildingIsInUse(i) && Data_Buildings[i].type == BUILDING_MARKET) {
 				Data_Buildings[i].data.market.inventory[Inventory_Wheat] = 200;
 			}
@@ -122,7 +122,7 @@ void CityInfo_Resource_housesConsumeFood()
 	Data_CityInfo.foodInfoFoodTypesEaten = 0;
 	Data_CityInfo.__unknown_00c0 = 0;
 	int totalConsumed = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->houseSize) {
 			int numTypes = model_get_house(b->subtype.houseLevel)->food_types;
@@ -17,7 +17,7 @@ void CityInfo_Tick_countBuildingTypes()
 	Data_CityInfo.numWorkingDocks = 0;
 	Data_CityInfo.numHospitalWorkers = 0;
 
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i) || Data_Buildings[i].houseSize) {
 			continue;
 		}
@@ -193,7 +193,7 @@ void CityInfo_Tick_distributeTreasuryOverForumsAndSenates()
 		remainder = 0;
 	}
 
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i) || Data_Buildings[i].houseSize) {
 			continue;
 		}
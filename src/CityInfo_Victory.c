@@ -1,6 +1,7 @@
 #include "CityInfo.h"
 
 #include "PlayerMessage.h"
+#include "Runner.h"
 #include "Sound.h"
 #include "UI/AllWindows.h"
 #include "UI/VideoIntermezzo.h"
@@ -17,6 +18,43 @@
 #include "game/time.h"
 #include "graphics/mouse.h"
 
+enum {
+	Ending_Fired,
+	Ending_NextTutorial,
+	Ending_WonGame,
+	Ending_VictoryBalcony,
+	Ending_VictorySenate,
+	Ending_VictoryDialog,
+};
+
+static void showEnding(int ending)
+{
+	if (ending != Ending_Fired && ending != Ending_VictoryDialog) {
+		mouse_reset_up_state();
+	}
+	switch (ending) {
+		case Ending_Fired:
+			UI_Intermezzo_show(Intermezzo_Fired, Window_MissionEnd, 1000);
+			break;
+		case Ending_NextTutorial:
+			// tutorials: immediately go to next mission
+			UI_Window_goTo(Window_VictoryIntermezzo);
+			break;
+		case Ending_WonGame:
+			UI_VideoIntermezzo_show("smk/win_game.smk", 400, 292, Window_VictoryIntermezzo);
+			break;
+		case Ending_VictoryBalcony:
+			UI_VideoIntermezzo_show("smk/victory_balcony.smk", 400, 292, Window_VictoryIntermezzo);
+			break;
+		case Ending_VictorySenate:
+			UI_VideoIntermezzo_show("smk/victory_senate.smk", 400, 292, Window_VictoryIntermezzo);
+			break;
+		case Ending_VictoryDialog:
+			UI_Window_goTo(Window_VictoryDialog);
+			break;
+	}
+}
+
 void CityInfo_Victory_check()
 {
 	if (Data_Scenario.isOpenPlay) {
@@ -94,7 +132,7 @@ void CityInfo_Victory_check()
 		Data_State.selectedBuilding.type = 0;
 		if (Data_State.winState == WinState_Lose) {
 			if (Data_CityInfo.messageShownFired) {
-				UI_Intermezzo_show(Intermezzo_Fired, Window_MissionEnd, 1000);
+				Runner_callUi(showEnding, Ending_Fired, 1);
 			} else {
 				Data_CityInfo.messageShownFired = 1;
 				PlayerMessage_post(1, Message_112_Fired, 0, 0);
@@ -103,25 +141,20 @@ void CityInfo_Victory_check()
 		} else if (Data_State.winState == WinState_Win) {
 			Sound_stopMusic();
 			if (Data_CityInfo.messageShownVictory) {
-				mouse_reset_up_state();
-				
 				if (IsTutorial1() || IsTutorial2()) {
-					// tutorials: immediately go to next mission
-					UI_Window_goTo(Window_VictoryIntermezzo);
+					Runner_callUi(showEnding, Ending_NextTutorial, 1);
 				} else if (!Data_Settings.isCustomScenario && Data_Settings.currentMissionId >= 10) {
 					// Won game
-					UI_VideoIntermezzo_show("smk/win_game.smk", 400, 292, Window_VictoryIntermezzo);
+					Runner_callUi(showEnding, Ending_WonGame, 1);
+				} else if (setting_victory_video()) {
+					Runner_callUi(showEnding, Ending_VictoryBalcony, 1);
 				} else {
-					if (setting_victory_video()) {
-						UI_VideoIntermezzo_show("smk/victory_balcony.smk", 400, 292, Window_VictoryIntermezzo);
-					} else {
-						UI_VideoIntermezzo_show("smk/victory_senate.smk", 400, 292, Window_VictoryIntermezzo);
-					}
+					Runner_callUi(showEnding, Ending_VictorySenate, 1);
 				}
 				Data_State.forceWinCheat = 0;
 			} else {
 				Data_CityInfo.messageShownVictory = 1;
-				UI_Window_goTo(Window_VictoryDialog);
+				Runner_callUi(showEnding, Ending_VictoryDialog, 1);
 			}
 		}
 	}
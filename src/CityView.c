@@ -130,19 +130,19 @@ void CityView_goToGridOffset(int gridOffset)
 
 void CityView_checkCameraBoundaries()
 {
-	int xMin = (165 - Data_Settings_Map.width) / 2;
-	int yMin = (323 - 2 * Data_Settings_Map.height) / 2;
+	int xMin = (VIEW_X_MAX - Data_Settings_Map.width) / 2;
+	int yMin = (VIEW_Y_MAX - 2 - 2 * Data_Settings_Map.height) / 2;
 	if (Data_Settings_Map.camera.x < xMin - 1) {
 		Data_Settings_Map.camera.x = xMin - 1;
 	}
-	if (Data_Settings_Map.camera.x > 165 - xMin - Data_CityView.widthInTiles) {
-		Data_Settings_Map.camera.x = 165 - xMin - Data_CityView.widthInTiles;
+	if (Data_Settings_Map.camera.x > VIEW_X_MAX - xMin - Data_CityView.widthInTiles) {
+		Data_Settings_Map.camera.x = VIEW_X_MAX - xMin - Data_CityView.widthInTiles;
 	}
 	if (Data_Settings_Map.camera.y < yMin) {
 		Data_Settings_Map.camera.y = yMin;
 	}
-	if (Data_Settings_Map.camera.y > 327 - yMin - Data_CityView.heightInTiles) {
-		Data_Settings_Map.camera.y = 327 - yMin - Data_CityView.heightInTiles;
+	if (Data_Settings_Map.camera.y > VIEW_Y_MAX + 2 - yMin - Data_CityView.heightInTiles) {
+		Data_Settings_Map.camera.y = VIEW_Y_MAX + 2 - yMin - Data_CityView.heightInTiles;
 	}
 	Data_Settings_Map.camera.y &= ~1;
 }
@@ -3,7 +3,9 @@
 
 #include "building/type.h"
 
-#define MAX_BUILDINGS 2000
+#define MAX_BUILDINGS 8000
+// Buildings stored in the original save layout, the list grows in steps of this size
+#define MAX_BUILDINGS_LEGACY 2000
 #define MAX_STORAGES 200
 #define MAX_HOUSE_LEVELS 20
 
@@ -39,7 +41,7 @@ extern struct Data_Building {
 	unsigned char houseSize;
 	unsigned char x;
 	unsigned char y;
-	short gridOffset;
+	unsigned short gridOffset;
 	short type;
 	union {
 		short houseLevel;
@@ -214,6 +216,7 @@ extern struct _Data_Buildings_Extra {
 	int highestBuildingIdEver;
 	int createdSequence;
 	int barracksTowerSentryRequested;
+	int capacity; // building IDs in use are below this, at most MAX_BUILDINGS
 } Data_Buildings_Extra;
 
 extern struct _Data_BuildingList {
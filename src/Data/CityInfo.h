@@ -113,13 +113,13 @@ extern struct _Data_CityInfo {
 	char __unknown_2817;
 	unsigned char entryPointX;
 	unsigned char entryPointY;
-	short entryPointGridOffset;
+	unsigned short entryPointGridOffset;
 	unsigned char exitPointX;
 	unsigned char exitPointY;
-	short exitPointGridOffset;
+	unsigned short exitPointGridOffset;
 	unsigned char buildingSenateX;
 	unsigned char buildingSenateY;
-	short buildingSenateGridOffset;
+	unsigned short buildingSenateGridOffset;
 	int buildingSenateBuildingId;
 	char __unknown_2828;
 	char __unknown_2829;
@@ -346,7 +346,7 @@ extern struct _Data_CityInfo {
 	int cheatedMoney;
 	char buildingBarracksX;
 	char buildingBarracksY;
-	short buildingBarracksGridOffset;
+	unsigned short buildingBarracksGridOffset;
 	int buildingBarracksBuildingId;
 	int buildingBarracksPlaced;
 	char __unknown_43d8;
@@ -449,7 +449,7 @@ extern struct _Data_CityInfo {
 	int tutorial1SenateBuilt;
 	char buildingDistributionCenterX;
 	char buildingDistributionCenterY;
-	short buildingDistributionCenterGridOffset;
+	unsigned short buildingDistributionCenterGridOffset;
 	int buildingDistributionCenterBuildingId;
 	int buildingDistributionCenterPlaced;
 	int __unused_4524[11];
@@ -1,8 +1,10 @@
 #ifndef DATA_CITYVIEW_H
 #define DATA_CITYVIEW_H
 
-#define VIEW_X_MAX 165
-#define VIEW_Y_MAX 325
+#include "Grid.h"
+
+#define VIEW_X_MAX (GRID_SIZE + 3)
+#define VIEW_Y_MAX (2 * GRID_SIZE + 1)
 
 extern struct Data_CityView {
 	int xOffsetInPixels;
@@ -1,7 +1,9 @@
 #ifndef DATA_FIGURE_H
 #define DATA_FIGURE_H
 
-#define MAX_FIGURES 1000
+#define MAX_FIGURES 8000
+// Figures stored in the original save layout, the list grows in steps of this size
+#define MAX_FIGURES_LEGACY 1000
 
 #define FigureIsEnemyOrNative(t) ((t) >= FIGURE_INDIGENOUS_NATIVE && (t) <= FIGURE_NATIVE_TRADER)
 #define FigureIsEnemy(t) ((t) >= FIGURE_ENEMY43_SPEAR && (t) <= FIGURE_ENEMY_CAESAR_LEGIONARY)
@@ -172,10 +174,10 @@ extern struct Data_Figure {
 	unsigned char previousTileY;
 	unsigned char missileDamage;
 	unsigned char damage; //19
-	short gridOffset; // 1a
+	unsigned short gridOffset; // 1a
 	unsigned char destinationX; // 1c
 	unsigned char destinationY;
-	short destinationGridOffsetSoldier;
+	unsigned short destinationGridOffsetSoldier;
 	unsigned char sourceX; // 20
 	unsigned char sourceY;
 	signed char formationPositionX;
@@ -250,6 +252,7 @@ extern struct Data_Figure {
 extern struct _Data_Figure_Extra {
 	int highestFigureIdEver;
 	int createdSequence;
+	int capacity; // figure IDs in use are below this, at most MAX_FIGURES
 } Data_Figure_Extra;
 
 #endif
@@ -2,13 +2,24 @@
 #define DATA_GRID_H
 #include "Data.h"
 
+// grid width and height in tiles, build with -DGRID_SIZE=256 for larger maps
+#ifndef GRID_SIZE
+#define GRID_SIZE 162
+#endif
+// grid size of the original game, used by all scenario files
+#define GRID_SIZE_LEGACY 162
+
+// tile coordinates are saved as bytes and grid offsets as 16-bit values
+#if GRID_SIZE < GRID_SIZE_LEGACY || GRID_SIZE > 256
+#error GRID_SIZE must be between 162 and 256
+#endif
+
 #define Int8_Grid(x) char x[GRID_SIZE * GRID_SIZE]
 #define UInt8_Grid(x) unsigned char x[GRID_SIZE * GRID_SIZE]
 #define UInt16_Grid(x) unsigned short x[GRID_SIZE * GRID_SIZE]
 
-enum {
-	GRID_SIZE = 162,
-};
+// grid offset of the tile dx tiles right and dy tiles down
+#define GridDelta(dx,dy) ((dy) * GRID_SIZE + (dx))
 
 enum {
 	Terrain_Tree = 1,
@@ -60,6 +71,7 @@ EXTERN Int8_Grid(Data_Grid_routingLandCitizen);
 EXTERN Int8_Grid(Data_Grid_routingLandNonCitizen);
 EXTERN Int8_Grid(Data_Grid_routingWater);
 EXTERN Int8_Grid(Data_Grid_routingWalls);
+// only valid for the last query, read it with Routing_getCalculatedDistance()
 EXTERN UInt16_Grid(Data_Grid_routingDistance);
 
 EXTERN UInt8_Grid(Data_Grid_romanSoldierConcentration);
@@ -8,7 +8,7 @@
 struct Data_PlayerMessage {
 	int param1;
 	short year;
-	short param2;
+	unsigned short param2;
 	short messageType;
 	short sequence;
 	unsigned char readFlag;
@@ -1,8 +1,9 @@
-#include "AllData.h"
-
+// defines the grids: include before the headers that only declare them
 #define DATA_INTERN 1
 #include "Grid.h"
 
+#include "AllData.h"
+
 struct _Data_Scenario Data_Scenario;
 
 struct _Data_Event Data_Event = {0};
@@ -52,7 +53,7 @@ struct _Data_Routes Data_Routes;
 struct _Data_Debug Data_Debug;
 
 const int Constant_SalaryForRank[11] = {0, 2, 5, 8, 12, 20, 30, 40, 60, 80, 100};
-const int Constant_DirectionGridOffsets[8] = {-162, -161, 1, 163, 162, 161, -1, -163};
+const int Constant_DirectionGridOffsets[8] = {GridDelta(0, -1), GridDelta(1, -1), 1, GridDelta(1, 1), GridDelta(0, 1), GridDelta(-1, 1), -1, GridDelta(-1, -1)};
 
 const struct MissionId Constant_MissionIds[12] = {
 	{0, 0},
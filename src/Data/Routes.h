@@ -2,7 +2,9 @@
 #define DATA_ROUTES_H
 
 #define MAX_ROUTEPATH_LENGTH 500
-#define MAX_ROUTES 600
+#define MAX_ROUTES 3000
+// Routes stored in the original save layout, the list grows in steps of this size
+#define MAX_ROUTES_LEGACY 600
 
 extern struct _Data_Routes {
 	short figureIds[MAX_ROUTES];
@@ -13,6 +15,8 @@ extern struct _Data_Routes {
 	int enemyRoutesCalculated;
 	int unknown1RoutesCalculated;
 	int unknown2RoutesCalculated;
+
+	int capacity; // route IDs in use are below this, at most MAX_ROUTES
 } Data_Routes;
 
 #endif
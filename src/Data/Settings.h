@@ -1,14 +1,16 @@
 #ifndef DATA_SETTINGS_H
 #define DATA_SETTINGS_H
 
+#include "Grid.h"
+
 #include <stdint.h>
 
 #define IsTutorial1() (Data_Settings.currentMissionId == 0 && !Data_Settings.isCustomScenario)
 #define IsTutorial2() (Data_Settings.currentMissionId == 1 && !Data_Settings.isCustomScenario)
 #define IsTutorial3() (Data_Settings.currentMissionId == 2 && !Data_Settings.isCustomScenario)
-#define GridOffset(x,y) (Data_Settings_Map.gridStartOffset + (x) + (y) * 162)
-#define GridOffsetToX(g) (((g) - Data_Settings_Map.gridStartOffset) % 162)
-#define GridOffsetToY(g) (((g) - Data_Settings_Map.gridStartOffset) / 162)
+#define GridOffset(x,y) (Data_Settings_Map.gridStartOffset + (x) + (y) * GRID_SIZE)
+#define GridOffsetToX(g) (((g) - Data_Settings_Map.gridStartOffset) % GRID_SIZE)
+#define GridOffsetToY(g) (((g) - Data_Settings_Map.gridStartOffset) / GRID_SIZE)
 #define IsInsideMap(x,y) ((x) >= 0 && (x) < Data_Settings_Map.width && (y) >= 0 && (y) < Data_Settings_Map.height)
 #define IsOutsideMap(x,y,s) (x) < 0 || (x) + (s) > Data_Settings_Map.width || (y) < 0 || (y) + (s) > Data_Settings_Map.height
 #define BoundToMap(x,y) \
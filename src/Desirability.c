@@ -8,15 +8,279 @@
 #include "Data/Settings.h"
 
 #include "building/model.h"
+#include "core/jobs.h"
+#include "core/trace.h"
+
+#include <string.h>
+
+// build with -DDESIRABILITY_VERIFY_UPDATES=1 to check partial updates against a full recompute
+#ifndef DESIRABILITY_VERIFY_UPDATES
+#define DESIRABILITY_VERIFY_UPDATES 0
+#endif
+
+#define MAX_RANGE 6
+#define MAX_DIRTY_AREAS 32
+// rows per job: each job scans all buildings, so bands should not be too small
+#define ROWS_PER_JOB 16
+
+enum {
+	Source_None = 0,
+	Source_Plaza = 1,
+	Source_Earthquake = 2,
+	Source_Garden = 3,
+	Source_Rubble = 4,
+	// flag was cleared this update, the tile counts again from the next one
+	Source_InvalidFlag = 5
+};
+
+static struct {
+	int valid;
+	struct {
+		unsigned char active;
+		unsigned char size;
+		short type;
+		short x;
+		short y;
+	} buildings[MAX_BUILDINGS];
+	unsigned char terrainSources[GRID_SIZE * GRID_SIZE];
+	int numAreas;
+	int overflow;
+	struct {
+		int xMin;
+		int yMin;
+		int xMax;
+		int yMax;
+	} areas[MAX_DIRTY_AREAS];
+} data;
 
 static void updateBuildings();
 static void updateTerrain();
 
-void Desirability_update()
+void Desirability_invalidate()
+{
+	data.valid = 0;
+}
+
+static void markDirty(int x, int y, int size)
+{
+	int xMin = x - MAX_RANGE;
+	int yMin = y - MAX_RANGE;
+	int xMax = x + size - 1 + MAX_RANGE;
+	int yMax = y + size - 1 + MAX_RANGE;
+	// rings are only written up to one tile outside the map
+	if (xMin < -1) xMin = -1;
+	if (yMin < -1) yMin = -1;
+	if (xMax > Data_Settings_Map.width) xMax = Data_Settings_Map.width;
+	if (yMax > Data_Settings_Map.height) yMax = Data_Settings_Map.height;
+	if (data.numAreas > 0) {
+		// merge with the last area when the result is not much larger
+		int last = data.numAreas - 1;
+		int mergedXMin = xMin < data.areas[last].xMin ? xMin : data.areas[last].xMin;
+		int mergedYMin = yMin < data.areas[last].yMin ? yMin : data.areas[last].yMin;
+		int mergedXMax = xMax > data.areas[last].xMax ? xMax : data.areas[last].xMax;
+		int mergedYMax = yMax > data.areas[last].yMax ? yMax : data.areas[last].yMax;
+		int mergedSize = (mergedXMax - mergedXMin + 1) * (mergedYMax - mergedYMin + 1);
+		int lastSize = (data.areas[last].xMax - data.areas[last].xMin + 1) *
+			(data.areas[last].yMax - data.areas[last].yMin + 1);
+		int newSize = (xMax - xMin + 1) * (yMax - yMin + 1);
+		if (mergedSize <= 2 * (lastSize + newSize)) {
+			data.areas[last].xMin = mergedXMin;
+			data.areas[last].yMin = mergedYMin;
+			data.areas[last].xMax = mergedXMax;
+			data.areas[last].yMax = mergedYMax;
+			return;
+		}
+	}
+	if (data.numAreas >= MAX_DIRTY_AREAS) {
+		data.overflow = 1;
+		return;
+	}
+	data.areas[data.numAreas].xMin = xMin;
+	data.areas[data.numAreas].yMin = yMin;
+	data.areas[data.numAreas].xMax = xMax;
+	data.areas[data.numAreas].yMax = yMax;
+	data.numAreas++;
+}
+
+static int terrainSource(int gridOffset)
+{
+	int terrain = Data_Grid_terrain[gridOffset];
+	if (Data_Grid_bitfields[gridOffset] & Bitfield_PlazaOrEarthquake) {
+		if (terrain & Terrain_Road) {
+			return Source_Plaza;
+		} else if (terrain & Terrain_Rock) {
+			// earthquake fault line: slight negative
+			return Source_Earthquake;
+		} else {
+			// invalid plaza/earthquake flag
+			Data_Grid_bitfields[gridOffset] &= ~Bitfield_PlazaOrEarthquake;
+			return Source_InvalidFlag;
+		}
+	} else if (terrain & Terrain_Garden) {
+		return Source_Garden;
+	} else if (terrain & Terrain_Rubble) {
+		return Source_Rubble;
+	}
+	return Source_None;
+}
+
+// Compares the buildings and terrain with the previous update and marks the areas they influence
+static void findChanges()
+{
+	data.numAreas = 0;
+	data.overflow = 0;
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
+		struct Data_Building *b = &Data_Buildings[i];
+		int active = i <= Data_Buildings_Extra.highestBuildingIdInUse && BuildingIsInUse(i);
+		int changed = active != data.buildings[i].active;
+		if (active && !changed) {
+			changed = b->type != data.buildings[i].type || b->size != data.buildings[i].size ||
+				b->x != data.buildings[i].x || b->y != data.buildings[i].y;
+		}
+		if (!changed) {
+			continue;
+		}
+		if (data.buildings[i].active) {
+			markDirty(data.buildings[i].x, data.buildings[i].y, data.buildings[i].size);
+		}
+		data.buildings[i].active = active;
+		if (active) {
+			data.buildings[i].type = b->type;
+			data.buildings[i].size = b->size;
+			data.buildings[i].x = b->x;
+			data.buildings[i].y = b->y;
+			markDirty(b->x, b->y, b->size);
+		}
+	}
+	int gridOffset = Data_Settings_Map.gridStartOffset;
+	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
+		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
+			int source = terrainSource(gridOffset);
+			if (source != data.terrainSources[gridOffset]) {
+				data.terrainSources[gridOffset] = source;
+				markDirty(x, y, 1);
+			}
+		}
+	}
+}
+
+static void addTerrainSourceInArea(int source, int x, int y, int xMin, int yMin, int xMax, int yMax)
 {
+	int type;
+	switch (source) {
+		case Source_Plaza: type = BUILDING_PLAZA; break;
+		case Source_Earthquake: type = BUILDING_HOUSE_VACANT_LOT; break;
+		case Source_Garden: type = BUILDING_GARDENS; break;
+		case Source_Rubble:
+			Terrain_addDesirabilityInArea(x, y, 1, -2, 1, 1, 2, xMin, yMin, xMax, yMax);
+			return;
+		default:
+			return;
+	}
+	const model_building *model = model_get_building(type);
+	Terrain_addDesirabilityInArea(x, y, 1,
+		model->desirability_value,
+		model->desirability_step,
+		model->desirability_step_size,
+		model->desirability_range,
+		xMin, yMin, xMax, yMax);
+}
+
+// Recalculates the area from scratch, applying all influences in the same order as a full update
+static void updateArea(int xMin, int yMin, int xMax, int yMax)
+{
+	for (int y = yMin; y <= yMax; y++) {
+		int gridOffset = GridOffset(xMin, y);
+		memset(&Data_Grid_desirability[gridOffset], 0, xMax - xMin + 1);
+	}
+	for (int i = 1; i <= Data_Buildings_Extra.highestBuildingIdInUse; i++) {
+		if (!BuildingIsInUse(i)) {
+			continue;
+		}
+		struct Data_Building *b = &Data_Buildings[i];
+		if (b->x + b->size - 1 + MAX_RANGE < xMin || b->x - MAX_RANGE > xMax ||
+			b->y + b->size - 1 + MAX_RANGE < yMin || b->y - MAX_RANGE > yMax) {
+			continue;
+		}
+		const model_building *model = model_get_building(b->type);
+		Terrain_addDesirabilityInArea(b->x, b->y, b->size,
+			model->desirability_value,
+			model->desirability_step,
+			model->desirability_step_size,
+			model->desirability_range,
+			xMin, yMin, xMax, yMax);
+	}
+	int yStart = yMin - MAX_RANGE > 0 ? yMin - MAX_RANGE : 0;
+	int yEnd = yMax + MAX_RANGE < Data_Settings_Map.height - 1 ? yMax + MAX_RANGE : Data_Settings_Map.height - 1;
+	int xStart = xMin - MAX_RANGE > 0 ? xMin - MAX_RANGE : 0;
+	int xEnd = xMax + MAX_RANGE < Data_Settings_Map.width - 1 ? xMax + MAX_RANGE : Data_Settings_Map.width - 1;
+	for (int y = yStart; y <= yEnd; y++) {
+		for (int x = xStart; x <= xEnd; x++) {
+			int source = data.terrainSources[GridOffset(x, y)];
+			if (source) {
+				addTerrainSourceInArea(source, x, y, xMin, yMin, xMax, yMax);
+			}
+		}
+	}
+}
+
+struct AreaColumns {
+	int xMin;
+	int xMax;
+};
+
+static void updateRows(int yMin, int yEnd, void *columns)
+{
+	const struct AreaColumns *area = (const struct AreaColumns *) columns;
+	updateArea(area->xMin, yMin, area->xMax, yEnd - 1);
+}
+
+// Each tile gets the same additions in the same order whichever rows a job updates,
+// so the result does not depend on the number of threads
+static void updateAreaInParallel(int xMin, int yMin, int xMax, int yMax)
+{
+	struct AreaColumns columns = { xMin, xMax };
+	jobs_parallel_for(yMin, yMax + 1, ROWS_PER_JOB, updateRows, &columns);
+}
+
+static void verify(const unsigned char *bitfieldsBeforeUpdate)
+{
+	static char updated[GRID_SIZE * GRID_SIZE];
+	memcpy(updated, Data_Grid_desirability, sizeof(updated));
+	memcpy(Data_Grid_bitfields, bitfieldsBeforeUpdate, sizeof(Data_Grid_bitfields));
 	Grid_clearByteGrid(Data_Grid_desirability);
 	updateBuildings();
 	updateTerrain();
+	for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+		if (updated[i] != Data_Grid_desirability[i]) {
+			TRACE_ERROR(TRACE_EVENT_DESIRABILITY_MISMATCH, i, updated[i], Data_Grid_desirability[i], 0);
+		}
+	}
+}
+
+void Desirability_update()
+{
+	static unsigned char bitfieldsBeforeUpdate[GRID_SIZE * GRID_SIZE];
+	if (DESIRABILITY_VERIFY_UPDATES) {
+		memcpy(bitfieldsBeforeUpdate, Data_Grid_bitfields, sizeof(bitfieldsBeforeUpdate));
+	}
+	if (!data.valid) {
+		memset(&data, 0, sizeof(data));
+	}
+	findChanges();
+	if (!data.valid || data.overflow) {
+		Grid_clearByteGrid(Data_Grid_desirability);
+		updateAreaInParallel(-1, -1, Data_Settings_Map.width, Data_Settings_Map.height);
+		data.valid = 1;
+	} else {
+		for (int i = 0; i < data.numAreas; i++) {
+			// areas may overlap, so they are updated one after the other
+			updateAreaInParallel(data.areas[i].xMin, data.areas[i].yMin, data.areas[i].xMax, data.areas[i].yMax);
+		}
+	}
+	if (DESIRABILITY_VERIFY_UPDATES) {
+		verify(bitfieldsBeforeUpdate);
+	}
 }
 
 static void updateBuildings()
@@ -1,6 +1,12 @@
 #ifndef DESIRABILITY_H
 #define DESIRABILITY_H
 
+// Reads: building positions, sizes and types, terrain, plaza/earthquake bitfields
+// Writes: Data_Grid_desirability, clears invalid plaza/earthquake bitfields
+// The grid rows are updated on the job system, no random numbers are drawn
 void Desirability_update();
 
+// Forces a full recalculation on the next update, call when the grid is loaded or cleared
+void Desirability_invalidate();
+
 #endif
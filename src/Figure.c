@@ -17,30 +17,48 @@
 #include "Data/Settings.h"
 
 #include "core/calc.h"
+#include "core/id_pool.h"
 #include "core/random.h"
 #include "figure/formation.h"
+#include "figure/live_list.h"
 #include "figure/name.h"
 #include "figure/trader.h"
 
 #include <string.h>
 
+#if FIGURE_LIVE_LIST_MAX_FIGURES != MAX_FIGURES
+#error "FIGURE_LIVE_LIST_MAX_FIGURES must match MAX_FIGURES"
+#endif
+
+static id_pool figureIds;
+
 void Figure_clearList()
 {
-	for (int i = 0; i < MAX_FIGURES; i++) {
-		memset(&Data_Figures[i], 0, sizeof(struct Data_Figure));
-	}
+	memset(Data_Figures, 0, MAX_FIGURES * sizeof(struct Data_Figure));
 	Data_Figure_Extra.highestFigureIdEver = 0;
+	Data_Figure_Extra.capacity = MAX_FIGURES_LEGACY;
+	figure_live_list_clear();
+	id_pool_init(&figureIds, Data_Figure_Extra.capacity);
 }
 
-int Figure_create(int figureType, int x, int y, char direction)
+static int allocateFigureId()
 {
-	int id = 0;
-	for (int i = 1; i < MAX_FIGURES; i++) {
-		if (!Data_Figures[i].state) {
-			id = i;
-			break;
-		}
+	int id = id_pool_first_free(&figureIds);
+	if (!id && Data_Figure_Extra.capacity < MAX_FIGURES) {
+		// list is full: grow it, new IDs come after the existing ones
+		id = Data_Figure_Extra.capacity;
+		Data_Figure_Extra.capacity += MAX_FIGURES_LEGACY;
+		id_pool_resize(&figureIds, Data_Figure_Extra.capacity);
 	}
+	if (id) {
+		id_pool_set_used(&figureIds, id);
+	}
+	return id;
+}
+
+int Figure_create(int figureType, int x, int y, char direction)
+{
+	int id = allocateFigureId();
 	if (!id) {
 		return 0;
 	}
@@ -60,6 +78,7 @@ int Figure_create(int figureType, int x, int y, char direction)
 	f->progressOnTile = 15;
 	f->phraseSequenceCity = f->phraseSequenceExact = random_byte() & 3;
 	f->name = figure_name_get(figureType, 0);
+	figure_live_list_add(id);
 	Figure_addToTileList(id);
 	if (figureType == FIGURE_TRADE_CARAVAN || figureType == FIGURE_TRADE_SHIP) {
 		f->traderId = trader_create();
@@ -125,70 +144,147 @@ void Figure_delete(int figureId)
 	}
 	FigureRoute_remove(figureId);
 	Figure_removeFromTileList(figureId);
+	figure_live_list_remove(figureId);
 	memset(f, 0, sizeof(struct Data_Figure));
+	id_pool_set_free(&figureIds, figureId);
+}
+
+// Links that make the tile lists doubly linked, rebuilt from the saved next links on load
+static struct {
+	short prev[MAX_FIGURES];
+	short position[MAX_FIGURES];
+	int tileOffset[MAX_FIGURES]; // grid offset of the list the figure is in, -1 if none
+	unsigned short last[GRID_SIZE * GRID_SIZE];
+	unsigned short count[GRID_SIZE * GRID_SIZE];
+} tileLists;
+
+static void rebuildTileList(int gridOffset)
+{
+	// forget the figures that were in the list, some may have been cut off
+	for (int id = tileLists.last[gridOffset]; id > 0; id = tileLists.prev[id]) {
+		tileLists.tileOffset[id] = -1;
+	}
+	tileLists.last[gridOffset] = 0;
+	tileLists.count[gridOffset] = 0;
+	int prev = 0;
+	for (int id = Data_Grid_figureIds[gridOffset];
+		id > 0 && tileLists.tileOffset[id] != gridOffset && tileLists.count[gridOffset] < MAX_FIGURES;
+		id = Data_Figures[id].nextFigureIdOnSameTile) {
+		tileLists.prev[id] = prev;
+		tileLists.position[id] = tileLists.count[gridOffset]++;
+		tileLists.tileOffset[id] = gridOffset;
+		tileLists.last[gridOffset] = id;
+		prev = id;
+	}
+}
+
+void Figure_rebuildTileLists()
+{
+	for (int i = 0; i < MAX_FIGURES; i++) {
+		tileLists.prev[i] = 0;
+		tileLists.position[i] = 0;
+		tileLists.tileOffset[i] = -1;
+	}
+	memset(tileLists.last, 0, sizeof(tileLists.last));
+	memset(tileLists.count, 0, sizeof(tileLists.count));
+	for (int gridOffset = 0; gridOffset < GRID_SIZE * GRID_SIZE; gridOffset++) {
+		if (Data_Grid_figureIds[gridOffset]) {
+			rebuildTileList(gridOffset);
+		}
+	}
+}
+
+void Figure_rebuildIndex()
+{
+	figure_live_list_clear();
+	id_pool_init(&figureIds, Data_Figure_Extra.capacity);
+	for (int i = 1; i < Data_Figure_Extra.capacity; i++) {
+		if (Data_Figures[i].state) {
+			figure_live_list_add(i);
+			id_pool_set_used(&figureIds, i);
+		}
+	}
+	Figure_rebuildTileLists();
+}
+
+// grid offsets are 16 bits: on the largest grid every value is a tile
+static int isOnGrid(int gridOffset)
+{
+	return gridOffset < GRID_SIZE * GRID_SIZE;
 }
 
 void Figure_addToTileList(int figureId)
 {
-	if (Data_Figures[figureId].gridOffset < 0) {
+	if (!isOnGrid(Data_Figures[figureId].gridOffset)) {
 		return;
 	}
 	struct Data_Figure *f = &Data_Figures[figureId];
-	f->numPreviousFiguresOnSameTile = 0;
+	int count = tileLists.count[f->gridOffset];
+	f->numPreviousFiguresOnSameTile = count > 20 ? 20 : count;
 
-	int next = Data_Grid_figureIds[f->gridOffset];
-	if (next) {
-		f->numPreviousFiguresOnSameTile++;
-		while (Data_Figures[next].nextFigureIdOnSameTile) {
-			next = Data_Figures[next].nextFigureIdOnSameTile;
-			f->numPreviousFiguresOnSameTile++;
-		}
-		if (f->numPreviousFiguresOnSameTile > 20) {
-			f->numPreviousFiguresOnSameTile = 20;
-		}
-		Data_Figures[next].nextFigureIdOnSameTile = figureId;
+	int last = tileLists.last[f->gridOffset];
+	if (last) {
+		Data_Figures[last].nextFigureIdOnSameTile = figureId;
 	} else {
 		Data_Grid_figureIds[f->gridOffset] = figureId;
 	}
+	tileLists.prev[figureId] = last;
+	tileLists.position[figureId] = count;
+	tileLists.tileOffset[figureId] = f->gridOffset;
+	tileLists.last[f->gridOffset] = figureId;
+	tileLists.count[f->gridOffset]++;
 }
 
 void Figure_updatePositionInTileList(int figureId)
 {
 	struct Data_Figure *f = &Data_Figures[figureId];
-	f->numPreviousFiguresOnSameTile = 0;
-	
-	int next = Data_Grid_figureIds[f->gridOffset];
-	while (next) {
-		if (next == figureId) {
-			return;
-		}
-		f->numPreviousFiguresOnSameTile++;
-		next = Data_Figures[next].nextFigureIdOnSameTile;
-	}
-	if (f->numPreviousFiguresOnSameTile > 20) {
-		f->numPreviousFiguresOnSameTile = 20;
+	if (tileLists.tileOffset[figureId] == f->gridOffset) {
+		f->numPreviousFiguresOnSameTile = tileLists.position[figureId];
+	} else {
+		int count = tileLists.count[f->gridOffset];
+		f->numPreviousFiguresOnSameTile = count > 20 ? 20 : count;
 	}
 }
 
 void Figure_removeFromTileList(int figureId)
 {
-	if (Data_Figures[figureId].gridOffset < 0) {
+	if (!isOnGrid(Data_Figures[figureId].gridOffset)) {
 		return;
 	}
 	struct Data_Figure *f = &Data_Figures[figureId];
-
-	int cur = Data_Grid_figureIds[f->gridOffset];
-	if (cur) {
-		if (cur == figureId) {
-			Data_Grid_figureIds[f->gridOffset] = f->nextFigureIdOnSameTile;
-		} else {
-			while (cur && Data_Figures[cur].nextFigureIdOnSameTile != figureId) {
-				cur = Data_Figures[cur].nextFigureIdOnSameTile;
-			}
-			Data_Figures[cur].nextFigureIdOnSameTile = f->nextFigureIdOnSameTile;
-		}
+	int gridOffset = f->gridOffset;
+	if (!Data_Grid_figureIds[gridOffset]) {
+		return;
+	}
+	int listOffset = tileLists.tileOffset[figureId];
+	if (listOffset != gridOffset) {
+		// not in the list of its tile: the original search runs off the end of the list
+		Data_Figures[0].nextFigureIdOnSameTile = f->nextFigureIdOnSameTile;
 		f->nextFigureIdOnSameTile = 0;
+		if (listOffset >= 0) {
+			rebuildTileList(listOffset);
+		}
+		return;
 	}
+	int prev = tileLists.prev[figureId];
+	int next = f->nextFigureIdOnSameTile;
+	if (prev) {
+		Data_Figures[prev].nextFigureIdOnSameTile = next;
+	} else {
+		Data_Grid_figureIds[gridOffset] = next;
+	}
+	if (next) {
+		tileLists.prev[next] = prev;
+	} else {
+		tileLists.last[gridOffset] = prev;
+	}
+	for (int id = next; id > 0; id = Data_Figures[id].nextFigureIdOnSameTile) {
+		tileLists.position[id]--;
+	}
+	tileLists.count[gridOffset]--;
+	tileLists.tileOffset[figureId] = -1;
+	tileLists.prev[figureId] = 0;
+	f->nextFigureIdOnSameTile = 0;
 }
 
 static const int dustCloudTileOffsets[] = {0, 0, 0, 1, 1, 2};
@@ -289,7 +385,7 @@ void Figure_createFlotsam(int xEntry, int yEntry, int hasWater)
 	if (!hasWater || !Data_Scenario.flotsamEnabled) {
 		return;
 	}
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	for (int i = 1; i < Data_Figure_Extra.capacity; i++) {
 		if (Data_Figures[i].state && Data_Figures[i].type == FIGURE_FLOTSAM) {
 			Figure_delete(i);
 		}
@@ -374,7 +470,7 @@ int Figure_createTowerSentryFromBarracks(int buildingId, int x, int y)
 		return 0;
 	}
 	int towerId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->type == BUILDING_TOWER && b->numWorkers > 0 &&
 			!b->figureId && b->roadNetworkId == Data_Buildings[buildingId].roadNetworkId) {
@@ -403,7 +499,7 @@ int Figure_createTowerSentryFromBarracks(int buildingId, int x, int y)
 
 void Figure_killTowerSentriesAt(int x, int y)
 {
-	for (int i = 0; i < MAX_FIGURES; i++) {
+	for (int i = 0; i < Data_Figure_Extra.capacity; i++) {
 		if (!FigureIsDead(i) && Data_Figures[i].type == FIGURE_TOWER_SENTRY) {
 			if (calc_maximum_distance(Data_Figures[i].x, Data_Figures[i].y, x, y) <= 1) {
 				Data_Figures[i].state = FigureState_Dead;
@@ -414,7 +510,7 @@ void Figure_killTowerSentriesAt(int x, int y)
 
 void Figure_sinkAllShips()
 {
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	for (int i = 1; i < Data_Figure_Extra.capacity; i++) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state != FigureState_Alive) {
 			continue;
@@ -471,7 +567,7 @@ int Figure_getNonCitizenOnSameTile(int figureId)
 
 int Figure_hasNearbyEnemy(int xStart, int yStart, int xEnd, int yEnd)
 {
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state != FigureState_Alive || !FigureIsEnemy(f->type)) {
 			continue;
@@ -14,6 +14,8 @@ int Figure_createMissile(int buildingId, int x, int y, int xDst, int yDst, int t
 int Figure_createSoldierFromBarracks(int buildingId, int x, int y);
 int Figure_createTowerSentryFromBarracks(int buildingId, int x, int y);
 
+void Figure_rebuildIndex();
+void Figure_rebuildTileLists();
 void Figure_addToTileList(int figureId);
 void Figure_updatePositionInTileList(int figureId);
 void Figure_removeFromTileList(int figureId);
@@ -29,6 +31,7 @@ int Figure_playPhrase(int figureId);
 void Figure_playDieSound(int figureType);
 void Figure_playHitSound(int figureType);
 
+void Figure_initServiceCoverage();
 int Figure_provideServiceCoverage(int figureId);
 
 void FigureRoute_clearList();
@@ -36,6 +39,8 @@ void FigureRoute_clean();
 int FigureRoute_getNumAvailable();
 void FigureRoute_add(int figureId);
 void FigureRoute_remove(int figureId);
+void FigureRoute_clearCache();
+void FigureRoute_setFightingFigures(int hasFightingFigures);
 
 void FigureGeneration_generateFiguresForBuildings();
 
@@ -3,6 +3,8 @@
 #include "Figure.h"
 #include "Data/CityInfo.h"
 
+#include "figure/live_list.h"
+
 static void (*figureActionCallbacks[])(int figureId) = {
 	FigureAction_nobody, //0
 	FigureAction_immigrant,
@@ -98,23 +100,25 @@ void FigureAction_handle()
 	if (Data_CityInfo.riotersOrAttackingNativesInCity > 0) {
 		Data_CityInfo.riotersOrAttackingNativesInCity--;
 	}
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	int hasFightingFigures = 0;
+	FOR_EACH_LIVE_FIGURE(i) {
 		struct Data_Figure *f = &Data_Figures[i];
-		if (f->state) {
-			if (f->targetedByFigureId) {
-				if (Data_Figures[f->targetedByFigureId].state != FigureState_Alive) {
-					f->targetedByFigureId = 0;
-				}
-				if (Data_Figures[f->targetedByFigureId].targetFigureId != i) {
-					f->targetedByFigureId = 0;
-				}
+		if (f->targetedByFigureId) {
+			if (Data_Figures[f->targetedByFigureId].state != FigureState_Alive) {
+				f->targetedByFigureId = 0;
 			}
-			figureActionCallbacks[f->type](i);
-			if (f->state == FigureState_Dead) {
-				Figure_delete(i);
+			if (Data_Figures[f->targetedByFigureId].targetFigureId != i) {
+				f->targetedByFigureId = 0;
 			}
 		}
+		figureActionCallbacks[f->type](i);
+		if (f->state == FigureState_Dead) {
+			Figure_delete(i);
+		} else if (f->actionState == FigureActionState_150_Attack) {
+			hasFightingFigures = 1;
+		}
 	}
+	FigureRoute_setFightingFigures(hasFightingFigures);
 }
 
 void FigureAction_nobody(int figureId)
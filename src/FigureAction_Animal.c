@@ -390,7 +390,7 @@ void FigureAction_HippodromeHorse_reroute()
 	if (!Data_CityInfo.entertainmentHippodromeHasShow) {
 		return;
 	}
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	for (int i = 1; i < Data_Figure_Extra.capacity; i++) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state == FigureState_Alive && f->type == FIGURE_HIPPODROME_HORSES) {
 			f->waitTicksMissile = 0;
@@ -1,9 +1,11 @@
 #include "FigureAction_private.h"
 
 #include "core/calc.h"
+#include "Figure.h"
 #include "FigureMovement.h"
 #include "Routing.h"
 
+#include "figure/live_list.h"
 #include "figure/properties.h"
 #include "figure/type.h"
 
@@ -11,7 +13,7 @@ int FigureAction_CombatSoldier_getTarget(int x, int y, int maxDistance)
 {
 	int minFigureId = 0;
 	int minDistance = 10000;
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		if (FigureIsDead(i)) {
 			continue;
 		}
@@ -33,7 +35,7 @@ int FigureAction_CombatSoldier_getTarget(int x, int y, int maxDistance)
 	if (minFigureId) {
 		return minFigureId;
 	}
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		if (FigureIsDead(i)) {
 			continue;
 		}
@@ -53,7 +55,7 @@ int FigureAction_CombatSoldier_getMissileTarget(int soldierId, int maxDistance,
 	
 	int minFigureId = 0;
 	int minDistance = maxDistance;
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		if (FigureIsDead(i)) {
 			continue;
 		}
@@ -79,7 +81,7 @@ int FigureAction_CombatWolf_getTarget(int x, int y, int maxDistance)
 {
 	int minFigureId = 0;
 	int minDistance = 10000;
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (FigureIsDead(i) || !f->type) {
 			continue;
@@ -127,7 +129,7 @@ int FigureAction_CombatEnemy_getTarget(int x, int y)
 {
 	int minFigureId = 0;
 	int minDistance = 10000;
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		if (FigureIsDead(i)) {
 			continue;
 		}
@@ -144,7 +146,7 @@ int FigureAction_CombatEnemy_getTarget(int x, int y)
 		return minFigureId;
 	}
 	// no 'free' soldier found, take first one
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		if (FigureIsDead(i)) {
 			continue;
 		}
@@ -162,7 +164,7 @@ int FigureAction_CombatEnemy_getMissileTarget(int enemyId, int maxDistance, int
 	
 	int minFigureId = 0;
 	int minDistance = maxDistance;
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (FigureIsDead(i) || !f->type) {
 			continue;
@@ -256,6 +258,7 @@ void FigureAction_Combat_attackFigure(int figureId, int opponentId)
 			attack = 0;
 		}
 		if (attack) {
+			FigureRoute_setFightingFigures(1);
 			f->actionStateBeforeAttack = f->actionState;
 			f->actionState = FigureActionState_150_Attack;
 			f->opponentId = opponentId;
@@ -712,7 +712,7 @@ int FigureAction_HerdEnemy_moveFormationTo(int formationId, int x, int y, int *x
 						canMove = 0;
 						break;
 					}
-					if (Data_Grid_routingDistance[gridOffset] <= 0) {
+					if (Routing_getCalculatedDistance(gridOffset) <= 0) {
 						canMove = 0;
 						break;
 					}
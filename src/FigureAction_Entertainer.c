@@ -16,7 +16,7 @@ static int determineDestination(int x, int y, int btype1, int btype2)
 
     building_list_small_clear();
 	
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i)) {
 			continue;
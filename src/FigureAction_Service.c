@@ -11,6 +11,7 @@
 
 #include "core/calc.h"
 #include "figure/enemy_army.h"
+#include "figure/live_list.h"
 #include "figure/type.h"
 
 void FigureAction_taxCollector(int figureId)
@@ -173,7 +174,7 @@ static int prefectGetNearestEnemy(int x, int y, int *distance)
 {
 	int minEnemyId = 0;
 	int minDist = 10000;
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state != FigureState_Alive || f->targetedByFigureId) {
 			continue;
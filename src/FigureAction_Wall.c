@@ -277,7 +277,7 @@ void FigureAction_towerSentry(int figureId)
 
 void FigureAction_TowerSentry_reroute()
 {
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	for (int i = 1; i < Data_Figure_Extra.capacity; i++) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->type != FIGURE_TOWER_SENTRY || Data_Grid_routingWalls[f->gridOffset] == 0) {
 			continue;
@@ -102,11 +102,11 @@ static void figureMoveToNextTile(int figureId, struct Data_Figure *f)
 			return;
 		case Dir_0_Top:
 			f->y--;
-			f->gridOffset -= 162;
+			f->gridOffset -= GRID_SIZE;
 			break;
 		case Dir_1_TopRight:
 			f->x++; f->y--;
-			f->gridOffset -= 161;
+			f->gridOffset -= GRID_SIZE - 1;
 			break;
 		case Dir_2_Right:
 			f->x++;
@@ -114,15 +114,15 @@ static void figureMoveToNextTile(int figureId, struct Data_Figure *f)
 			break;
 		case Dir_3_BottomRight:
 			f->x++; f->y++;
-			f->gridOffset += 163;
+			f->gridOffset += GRID_SIZE + 1;
 			break;
 		case Dir_4_Bottom:
 			f->y++;
-			f->gridOffset += 162;
+			f->gridOffset += GRID_SIZE;
 			break;
 		case Dir_5_BottomLeft:
 			f->x--; f->y++;
-			f->gridOffset += 161;
+			f->gridOffset += GRID_SIZE - 1;
 			break;
 		case Dir_6_Left:
 			f->x--;
@@ -130,7 +130,7 @@ static void figureMoveToNextTile(int figureId, struct Data_Figure *f)
 			break;
 		case Dir_7_TopLeft:
 			f->x--; f->y--;
-			f->gridOffset -= 163;
+			f->gridOffset -= GRID_SIZE + 1;
 			break;
 	}
 	Figure_addToTileList(figureId);
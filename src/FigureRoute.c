@@ -5,6 +5,18 @@
 #include "Data/Building.h"
 #include "Data/Routes.h"
 #include "Data/Figure.h"
+#include "Data/Settings.h"
+
+#include "core/id_pool.h"
+#include "core/trace.h"
+#include "figure/route_cache.h"
+
+#include <string.h>
+
+static struct {
+	int hasFightingFigures;
+	id_pool pathIds;
+} data = {1};
 
 void FigureRoute_clearList()
 {
@@ -14,39 +26,132 @@ void FigureRoute_clearList()
 			Data_Routes.directionPaths[i][j] = 0;
 		}
 	}
+	Data_Routes.capacity = MAX_ROUTES_LEGACY;
+	id_pool_init(&data.pathIds, Data_Routes.capacity);
 }
 
 void FigureRoute_clean()
 {
-	for (int i = 0; i < MAX_ROUTES; i++) {
+	id_pool_init(&data.pathIds, Data_Routes.capacity);
+	for (int i = 0; i < Data_Routes.capacity; i++) {
 		int figureId = Data_Routes.figureIds[i];
 		if (figureId > 0 && figureId < MAX_FIGURES) {
 			if (Data_Figures[figureId].state != FigureState_Alive || Data_Figures[figureId].routingPathId != i) {
 				Data_Routes.figureIds[i] = 0;
 			}
 		}
+		if (Data_Routes.figureIds[i]) {
+			id_pool_set_used(&data.pathIds, i);
+		}
 	}
 }
 
 int FigureRoute_getNumAvailable()
 {
-	int available = 0;
-	for (int i = 1; i < MAX_ROUTES; i++) {
-		if (!Data_Routes.figureIds[i]) {
-			available++;
-		}
-	}
-	return available;
+	return id_pool_num_free(&data.pathIds) + MAX_ROUTES - Data_Routes.capacity;
 }
 
 static int getFirstAvailable()
 {
-	for (int i = 1; i < MAX_ROUTES; i++) {
-		if (Data_Routes.figureIds[i] == 0) {
-			return i;
+	int pathId = id_pool_first_free(&data.pathIds);
+	if (!pathId && Data_Routes.capacity < MAX_ROUTES) {
+		// all paths are taken: grow the list, new IDs come after the existing ones
+		pathId = Data_Routes.capacity;
+		Data_Routes.capacity += MAX_ROUTES_LEGACY;
+		id_pool_resize(&data.pathIds, Data_Routes.capacity);
+	}
+	return pathId;
+}
+
+static int calculateLandRoute(struct Data_Figure *f, int pathId)
+{
+	int pathLength;
+	int canTravel;
+	switch (f->terrainUsage) {
+		case FigureTerrainUsage_Enemy:
+			canTravel = Routing_findRouteOverLandNonCitizen(f->x, f->y,
+				f->destinationX, f->destinationY, f->destinationBuildingId, 5000);
+			if (!canTravel) {
+				canTravel = Routing_findRouteOverLandNonCitizen(f->x, f->y,
+					f->destinationX, f->destinationY, 0, 25000);
+				if (!canTravel) {
+					canTravel = Routing_findRouteThroughEverythingNonCitizen(
+						f->x, f->y, f->destinationX, f->destinationY);
+				}
+			}
+			break;
+		case FigureTerrainUsage_Walls:
+			canTravel = Routing_findRouteOverWalls(f->x, f->y,
+				f->destinationX, f->destinationY);
+			break;
+		case FigureTerrainUsage_Animal:
+			canTravel = Routing_findRouteOverLandNonCitizen(f->x, f->y,
+				f->destinationX, f->destinationY, MAX_BUILDINGS, 5000);
+			break;
+		case FigureTerrainUsage_PreferRoads:
+			canTravel = Routing_findRouteOverRoadGardenCitizen(f->x, f->y,
+				f->destinationX, f->destinationY);
+			if (!canTravel) {
+				canTravel = Routing_findRouteOverLandCitizen(f->x, f->y,
+					f->destinationX, f->destinationY);
+			}
+			break;
+		case FigureTerrainUsage_Roads:
+			canTravel = Routing_findRouteOverRoadGardenCitizen(f->x, f->y,
+				f->destinationX, f->destinationY);
+			break;
+		default:
+			canTravel = Routing_findRouteOverLandCitizen(f->x, f->y,
+				f->destinationX, f->destinationY);
+			break;
+	}
+	if (canTravel) {
+		if (f->terrainUsage == FigureTerrainUsage_Walls) {
+			pathLength = Routing_getPath(4, pathId, f->x, f->y,
+				f->destinationX, f->destinationY);
+			if (pathLength <= 0) {
+				pathLength = Routing_getPath(8, pathId, f->x, f->y,
+					f->destinationX, f->destinationY);
+			}
+		} else {
+			pathLength = Routing_getPath(8, pathId, f->x, f->y,
+				f->destinationX, f->destinationY);
 		}
+	} else { // cannot travel
+		pathLength = 0;
+	}
+	return pathLength;
+}
+
+static int getLandRoute(struct Data_Figure *f, int pathId)
+{
+	// fighting figures block tiles without changing the routing grids
+	if (data.hasFightingFigures) {
+		return calculateLandRoute(f, pathId);
+	}
+	route_cache_key key = {
+		GridOffset(f->x, f->y),
+		GridOffset(f->destinationX, f->destinationY),
+		f->terrainUsage,
+		f->terrainUsage == FigureTerrainUsage_Enemy ? f->destinationBuildingId : 0
+	};
+	int version = Routing_getTerrainVersion();
+	const route_cache_path *cached = route_cache_get(&key, version);
+	if (cached) {
+		memcpy(Data_Routes.directionPaths[pathId], cached->directions, cached->length);
+		Data_Routes.totalRoutesCalculated += cached->routes_calculated;
+		Data_Routes.enemyRoutesCalculated += cached->enemy_routes_calculated;
+		return cached->length;
 	}
-	return 0;
+	int totalRoutes = Data_Routes.totalRoutesCalculated;
+	int enemyRoutes = Data_Routes.enemyRoutesCalculated;
+	int pathLength = calculateLandRoute(f, pathId);
+	route_cache_path *path = route_cache_add(&key, version);
+	path->length = pathLength;
+	path->routes_calculated = Data_Routes.totalRoutesCalculated - totalRoutes;
+	path->enemy_routes_calculated = Data_Routes.enemyRoutesCalculated - enemyRoutes;
+	memcpy(path->directions, Data_Routes.directionPaths[pathId], pathLength);
+	return pathLength;
 }
 
 void FigureRoute_add(int figureId)
@@ -57,12 +162,13 @@ void FigureRoute_add(int figureId)
 	f->routingPathLength = 0;
 	int pathId = getFirstAvailable();
 	if (!pathId) {
+		TRACE_INFO(TRACE_EVENT_ROUTE_NO_FREE_PATH, figureId, 0, 0, 0);
 		return;
 	}
 	int pathLength;
 	if (f->isBoat) {
 		if (f->isBoat == 2) { // flotsam
-			Routing_getDistanceWaterFlotsam(f->x, f->y);
+			Routing_findRouteWaterFlotsam(f->x, f->y, f->destinationX, f->destinationY);
 			pathLength = Routing_getPathOnWater(pathId, f->x, f->y,
 				f->destinationX, f->destinationY, 1);
 		} else {
@@ -72,63 +178,13 @@ void FigureRoute_add(int figureId)
 		}
 	} else {
 		// land figure
-		int canTravel;
-		switch (f->terrainUsage) {
-			case FigureTerrainUsage_Enemy:
-				canTravel = Routing_canTravelOverLandNonCitizen(f->x, f->y,
-					f->destinationX, f->destinationY, f->destinationBuildingId, 5000);
-				if (!canTravel) {
-					canTravel = Routing_canTravelOverLandNonCitizen(f->x, f->y,
-						f->destinationX, f->destinationY, 0, 25000);
-					if (!canTravel) {
-						canTravel = Routing_canTravelThroughEverythingNonCitizen(
-							f->x, f->y, f->destinationX, f->destinationY);
-					}
-				}
-				break;
-			case FigureTerrainUsage_Walls:
-				canTravel = Routing_canTravelOverWalls(f->x, f->y,
-					f->destinationX, f->destinationY);
-				break;
-			case FigureTerrainUsage_Animal:
-				canTravel = Routing_canTravelOverLandNonCitizen(f->x, f->y,
-					f->destinationX, f->destinationY, MAX_BUILDINGS, 5000);
-				break;
-			case FigureTerrainUsage_PreferRoads:
-				canTravel = Routing_canTravelOverRoadGardenCitizen(f->x, f->y,
-					f->destinationX, f->destinationY);
-				if (!canTravel) {
-					canTravel = Routing_canTravelOverLandCitizen(f->x, f->y,
-						f->destinationX, f->destinationY);
-				}
-				break;
-			case FigureTerrainUsage_Roads:
-				canTravel = Routing_canTravelOverRoadGardenCitizen(f->x, f->y,
-					f->destinationX, f->destinationY);
-				break;
-			default:
-				canTravel = Routing_canTravelOverLandCitizen(f->x, f->y,
-					f->destinationX, f->destinationY);
-				break;
-		}
-		if (canTravel) {
-			if (f->terrainUsage == FigureTerrainUsage_Walls) {
-				pathLength = Routing_getPath(4, pathId, f->x, f->y,
-					f->destinationX, f->destinationY);
-				if (pathLength <= 0) {
-					pathLength = Routing_getPath(8, pathId, f->x, f->y,
-						f->destinationX, f->destinationY);
-				}
-			} else {
-				pathLength = Routing_getPath(8, pathId, f->x, f->y,
-					f->destinationX, f->destinationY);
-			}
-		} else { // cannot travel
-			pathLength = 0;
-		}
+		pathLength = getLandRoute(f, pathId);
 	}
+	TRACE_DEBUG(TRACE_EVENT_ROUTE, figureId, GridOffset(f->x, f->y),
+		GridOffset(f->destinationX, f->destinationY), pathLength);
 	if (pathLength) {
 		Data_Routes.figureIds[pathId] = figureId;
+		id_pool_set_used(&data.pathIds, pathId);
 		f->routingPathId = pathId;
 		f->routingPathLength = pathLength;
 	}
@@ -140,7 +196,19 @@ void FigureRoute_remove(int figureId)
 	if (path > 0) {
 		if (Data_Routes.figureIds[path] == figureId) {
 			Data_Routes.figureIds[path] = 0;
+			id_pool_set_free(&data.pathIds, path);
 		}
 		Data_Figures[figureId].routingPathId = 0;
 	}
 }
+
+void FigureRoute_clearCache()
+{
+	route_cache_clear();
+	data.hasFightingFigures = 1;
+}
+
+void FigureRoute_setFightingFigures(int hasFightingFigures)
+{
+	data.hasFightingFigures = hasFightingFigures;
+}
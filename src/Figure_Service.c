@@ -11,121 +11,136 @@
 
 #include "building/model.h"
 #include "figure/type.h"
+#include "map/building_coverage.h"
 
-#define FOR_XY_RADIUS \
-	int xMin = x - 2;\
-	int yMin = y - 2;\
-	int xMax = x + 2;\
-	int yMax = y + 2;\
-	Bound2ToMap(xMin, yMin, xMax, yMax);\
-	int gridOffset = GridOffset(xMin, yMin);\
-	for (int yy = yMin; yy <= yMax; yy++) {\
-		for (int xx = xMin; xx <= xMax; xx++) {\
-			int buildingId = Data_Grid_buildingIds[gridOffset];\
-			if (buildingId) {
+// visits each building within 2 tiles once, coverage->building_tiles[i] of its tiles are in range
+#define FOR_BUILDINGS_IN_RADIUS \
+	const building_coverage *coverage = map_building_coverage_get(x, y);\
+	for (int i = 0; i < coverage->num_buildings; i++) {\
+		int buildingId = coverage->building_ids[i];
+
+#define END_FOR_BUILDINGS_IN_RADIUS \
+	}
+
+// visits the building on each tile within 2 tiles, row by row
+#define FOR_BUILDING_TILES_IN_RADIUS \
+	const building_coverage *coverage = map_building_coverage_get(x, y);\
+	for (int t = 0; t < coverage->num_tiles; t++) {\
+		int buildingId = coverage->building_ids[coverage->tile_buildings[t]];
 
-#define END_FOR_XY_RADIUS \
-			}\
-			++gridOffset;\
-		}\
-		gridOffset += 162 - (xMax - xMin + 1);\
+#define END_FOR_BUILDING_TILES_IN_RADIUS \
 	}
 
+// services of hippodrome parts go to the main building
+static int serviceBuildingId(int buildingId)
+{
+	if (Data_Buildings[buildingId].type == BUILDING_HIPPODROME) {
+		return Building_getMainBuildingId(buildingId);
+	}
+	return buildingId;
+}
+
+void Figure_initServiceCoverage()
+{
+	map_building_coverage_grid grid = {
+		Data_Grid_buildingIds,
+		Data_Settings_Map.gridStartOffset,
+		Data_Settings_Map.width,
+		Data_Settings_Map.height,
+		serviceBuildingId
+	};
+	map_building_coverage_init(&grid);
+}
+
 static int provideEngineerCoverage(int x, int y, int *maxDamageRiskSeen)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
-		if (Data_Buildings[buildingId].type == BUILDING_HIPPODROME) {
-			buildingId = Building_getMainBuildingId(buildingId);
-		}
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].damageRisk > *maxDamageRiskSeen) {
 			*maxDamageRiskSeen = Data_Buildings[buildingId].damageRisk;
 		}
 		Data_Buildings[buildingId].damageRisk = 0;
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int providePrefectFireCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
-		if (Data_Buildings[buildingId].type == BUILDING_HIPPODROME) {
-			buildingId = Building_getMainBuildingId(buildingId);
-		}
+	FOR_BUILDINGS_IN_RADIUS {
 		Data_Buildings[buildingId].fireRisk = 0;
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int getPrefectCrimeCoverage(int x, int y)
 {
 	int minHappinessSeen = 100;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].sentiment.houseHappiness < minHappinessSeen) {
 			minHappinessSeen = Data_Buildings[buildingId].sentiment.houseHappiness;
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return minHappinessSeen;
 }
 
 static int provideTheaterCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.theater = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideAmphitheaterCoverage(int x, int y, int numShows)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.amphitheaterActor = 96;
 			if (numShows == 2) {
 				Data_Buildings[buildingId].data.house.amphitheaterGladiator = 96;
 			}
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideColosseumCoverage(int x, int y, int numShows)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.colosseumGladiator = 96;
 			if (numShows == 2) {
 				Data_Buildings[buildingId].data.house.colosseumLion = 96;
 			}
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideHippodromeCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.hippodrome = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
@@ -133,7 +148,7 @@ static int provideMarketGoods(int marketBuildingId, int x, int y)
 {
 	int serviced = 0;
 	struct Data_Building *market = &Data_Buildings[marketBuildingId];
-	FOR_XY_RADIUS {
+	FOR_BUILDING_TILES_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			serviced++;
 			struct Data_Building *house = &Data_Buildings[buildingId];
@@ -218,26 +233,26 @@ static int provideMarketGoods(int marketBuildingId, int x, int y)
 				}
 			}
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDING_TILES_IN_RADIUS;
 	return serviced;
 }
 
 static int provideBathhouseCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.bathhouse = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideReligionCoverage(int x, int y, int god)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			switch (god) {
 				case God_Ceres:
@@ -256,81 +271,81 @@ static int provideReligionCoverage(int x, int y, int god)
 					Data_Buildings[buildingId].data.house.templeVenus = 96;
 					break;
 			}
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideSchoolCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.school = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideAcademyCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.academy = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideLibraryCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.library = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideBarberCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.barber = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideClinicCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.clinic = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
 static int provideHospitalCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			Data_Buildings[buildingId].data.house.hospital = 96;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
@@ -353,7 +368,7 @@ static int provideMissionaryCoverage(int x, int y)
 			}
 			++gridOffset;
 		}
-		gridOffset += 162 - (xMax - xMin + 1);
+		gridOffset += GRID_SIZE - (xMax - xMin + 1);
 	}
 	return 1;
 }
@@ -361,11 +376,11 @@ static int provideMissionaryCoverage(int x, int y)
 static int provideLaborSeekerCoverage(int x, int y)
 {
 	int serviced = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
@@ -373,16 +388,16 @@ static int provideTaxCollectorCoverage(int x, int y, unsigned char *maxTaxMultip
 {
 	int serviced = 0;
 	*maxTaxMultiplier = 0;
-	FOR_XY_RADIUS {
+	FOR_BUILDINGS_IN_RADIUS {
 		if (Data_Buildings[buildingId].houseSize && Data_Buildings[buildingId].housePopulation > 0) {
 			int taxMultiplier = model_get_house(Data_Buildings[buildingId].subtype.houseLevel)->tax_multiplier;
 			if (taxMultiplier > *maxTaxMultiplier) {
 				*maxTaxMultiplier = taxMultiplier;
 			}
 			Data_Buildings[buildingId].houseTaxCoverage = 50;
-			serviced++;
+			serviced += coverage->building_tiles[i];
 		}
-	} END_FOR_XY_RADIUS;
+	} END_FOR_BUILDINGS_IN_RADIUS;
 	return serviced;
 }
 
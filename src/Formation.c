@@ -18,6 +18,7 @@
 #include "building/model.h"
 #include "figure/enemy_army.h"
 #include "figure/formation.h"
+#include "figure/live_list.h"
 #include "figure/properties.h"
 
 #include <string.h>
@@ -87,7 +88,7 @@ void Formation_legionMoveTo(int formationId, int x, int y)
 {
 	const formation *m = formation_get(formationId);
 	Routing_getDistance(m->x_home, m->y_home);
-	if (Data_Grid_routingDistance[GridOffset(x, y)] <= 0) {
+	if (Routing_getCalculatedDistance(GridOffset(x, y)) <= 0) {
 		return; // unable to route there
 	}
 	if (x == m->x_home && y == m->y_home) {
@@ -119,7 +120,7 @@ void Formation_legionReturnHome(int formationId)
 {
 	const formation *m = formation_get(formationId);
 	Routing_getDistance(m->x_home, m->y_home);
-	if (Data_Grid_routingDistance[GridOffset(m->x, m->y)] <= 0) {
+	if (Routing_getCalculatedDistance(GridOffset(m->x, m->y)) <= 0) {
 		return; // unable to route home
 	}
 	if (m->cursed_by_mars) {
@@ -183,7 +184,7 @@ int Formation_getClosestMilitaryAcademy(int formationId)
 	int fortY = Data_Buildings[fortId].y;
 	int minBuildingId = 0;
 	int minDistance = 10000;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) &&
 			Data_Buildings[i].type == BUILDING_MILITARY_ACADEMY &&
 			Data_Buildings[i].numWorkers >= model_get_building(BUILDING_MILITARY_ACADEMY)->laborers) {
@@ -270,7 +271,7 @@ static void update_soldier_totals(const formation *m, void *data)
 void Formation_calculateFigures()
 {
     formation_clear_figures();
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		if (Data_Figures[i].state != FigureState_Alive) {
 			continue;
 		}
@@ -19,6 +19,7 @@
 #include "core/random.h"
 #include "figure/enemy_army.h"
 #include "figure/formation.h"
+#include "figure/live_list.h"
 
 static const int enemyAttackBuildingPriority[4][24] = {
 	{
@@ -139,7 +140,7 @@ static const int layoutOrientationLegionIndexOffsets[13][4][40] = {
 
 static void tickDecreaseLegionDamage()
 {
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	FOR_EACH_LIVE_FIGURE(i) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state == FigureState_Alive && FigureIsLegion(f->type)) {
 			if (f->actionState == FigureActionState_80_SoldierAtRest) {
@@ -270,7 +271,7 @@ static int getHighestRomanSoldierConcentration(int x, int y, int radius, int *xT
 	for (int yy = yMin; yy <= yMax; yy++) {
 		for (int xx = xMin; xx <= xMax; xx++) {
 			int gridOffset = GridOffset(xx, yy);
-			if (Data_Grid_routingDistance[gridOffset] > 0 &&
+			if (Routing_getCalculatedDistance(gridOffset) > 0 &&
 				Data_Grid_romanSoldierConcentration[gridOffset] > maxValue) {
 				maxValue = Data_Grid_romanSoldierConcentration[gridOffset];
 				maxX = xx;
@@ -290,7 +291,7 @@ static void setNativeTargetBuilding(int formationId)
 {
 	int minBuildingId = 0;
 	int minDistance = 10000;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -331,7 +332,7 @@ static void setEnemyTargetBuilding(const formation *m)
 	int bestTypeIndex = 100;
 	int buildingId = 0;
 	int minDistance = 10000;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || Data_Grid_romanSoldierConcentration[b->gridOffset]) {
 			continue;
@@ -353,7 +354,7 @@ static void setEnemyTargetBuilding(const formation *m)
 	}
 	if (buildingId <= 0) {
 		// no target buildings left: take rioter attack priority
-		for (int i = 1; i < MAX_BUILDINGS; i++) {
+		for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 			struct Data_Building *b = &Data_Buildings[i];
 			if (!BuildingIsInUse(i) || Data_Grid_romanSoldierConcentration[b->gridOffset]) {
 				continue;
@@ -406,7 +407,7 @@ static void marsKillEnemies()
 	}
 	int toKill = Data_CityInfo.godBlessingMarsEnemiesToKill;
 	int gridOffset = 0;
-	for (int i = 1; i < MAX_FIGURES && toKill > 0; i++) {
+	for (int i = 1; i < Data_Figure_Extra.capacity && toKill > 0; i++) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state != FigureState_Alive) {
 			continue;
@@ -827,7 +828,7 @@ int Formation_Rioter_getTargetBuilding(int *xTile, int *yTile)
 {
 	int bestTypeIndex = 100;
 	int buildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
@@ -1,5 +1,6 @@
 #include "Game.h"
 
+#include "GameTick.h"
 #include "Loader.h"
 #include "Settings.h"
 #include "Sound.h"
@@ -14,7 +15,10 @@
 
 #include "building/model.h"
 #include "core/debug.h"
+#include "core/jobs.h"
 #include "core/lang.h"
+#include "core/profiler.h"
+#include "core/trace.h"
 #include "core/random.h"
 #include "game/settings.h"
 #include "graphics/image.h"
@@ -71,15 +75,20 @@ int Game_init()
 	}
 
 	Sound_init();
+	jobs_start(0);
 	Loader_GameState_init();
+	GameTick_init();
 	UI_Window_goTo(Window_Logo);
 	return 1;
 }
 
 void Game_exit()
 {
+	profiler_finish();
+	trace_finish();
 	Video_shutdown();
 	settings_save();
 	Settings_save();
 	Sound_shutdown();
+	jobs_stop();
 }
@@ -2,6 +2,7 @@
 
 #include "Building.h"
 #include "CityView.h"
+#include "Desirability.h"
 #include "Empire.h"
 #include "Event.h"
 #include "Figure.h"
@@ -35,9 +36,11 @@
 #include "building/count.h"
 #include "building/list.h"
 #include "core/buffer.h"
+#include "core/calc.h"
 #include "core/file.h"
 #include "core/io.h"
 #include "core/random.h"
+#include "core/trace.h"
 #include "core/zip.h"
 #include "empire/trade_prices.h"
 #include "empire/trade_route.h"
@@ -45,6 +48,7 @@
 #include "figure/formation.h"
 #include "figure/name.h"
 #include "figure/trader.h"
+#include "game/tick_scheduler.h"
 #include "game/time.h"
 #include "graphics/image.h"
 
@@ -63,11 +67,31 @@ struct GameFilePart {
 	int lengthInBytes;
 };
 
+#define GRID_BYTES (GRID_SIZE * GRID_SIZE)
+#define GRID_SHORTS (2 * GRID_SIZE * GRID_SIZE)
+#define SCENARIO_GRID_BYTES (GRID_SIZE_LEGACY * GRID_SIZE_LEGACY)
+#define SCENARIO_GRID_SHORTS (2 * GRID_SIZE_LEGACY * GRID_SIZE_LEGACY)
+
 static const int savegameVersion = 0x66;
+// Flags added to the version of saves the original game cannot read.
+// Same layout, followed by the figures, buildings and routes that do not fit the original pieces:
+static const int savegameFlagExtendedLists = 0x100;
+// Grid size stored after the version, the grid pieces use that size:
+static const int savegameFlagGridSize = 0x200;
 
 static int savegameFileVersion;
 static char playerNames[2][32];
 
+// Extra records of a save with extended lists. They are read here with the other
+// pieces, so a save that cannot be read leaves the current game untouched.
+static struct {
+    int32_t capacities[3];
+    struct Data_Figure figures[MAX_FIGURES - MAX_FIGURES_LEGACY];
+    struct Data_Building buildings[MAX_BUILDINGS - MAX_BUILDINGS_LEGACY];
+    short routeFigureIds[MAX_ROUTES - MAX_ROUTES_LEGACY];
+    char routePaths[MAX_ROUTES - MAX_ROUTES_LEGACY][MAX_ROUTEPATH_LENGTH];
+} extendedLists;
+
 static char compressBuffer[COMPRESS_BUFFER_SIZE];
 
 static const char missionPackFile[] = "mission1.pak";
@@ -282,12 +306,12 @@ void init_scenario_data()
         return;
     }
     scenario_state *state = &scenario_data.state;
-    state->graphic_ids = create_scenario_piece(52488);
-    state->edge = create_scenario_piece(26244);
-    state->terrain = create_scenario_piece(52488);
-    state->bitfields = create_scenario_piece(26244);
-    state->random = create_scenario_piece(26244);
-    state->elevation = create_scenario_piece(26244);
+    state->graphic_ids = create_scenario_piece(SCENARIO_GRID_SHORTS);
+    state->edge = create_scenario_piece(SCENARIO_GRID_BYTES);
+    state->terrain = create_scenario_piece(SCENARIO_GRID_SHORTS);
+    state->bitfields = create_scenario_piece(SCENARIO_GRID_BYTES);
+    state->random = create_scenario_piece(SCENARIO_GRID_BYTES);
+    state->elevation = create_scenario_piece(SCENARIO_GRID_BYTES);
     state->random_iv = create_scenario_piece(8);
     state->camera = create_scenario_piece(8);
     state->scenario = create_scenario_piece(1720);
@@ -304,20 +328,20 @@ void init_savegame_data()
     savegame_state *state = &savegame_data.state;
     state->Data_Settings_saveGameMissionId = create_savegame_piece(4, 0);
     state->savegameFileVersion = create_savegame_piece(4, 0);
-    state->Data_Grid_graphicIds = create_savegame_piece(52488, 1);
-    state->Data_Grid_edge = create_savegame_piece(26244, 1);
-    state->Data_Grid_buildingIds = create_savegame_piece(52488, 1);
-    state->Data_Grid_terrain = create_savegame_piece(52488, 1);
-    state->Data_Grid_aqueducts = create_savegame_piece(26244, 1);
-    state->Data_Grid_figureIds = create_savegame_piece(52488, 1);
-    state->Data_Grid_bitfields = create_savegame_piece(26244, 1);
-    state->Data_Grid_spriteOffsets = create_savegame_piece(26244, 1);
-    state->Data_Grid_random = create_savegame_piece(26244, 0);
-    state->Data_Grid_desirability = create_savegame_piece(26244, 1);
-    state->Data_Grid_elevation = create_savegame_piece(26244, 1);
-    state->Data_Grid_buildingDamage = create_savegame_piece(26244, 1);
-    state->Data_Grid_Undo_aqueducts = create_savegame_piece(26244, 1);
-    state->Data_Grid_Undo_spriteOffsets = create_savegame_piece(26244, 1);
+    state->Data_Grid_graphicIds = create_savegame_piece(GRID_SHORTS, 1);
+    state->Data_Grid_edge = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_buildingIds = create_savegame_piece(GRID_SHORTS, 1);
+    state->Data_Grid_terrain = create_savegame_piece(GRID_SHORTS, 1);
+    state->Data_Grid_aqueducts = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_figureIds = create_savegame_piece(GRID_SHORTS, 1);
+    state->Data_Grid_bitfields = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_spriteOffsets = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_random = create_savegame_piece(GRID_BYTES, 0);
+    state->Data_Grid_desirability = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_elevation = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_buildingDamage = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_Undo_aqueducts = create_savegame_piece(GRID_BYTES, 1);
+    state->Data_Grid_Undo_spriteOffsets = create_savegame_piece(GRID_BYTES, 1);
     state->Data_Figures = create_savegame_piece(128000, 1);
     state->Data_Routes_figureIds = create_savegame_piece(1200, 1);
     state->Data_Routes_directionPaths = create_savegame_piece(300000, 1);
@@ -455,27 +479,53 @@ void write_all_to_buffer(buffer *buf, void *data)
     buffer_write_raw(buf, data, buf->size);
 }
 
+static void read_scenario_grid(buffer *buf, void *grid, int element_size, int shift_x, int shift_y)
+{
+    if (GRID_SIZE == GRID_SIZE_LEGACY) {
+        read_all_from_buffer(buf, grid);
+        return;
+    }
+    memset(grid, 0, GRID_SIZE * GRID_SIZE * element_size);
+    for (int y = 0; y < GRID_SIZE_LEGACY; y++) {
+        char *row = (char *) grid + ((y + shift_y) * GRID_SIZE + shift_x) * element_size;
+        buffer_read_raw(buf, row, GRID_SIZE_LEGACY * element_size);
+    }
+}
+
 void scenario_deserialize(scenario_state *file)
 {
-    read_all_from_buffer(file->graphic_ids, &Data_Grid_graphicIds);
-    read_all_from_buffer(file->edge, &Data_Grid_edge);
-    read_all_from_buffer(file->terrain, &Data_Grid_terrain);
-    read_all_from_buffer(file->bitfields, &Data_Grid_bitfields);
-    read_all_from_buffer(file->random, &Data_Grid_random);
-    read_all_from_buffer(file->elevation, &Data_Grid_elevation);
+    read_all_from_buffer(file->scenario, &Data_Scenario);
+
+    // scenario files use the original grid size: move the map to the centre of a larger grid
+    int shift_x = 0;
+    int shift_y = 0;
+    if (GRID_SIZE != GRID_SIZE_LEGACY) {
+        int x_legacy = Data_Scenario.gridFirstElement % GRID_SIZE_LEGACY;
+        int y_legacy = Data_Scenario.gridFirstElement / GRID_SIZE_LEGACY;
+        shift_x = calc_bound((GRID_SIZE - Data_Scenario.mapSizeX) / 2 - x_legacy, 0, GRID_SIZE - GRID_SIZE_LEGACY);
+        shift_y = calc_bound((GRID_SIZE - Data_Scenario.mapSizeY) / 2 - y_legacy, 0, GRID_SIZE - GRID_SIZE_LEGACY);
+        Data_Scenario.gridFirstElement = (y_legacy + shift_y) * GRID_SIZE + x_legacy + shift_x;
+        Data_Scenario.gridBorderSize = GRID_SIZE - Data_Scenario.mapSizeX;
+    }
+    read_scenario_grid(file->graphic_ids, &Data_Grid_graphicIds, 2, shift_x, shift_y);
+    read_scenario_grid(file->edge, &Data_Grid_edge, 1, shift_x, shift_y);
+    read_scenario_grid(file->terrain, &Data_Grid_terrain, 2, shift_x, shift_y);
+    read_scenario_grid(file->bitfields, &Data_Grid_bitfields, 1, shift_x, shift_y);
+    read_scenario_grid(file->random, &Data_Grid_random, 1, shift_x, shift_y);
+    read_scenario_grid(file->elevation, &Data_Grid_elevation, 1, shift_x, shift_y);
     
-    Data_Settings_Map.camera.x = buffer_read_i32(file->camera);
-    Data_Settings_Map.camera.y = buffer_read_i32(file->camera);
+    // the view grows by half the grid growth on both sides of the view centre
+    Data_Settings_Map.camera.x = buffer_read_i32(file->camera) +
+        (GRID_SIZE - GRID_SIZE_LEGACY + shift_x - shift_y) / 2;
+    Data_Settings_Map.camera.y = buffer_read_i32(file->camera) + shift_x + shift_y;
     
     random_load_state(file->random_iv);
-
-    read_all_from_buffer(file->scenario, &Data_Scenario);
     
     // check if all buffers are empty
     for (int i = 0; i < scenario_data.num_pieces; i++) {
         buffer *buf = &scenario_data.pieces[i].buf;
         if (buf->index != buf->size) {
-            printf("ERR: buffer %d not empty: %d of %d bytes used\n", i, buf->index, buf->size);
+            TRACE_ERROR(TRACE_EVENT_SAVEGAME_BUFFER_NOT_EMPTY, i, buf->index, buf->size, 0);
         }
     }
 }
@@ -635,7 +685,7 @@ static void savegame_deserialize(savegame_state *state)
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         buffer *buf = &savegame_data.pieces[i].buf;
         if (buf->index != buf->size) {
-            printf("ERR: buffer %d not empty: %d of %d bytes used\n", i, buf->index, buf->size);
+            TRACE_ERROR(TRACE_EVENT_SAVEGAME_BUFFER_NOT_EMPTY, i, buf->index, buf->size, 0);
         }
     }
 }
@@ -795,7 +845,7 @@ static void savegame_serialize(savegame_state *state)
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         buffer *buf = &savegame_data.pieces[i].buf;
         if (buf->index != buf->size) {
-            printf("ERR: buffer %d not empty: %d of %d bytes used\n", i, buf->index, buf->size);
+            TRACE_ERROR(TRACE_EVENT_SAVEGAME_BUFFER_NOT_EMPTY, i, buf->index, buf->size, 0);
         }
     }
 }
@@ -804,28 +854,171 @@ static void setupFromSavedGame();
 static int writeCompressedChunk(FILE *fp, const void *buffer, int bytesToWrite);
 static int readCompressedChunk(FILE *fp, void *buffer, int bytesToRead);
 
-static void savegame_read_from_file(FILE *fp)
+static int has_data_past_legacy_lists()
+{
+    for (int i = MAX_FIGURES_LEGACY; i < Data_Figure_Extra.capacity; i++) {
+        if (Data_Figures[i].state) {
+            return 1;
+        }
+    }
+    for (int i = MAX_BUILDINGS_LEGACY; i < Data_Buildings_Extra.capacity; i++) {
+        if (Data_Buildings[i].state != BuildingState_Unused) {
+            return 1;
+        }
+    }
+    for (int i = MAX_ROUTES_LEGACY; i < Data_Routes.capacity; i++) {
+        if (Data_Routes.figureIds[i]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void write_blocks(FILE *fp, const void *data, int size, int block_size)
+{
+    for (int offset = 0; offset < size; offset += block_size) {
+        writeCompressedChunk(fp, (const char *) data + offset, block_size);
+    }
+}
+
+static int read_blocks(FILE *fp, void *data, int size, int block_size)
+{
+    for (int offset = 0; offset < size; offset += block_size) {
+        if (!readCompressedChunk(fp, (char *) data + offset, block_size)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int is_valid_capacity(int capacity, int legacy, int max)
+{
+    return capacity >= legacy && capacity <= max && capacity % legacy == 0;
+}
+
+static void savegame_write_extended_lists(FILE *fp)
+{
+    int32_t capacities[3] = {
+        Data_Figure_Extra.capacity, Data_Buildings_Extra.capacity, Data_Routes.capacity
+    };
+    fwrite(capacities, 4, 3, fp);
+    write_blocks(fp, &Data_Figures[MAX_FIGURES_LEGACY],
+        (capacities[0] - MAX_FIGURES_LEGACY) * sizeof(struct Data_Figure),
+        MAX_FIGURES_LEGACY * sizeof(struct Data_Figure));
+    write_blocks(fp, &Data_Buildings[MAX_BUILDINGS_LEGACY],
+        (capacities[1] - MAX_BUILDINGS_LEGACY) * sizeof(struct Data_Building),
+        MAX_BUILDINGS_LEGACY * sizeof(struct Data_Building));
+    write_blocks(fp, &Data_Routes.figureIds[MAX_ROUTES_LEGACY],
+        (capacities[2] - MAX_ROUTES_LEGACY) * sizeof(short),
+        MAX_ROUTES_LEGACY * sizeof(short));
+    write_blocks(fp, Data_Routes.directionPaths[MAX_ROUTES_LEGACY],
+        (capacities[2] - MAX_ROUTES_LEGACY) * MAX_ROUTEPATH_LENGTH,
+        MAX_ROUTES_LEGACY * MAX_ROUTEPATH_LENGTH);
+}
+
+static int savegame_read_extended_lists(FILE *fp, int fileVersion)
+{
+    int32_t *capacities = extendedLists.capacities;
+    capacities[0] = MAX_FIGURES_LEGACY;
+    capacities[1] = MAX_BUILDINGS_LEGACY;
+    capacities[2] = MAX_ROUTES_LEGACY;
+    if (!(fileVersion & savegameFlagExtendedLists)) {
+        return 1;
+    }
+    if (fread(capacities, 4, 3, fp) != 3 ||
+        !is_valid_capacity(capacities[0], MAX_FIGURES_LEGACY, MAX_FIGURES) ||
+        !is_valid_capacity(capacities[1], MAX_BUILDINGS_LEGACY, MAX_BUILDINGS) ||
+        !is_valid_capacity(capacities[2], MAX_ROUTES_LEGACY, MAX_ROUTES)) {
+        return 0;
+    }
+    return read_blocks(fp, extendedLists.figures,
+        (capacities[0] - MAX_FIGURES_LEGACY) * sizeof(struct Data_Figure),
+        MAX_FIGURES_LEGACY * sizeof(struct Data_Figure)) &&
+        read_blocks(fp, extendedLists.buildings,
+        (capacities[1] - MAX_BUILDINGS_LEGACY) * sizeof(struct Data_Building),
+        MAX_BUILDINGS_LEGACY * sizeof(struct Data_Building)) &&
+        read_blocks(fp, extendedLists.routeFigureIds,
+        (capacities[2] - MAX_ROUTES_LEGACY) * sizeof(short),
+        MAX_ROUTES_LEGACY * sizeof(short)) &&
+        read_blocks(fp, extendedLists.routePaths,
+        (capacities[2] - MAX_ROUTES_LEGACY) * MAX_ROUTEPATH_LENGTH,
+        MAX_ROUTES_LEGACY * MAX_ROUTEPATH_LENGTH);
+}
+
+static void savegame_load_extended_lists()
+{
+    const int32_t *capacities = extendedLists.capacities;
+    int figures = capacities[0] - MAX_FIGURES_LEGACY;
+    int buildings = capacities[1] - MAX_BUILDINGS_LEGACY;
+    int routes = capacities[2] - MAX_ROUTES_LEGACY;
+    memcpy(&Data_Figures[MAX_FIGURES_LEGACY], extendedLists.figures,
+        figures * sizeof(struct Data_Figure));
+    memset(&Data_Figures[capacities[0]], 0,
+        (MAX_FIGURES - capacities[0]) * sizeof(struct Data_Figure));
+    memcpy(&Data_Buildings[MAX_BUILDINGS_LEGACY], extendedLists.buildings,
+        buildings * sizeof(struct Data_Building));
+    memset(&Data_Buildings[capacities[1]], 0,
+        (MAX_BUILDINGS - capacities[1]) * sizeof(struct Data_Building));
+    memcpy(&Data_Routes.figureIds[MAX_ROUTES_LEGACY], extendedLists.routeFigureIds,
+        routes * sizeof(short));
+    memset(&Data_Routes.figureIds[capacities[2]], 0,
+        (MAX_ROUTES - capacities[2]) * sizeof(short));
+    memcpy(Data_Routes.directionPaths[MAX_ROUTES_LEGACY], extendedLists.routePaths,
+        routes * MAX_ROUTEPATH_LENGTH);
+    memset(Data_Routes.directionPaths[capacities[2]], 0,
+        (MAX_ROUTES - capacities[2]) * MAX_ROUTEPATH_LENGTH);
+    Data_Figure_Extra.capacity = capacities[0];
+    Data_Buildings_Extra.capacity = capacities[1];
+    Data_Routes.capacity = capacities[2];
+}
+
+static int savegame_read_grid_size(FILE *fp, int fileVersion)
 {
+    int32_t gridSize = GRID_SIZE_LEGACY;
+    if ((fileVersion & savegameFlagGridSize) && fread(&gridSize, 4, 1, fp) != 1) {
+        return 0;
+    }
+    // grid offsets are stored throughout the save, so the grid cannot be resized on load
+    return gridSize == GRID_SIZE;
+}
+
+static int savegame_read_from_file(FILE *fp)
+{
+    int fileVersion = 0;
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
+        TRACE_DEBUG(TRACE_EVENT_SAVEGAME_READ_PIECE, i, piece->buf.size, piece->compressed, 0);
         if (piece->compressed) {
             readCompressedChunk(fp, piece->buf.data, piece->buf.size);
         } else {
             fread(piece->buf.data, 1, piece->buf.size, fp);
         }
+        if (&piece->buf == savegame_data.state.savegameFileVersion) {
+            fileVersion = buffer_read_i32(&piece->buf);
+            buffer_reset(&piece->buf);
+            if (!savegame_read_grid_size(fp, fileVersion)) {
+                return 0;
+            }
+        }
     }
+    return savegame_read_extended_lists(fp, fileVersion);
 }
 
 static void savegame_write_to_file(FILE *fp)
 {
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
-        printf("Writing piece %d (size %d)\n", i, piece->buf.size);
+        TRACE_DEBUG(TRACE_EVENT_SAVEGAME_WRITE_PIECE, i, piece->buf.size, piece->compressed, 0);
         if (piece->compressed) {
             writeCompressedChunk(fp, piece->buf.data, piece->buf.size);
         } else {
             fwrite(piece->buf.data, 1, piece->buf.size, fp);
         }
+        if (&piece->buf == savegame_data.state.savegameFileVersion &&
+            (savegameFileVersion & savegameFlagGridSize)) {
+            int32_t gridSize = GRID_SIZE;
+            fwrite(&gridSize, 4, 1, fp);
+        }
     }
 }
 
@@ -837,10 +1030,13 @@ int GameFile_loadSavedGame(const char *filename)
 		return 0;
 	}
 	Sound_stopMusic();
-    savegame_read_from_file(fp);
+    int ok = savegame_read_from_file(fp);
 	fclose(fp);
-    
+	if (!ok) {
+		return 0;
+	}
     savegame_deserialize(&savegame_data.state);
+    savegame_load_extended_lists();
 	
 	setupFromSavedGame();
 	BuildingStorage_resetBuildingIds();
@@ -863,10 +1059,13 @@ int GameFile_loadSavedGameFromMissionPack(int missionId)
 		return 0;
 	}
 	fseek(fp, offset, SEEK_SET);
-    savegame_read_from_file(fp);
+    int ok = savegame_read_from_file(fp);
 	fclose(fp);
-
+	if (!ok) {
+		return 0;
+	}
     savegame_deserialize(&savegame_data.state);
+    savegame_load_extended_lists();
 
     setupFromSavedGame();
 	return 1;
@@ -875,14 +1074,14 @@ int GameFile_loadSavedGameFromMissionPack(int missionId)
 static void debug()
 {/*
 	printf("TIME: y %d m %d d %d t %d\n", game_time_year(), game_time_month(), game_time_day(), game_time_tick());
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (b->state != BuildingState_Unused || b->type) {
 			printf("Building %d type %d inUse %d x %d y %d emp %d w %d ls %d hc %d\n",
 				i, b->type, b->state, b->x, b->y, b->numWorkers, b->figureId, b->figureId2, b->housesCovered);
 		}
 	}
-	for (int i = 1; i < MAX_FIGURES; i++) {
+	for (int i = 1; i < Data_Figure_Extra.capacity; i++) {
 		struct Data_Figure *f = &Data_Figures[i];
 		if (f->state == FigureState_Alive) {
 			printf("Figure %d type %d as %d wt %d mt %d\n",
@@ -913,6 +1112,11 @@ static void setupFromSavedGame()
 	CityView_calculateLookup();
 	CityView_checkCameraBoundaries();
 
+	Building_rebuildIndex();
+	Figure_rebuildIndex();
+	Figure_initServiceCoverage();
+	tick_scheduler_reset();
+	Desirability_invalidate();
 	Routing_clearLandTypeCitizen();
 	Routing_determineLandCitizen();
 	Routing_determineLandNonCitizen();
@@ -921,6 +1125,8 @@ static void setupFromSavedGame()
 
 	Building_determineGraphicIdsForOrientedBuildings();
 	FigureRoute_clean();
+	FigureRoute_clearCache();
+	UtilityManagement_clearRoadNetworks();
 	UtilityManagement_determineRoadNetworks();
 	Building_GameTick_checkAccessToRome();
 	Resource_gatherGranaryGettingInfo();
@@ -969,7 +1175,14 @@ int GameFile_writeSavedGame(const char *filename)
 {
     init_savegame_data();
 	printf("GameFile: Saving game to %s\n", filename);
+	int extendedLists = has_data_past_legacy_lists();
 	savegameFileVersion = savegameVersion;
+	if (extendedLists) {
+		savegameFileVersion |= savegameFlagExtendedLists;
+	}
+	if (GRID_SIZE != GRID_SIZE_LEGACY) {
+		savegameFileVersion |= savegameFlagGridSize;
+	}
 	strcpy(playerNames[1], (char*)Data_Settings.playerName);
     savegame_serialize(&savegame_data.state);
 
@@ -978,6 +1191,9 @@ int GameFile_writeSavedGame(const char *filename)
 		return 0;
 	}
 	savegame_write_to_file(fp);
+	if (extendedLists) {
+		savegame_write_extended_lists(fp);
+	}
 	fclose(fp);
 	return 1;
 }
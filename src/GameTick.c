@@ -15,6 +15,7 @@
 #include "PlayerMessage.h"
 #include "Resource.h"
 #include "Routing.h"
+#include "Runner.h"
 #include "Security.h"
 #include "SidebarMenu.h"
 #include "Sound.h"
@@ -27,97 +28,218 @@
 #include "UI/Sidebar.h"
 #include "UI/Window.h"
 
+#include "Data/Building.h"
 #include "Data/CityInfo.h"
 #include "Data/Settings.h"
 #include "Data/State.h"
 
+#include "core/profiler.h"
 #include "core/random.h"
+#include "core/trace.h"
 #include "game/settings.h"
+#include "game/tick_scheduler.h"
 #include "game/time.h"
 
 #include <stdio.h>
 
+// Profiler sections after the sections of the tick slots, in section order
+#define PROFILER_SECTIONS(SECTION) \
+	SECTION(ProfilerSection_Day, "advanceDay") \
+	SECTION(ProfilerSection_Month, "advanceMonth") \
+	SECTION(ProfilerSection_Year, "advanceYear") \
+	SECTION(ProfilerSection_Figures, "FigureAction_handle") \
+	SECTION(ProfilerSection_Tick, "GameTick_doTick")
+
+#define PROFILER_SECTION_ID(id, name) id,
+#define PROFILER_SECTION_NAME(id, name) name,
+
+enum {
+	ProfilerSection_LastSlot = TICK_SCHEDULER_TICKS_PER_DAY - 1,
+	PROFILER_SECTIONS(PROFILER_SECTION_ID)
+	ProfilerSection_Max
+};
+
+static const char *profilerSectionNames[] = {
+	PROFILER_SECTIONS(PROFILER_SECTION_NAME)
+};
+
+// Names of the tick slot sections: "<slot> <task name>", filled in from the task table
+static char profilerSlotNames[TICK_SCHEDULER_TICKS_PER_DAY][64];
+
 static void advanceDay();
 static void advanceMonth();
 static void advanceYear();
 
+static void requestMinimapRefresh(int param)
+{
+	UI_Sidebar_requestMinimapRefresh();
+}
+
+static void updateMinimap()
+{
+	Runner_callUi(requestMinimapRefresh, 0, 0);
+}
+
+static void updateGodMoods()
+{
+	CityInfo_Gods_calculateMoods(1);
+}
+
+static void updateFormations()
+{
+	Formation_Tick_updateAll(0);
+}
+
+static void updateFormationsSecondTime()
+{
+	Formation_Tick_updateAll(1);
+}
+
+static void updateBuildingCountsAndCoverage()
+{
+	CityInfo_Tick_countBuildingTypes();
+	CityInfo_Culture_updateCoveragePercentages();
+}
+
+static int numBuildings()
+{
+	return Data_Buildings_Extra.capacity;
+}
+
+static int numBuildingsInUse()
+{
+	return Data_Buildings_Extra.highestBuildingIdInUse + 1;
+}
+
+#define PASS(slot, run) { #run, TICK_SCHEDULER_TICKS_PER_DAY, slot, run, 0, 0, 0, 0 }
+#define BUILDING_PASS(slot, begin, update, end, count) \
+	{ #update, TICK_SCHEDULER_TICKS_PER_DAY, slot, 0, begin, update, end, count }
+
+// City updates in the order of the original game; the tick slots
+// 0, 9, 11, 13, 14, 15, 26, 41, 42 and 47 are empty.
+// Passes 28, 36 and 37 split their work over the job system, see their read and write sets
+static const tick_task tasks[] = {
+	PASS(1, updateGodMoods),
+	PASS(2, Sound_Music_update),
+	PASS(3, updateMinimap),
+	PASS(4, Event_Caesar_update),
+	PASS(5, updateFormations),
+	PASS(6, Natives_checkLand),
+	PASS(7, UtilityManagement_determineRoadNetworks),
+	PASS(8, Resource_gatherGranaryGettingInfo),
+	PASS(10, Building_updateHighestIds),
+	PASS(12, Building_decayHousesCovered),
+	PASS(16, Resource_calculateWarehouseStocks),
+	PASS(17, CityInfo_Resource_calculateFoodAndSupplyRomeWheat),
+	PASS(18, Resource_calculateWorkshopStocks),
+	PASS(19, BUILDING_DOCK_updateOpenWaterAccess),
+	BUILDING_PASS(20, 0, Building_Industry_updateProduction, 0, numBuildings),
+	PASS(21, Building_GameTick_checkAccessToRome),
+	PASS(22, HousePopulation_updateRoom),
+	PASS(23, HousePopulation_updateMigration),
+	PASS(24, HousePopulation_evictOvercrowded),
+	PASS(25, CityInfo_Labor_update),
+	PASS(27, UtilityManagement_updateReservoirFountain),
+	PASS(28, UtilityManagement_updateHouseWaterAccess),
+	PASS(29, updateFormationsSecondTime),
+	PASS(30, updateMinimap),
+	PASS(31, FigureGeneration_generateFiguresForBuildings),
+	PASS(32, Trader_tick),
+	PASS(33, updateBuildingCountsAndCoverage),
+	PASS(34, CityInfo_Tick_distributeTreasuryOverForumsAndSenates),
+	BUILDING_PASS(35, 0, HouseEvolution_Tick_decayCultureService, 0, numBuildings),
+	PASS(36, HouseEvolution_Tick_calculateCultureServiceAggregates),
+	PASS(37, Desirability_update),
+	PASS(38, Building_setDesirability),
+	BUILDING_PASS(39, HouseEvolution_Tick_beginEvolve, HouseEvolution_Tick_evolveAndConsumeResources,
+		HouseEvolution_Tick_endEvolve, numBuildings),
+	PASS(40, Building_GameTick_updateState),
+	PASS(43, Security_Tick_updateBurningRuins),
+	BUILDING_PASS(44, Security_Tick_beginFireCollapse, Security_Tick_checkFireCollapse,
+		Security_Tick_endFireCollapse, numBuildingsInUse),
+	PASS(45, Security_Tick_generateCriminal),
+	PASS(46, Building_Industry_updateDoubleWheatProduction),
+	PASS(48, CityInfo_Finance_decayTaxCollectorAccess),
+	PASS(49, CityInfo_Culture_calculateEntertainment),
+};
+
+void GameTick_init()
+{
+	tick_scheduler_clear();
+	for (int i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++) {
+		tick_scheduler_add(&tasks[i]);
+	}
+}
+
+void GameTick_setSpreadUpdates(int spread)
+{
+	tick_scheduler_set_mode(spread ? TICK_SCHEDULER_SPREAD : TICK_SCHEDULER_COMPATIBLE);
+}
+
+void GameTick_enableProfiler(const char *csvFilename)
+{
+	for (int slot = 0; slot < TICK_SCHEDULER_TICKS_PER_DAY; slot++) {
+		snprintf(profilerSlotNames[slot], sizeof(profilerSlotNames[slot]), "%d (noop)", slot);
+	}
+	for (int i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++) {
+		snprintf(profilerSlotNames[tasks[i].slot], sizeof(profilerSlotNames[0]), "%d %s", tasks[i].slot, tasks[i].name);
+	}
+	for (int slot = 0; slot < TICK_SCHEDULER_TICKS_PER_DAY; slot++) {
+		profiler_set_name(slot, profilerSlotNames[slot]);
+	}
+	for (int section = ProfilerSection_LastSlot + 1; section < ProfilerSection_Max; section++) {
+		profiler_set_name(section, profilerSectionNames[section - ProfilerSection_LastSlot - 1]);
+	}
+	profiler_enable(csvFilename);
+}
+
 void GameTick_doTick()
 {
-	printf("TICK %d.%d.%d\n", game_time_month(), game_time_day(), game_time_tick());
+	TRACE_INFO(TRACE_EVENT_TICK, game_time_month(), game_time_day(), game_time_tick(), 0);
+	uint64_t tickStart = profiler_start();
 	random_generate_next();
 	Undo_updateAvailable();
 	GameTick_advance();
+	uint64_t figuresStart = profiler_start();
 	FigureAction_handle();
+	profiler_stop(ProfilerSection_Figures, figuresStart);
 	Event_handleEarthquake();
 	Event_handleGladiatorRevolt();
 	Event_handleEmperorChange();
 	CityInfo_Victory_check();
+	profiler_stop(ProfilerSection_Tick, tickStart);
 }
 
 void GameTick_advance()
 {
-	// NB: these ticks are noop:
-	// 0, 9, 11, 13, 14, 15, 26, 41, 42, 47
-	switch (game_time_tick()) {
-		case 1: CityInfo_Gods_calculateMoods(1); break;
-		case 2: Sound_Music_update(); break;
-		case 3: UI_Sidebar_requestMinimapRefresh(); break;
-		case 4: Event_Caesar_update(); break;
-		case 5: Formation_Tick_updateAll(0); break;
-		case 6: Natives_checkLand(); break;
-		case 7: UtilityManagement_determineRoadNetworks(); break;
-		case 8: Resource_gatherGranaryGettingInfo(); break;
-		case 10: Building_updateHighestIds(); break;
-		case 12: Building_decayHousesCovered(); break;
-		case 16: Resource_calculateWarehouseStocks(); break;
-		case 17: CityInfo_Resource_calculateFoodAndSupplyRomeWheat(); break;
-		case 18: Resource_calculateWorkshopStocks(); break;
-		case 19: BUILDING_DOCK_updateOpenWaterAccess(); break;
-		case 20: Building_Industry_updateProduction(); break;
-		case 21: Building_GameTick_checkAccessToRome(); break;
-		case 22: HousePopulation_updateRoom(); break;
-		case 23: HousePopulation_updateMigration(); break;
-		case 24: HousePopulation_evictOvercrowded(); break;
-		case 25: CityInfo_Labor_update(); break;
-		case 27: UtilityManagement_updateReservoirFountain(); break;
-		case 28: UtilityManagement_updateHouseWaterAccess(); break;
-		case 29: Formation_Tick_updateAll(1); break;
-		case 30: UI_Sidebar_requestMinimapRefresh(); break;
-		case 31: FigureGeneration_generateFiguresForBuildings(); break;
-		case 32: Trader_tick(); break;
-		case 33: CityInfo_Tick_countBuildingTypes(); CityInfo_Culture_updateCoveragePercentages(); break;
-		case 34: CityInfo_Tick_distributeTreasuryOverForumsAndSenates(); break;
-		case 35: HouseEvolution_Tick_decayCultureService(); break;
-		case 36: HouseEvolution_Tick_calculateCultureServiceAggregates(); break;
-		case 37: Desirability_update(); break;
-		case 38: Building_setDesirability(); break;
-		case 39: HouseEvolution_Tick_evolveAndConsumeResources(); break;
-		case 40: Building_GameTick_updateState(); break;
-		case 43: Security_Tick_updateBurningRuins(); break;
-		case 44: Security_Tick_checkFireCollapse(); break;
-		case 45: Security_Tick_generateCriminal(); break;
-		case 46: Building_Industry_updateDoubleWheatProduction(); break;
-		case 48: CityInfo_Finance_decayTaxCollectorAccess(); break;
-		case 49: CityInfo_Culture_calculateEntertainment(); break;
-	}
+	int tick = game_time_tick();
+	uint64_t start = profiler_start();
+	tick_scheduler_run(tick);
+	profiler_stop(tick, start);
 	if (game_time_advance_tick()) {
 		advanceDay();
 	}
 }
 
+// The day and month sections do not include the time of the sections nested in them
 static void advanceDay()
 {
+	uint64_t start = profiler_start();
 	if (game_time_advance_day()) {
+		uint64_t monthStart = profiler_start();
 		advanceMonth();
+		start += profiler_start() - monthStart;
 	}
 	if (game_time_day() == 0 || game_time_day() == 8) {
 		CityInfo_Population_calculateSentiment();
 	}
 	Tutorial_onDayTick();
+	profiler_stop(ProfilerSection_Day, start);
 }
 
 static void advanceMonth()
 {
+	uint64_t start = profiler_start();
 	Data_CityInfo.populationNewcomersThisMonth = 0;
 	Data_CityInfo.monthsSinceFestival++;
 
@@ -140,7 +262,9 @@ static void advanceMonth()
 	PlayerMessage_sortMessages();
 
 	if (game_time_advance_month()) {
+		uint64_t yearStart = profiler_start();
 		advanceYear();
+		start += profiler_start() - yearStart;
 	} else {
 		CityInfo_Ratings_calculate(0);
 	}
@@ -151,10 +275,12 @@ static void advanceMonth()
 	if (setting_monthly_autosave()) {
 		GameFile_writeSavedGame("last.sav");
 	}
+	profiler_stop(ProfilerSection_Month, start);
 }
 
 static void advanceYear()
 {
+	uint64_t start = profiler_start();
 	Empire_handleExpandEvent();
 	Data_State.undoAvailable = 0;
 	game_time_advance_year();
@@ -164,4 +290,5 @@ static void advanceYear()
 	Security_Tick_updateFireSpreadDirection();
 	CityInfo_Ratings_calculate(1);
 	Data_CityInfo.godBlessingNeptuneDoubleTrade = 0;
+	profiler_stop(ProfilerSection_Year, start);
 }
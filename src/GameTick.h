@@ -1,6 +1,13 @@
 #ifndef GAMETICK_H
 #define GAMETICK_H
 
+void GameTick_init();
+
+// spread the building passes over the ticks of a day instead of running them on one tick
+void GameTick_setSpreadUpdates(int spread);
+
+void GameTick_enableProfiler(const char *csvFilename);
+
 void GameTick_doTick();
 
 void GameTick_advance();
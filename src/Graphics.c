@@ -5,6 +5,7 @@
 #include "Data/Screen.h"
 #include "Data/Constants.h"
 
+#include "core/trace.h"
 #include "graphics/image.h"
 
 #include <stdio.h> // remove later
@@ -165,7 +166,7 @@ void Graphics_drawIsometricFootprint(int graphicId, int xOffset, int yOffset, co
 				break;
 		}
 	} else {
-		printf("ERROR: %d trying to draw a non-isometric tile using drawIsometricFootprint\n", graphicId);
+		TRACE_ERROR(TRACE_EVENT_IMAGE_NOT_ISOMETRIC, graphicId, 0, 0, 0);
 	}
 }
 
@@ -173,7 +174,7 @@ void Graphics_drawIsometricTop(int graphicId, int xOffset, int yOffset, color_t
 {
 	const image *img = image_get(graphicId);
 	if (img->draw.type != 30) { // isometric
-		printf("ERROR: %d trying to draw a non-isometric tile using drawIsometricTop\n", graphicId);
+		TRACE_ERROR(TRACE_EVENT_IMAGE_NOT_ISOMETRIC, graphicId, 0, 0, 0);
 		return;
 	}
 	if (!img->draw.has_compressed_part) {
@@ -247,7 +248,7 @@ void Graphics_drawImageMasked(int graphicId, int xOffset, int yOffset, color_t c
 	}
 
 	if (img->draw.type == 30) { // isometric
-		printf("ERROR: use Graphics_drawIsometricFootprint for isometric!\n");
+		TRACE_ERROR(TRACE_EVENT_IMAGE_IS_ISOMETRIC, graphicId, 0, 0, 0);
 		return;
 	}
 
@@ -272,7 +273,7 @@ void Graphics_drawImageBlend(int graphicId, int xOffset, int yOffset, color_t co
 	}
 
 	if (img->draw.type == 30) { // isometric
-		printf("ERROR: use Graphics_drawIsometricFootprint for isometric!\n");
+		TRACE_ERROR(TRACE_EVENT_IMAGE_IS_ISOMETRIC, graphicId, 0, 0, 0);
 		return;
 	}
 
@@ -556,11 +557,11 @@ void Graphics_setClipRectangle(int x, int y, int width, int height)
 	clipRectangle.yStart = y;
 	clipRectangle.yEnd = y + height;
 	if (clipRectangle.xEnd > Data_Screen.width) {
-		printf("ERROR: clip rectangle x end (%d) > screen width\n", clipRectangle.xEnd);
+		TRACE_ERROR(TRACE_EVENT_CLIP_OUTSIDE_SCREEN, x + width, y + height, Data_Screen.width, Data_Screen.height);
 		clipRectangle.xEnd = Data_Screen.width;
 	}
 	if (clipRectangle.yEnd > Data_Screen.height) {
-		printf("ERROR: clip rectangle y end (%d) > screen height\n", clipRectangle.yEnd);
+		TRACE_ERROR(TRACE_EVENT_CLIP_OUTSIDE_SCREEN, x + width, y + height, Data_Screen.width, Data_Screen.height);
 		clipRectangle.yEnd = Data_Screen.height-15;
 	}
 }
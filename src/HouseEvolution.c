@@ -8,6 +8,7 @@
 #include "Data/Constants.h"
 
 #include "building/model.h"
+#include "core/jobs.h"
 #include "game/time.h"
 
 static int checkEvolveDesirability(int buildingId);
@@ -288,20 +289,33 @@ static void (*const callbacks[])(int, int*) = {
 	evolveSmallVilla, evolveMediumVilla, evolveLargeVilla, evolveGrandVilla,
 	evolveSmallPalace, evolveMediumPalace, evolveLargePalace, evolveLuxuryPalace
 };
-void HouseEvolution_Tick_evolveAndConsumeResources()
+// state of the evolve pass over all houses
+static struct {
+	int hasExpanded;
+	int consumeResources;
+} evolve;
+
+void HouseEvolution_Tick_beginEvolve()
 {
 	resetCityInfoServiceRequiredCounters();
-	int hasExpanded = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (BuildingIsInUse(i) && BuildingIsHouse(Data_Buildings[i].type)) {
-			BuildingHouse_checkForCorruption(i);
-			(*callbacks[Data_Buildings[i].type - 10])(i, &hasExpanded);
-			if (game_time_day() == 0 || game_time_day() == 7) {
-				consumeResources(i);
-			}
+	evolve.hasExpanded = 0;
+	evolve.consumeResources = game_time_day() == 0 || game_time_day() == 7;
+}
+
+void HouseEvolution_Tick_evolveAndConsumeResources(int buildingId)
+{
+	if (BuildingIsInUse(buildingId) && BuildingIsHouse(Data_Buildings[buildingId].type)) {
+		BuildingHouse_checkForCorruption(buildingId);
+		(*callbacks[Data_Buildings[buildingId].type - 10])(buildingId, &evolve.hasExpanded);
+		if (evolve.consumeResources) {
+			consumeResources(buildingId);
 		}
 	}
-	if (hasExpanded) {
+}
+
+void HouseEvolution_Tick_endEvolve()
+{
+	if (evolve.hasExpanded) {
 		Routing_determineLandCitizen();
 		Routing_determineLandNonCitizen();
 	}
@@ -519,16 +533,13 @@ static void resetCityInfoServiceRequiredCounters()
 }
 
 #define DECAY(svc) \
-	if (Data_Buildings[i].data.house.svc > 0) \
-		--Data_Buildings[i].data.house.svc; \
-	else Data_Buildings[i].data.house.svc = 0
+	if (Data_Buildings[buildingId].data.house.svc > 0) \
+		--Data_Buildings[buildingId].data.house.svc; \
+	else Data_Buildings[buildingId].data.house.svc = 0
 
-void HouseEvolution_Tick_decayCultureService()
+void HouseEvolution_Tick_decayCultureService(int buildingId)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (!BuildingIsInUse(i) || !Data_Buildings[i].houseSize) {
-			continue;
-		}
+	if (BuildingIsInUse(buildingId) && Data_Buildings[buildingId].houseSize) {
 		DECAY(theater);
 		DECAY(amphitheaterActor);
 		DECAY(amphitheaterGladiator);
@@ -550,9 +561,10 @@ void HouseEvolution_Tick_decayCultureService()
 	}
 }
 
-void HouseEvolution_Tick_calculateCultureServiceAggregates()
+// Each house only writes its own aggregates: ranges of houses run on the job system
+static void calculateCultureServiceAggregates(int firstBuildingId, int endBuildingId, void *unused)
 {
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = firstBuildingId; i < endBuildingId; i++) {
 		if (!BuildingIsInUse(i) || !Data_Buildings[i].houseSize) {
 			continue;
 		}
@@ -628,6 +640,11 @@ void HouseEvolution_Tick_calculateCultureServiceAggregates()
 	}
 }
 
+void HouseEvolution_Tick_calculateCultureServiceAggregates()
+{
+	jobs_parallel_for(1, Data_Buildings_Extra.capacity, 256, calculateCultureServiceAggregates, 0);
+}
+
 void HouseEvolution_determineEvolveText(int buildingId, int hasBadDesirabilityBuilding)
 {
 	struct Data_Building *b = &Data_Buildings[buildingId];
@@ -1,10 +1,16 @@
 #ifndef HOUSEEVOLUTION_H
 #define HOUSEEVOLUTION_H
 
-void HouseEvolution_Tick_evolveAndConsumeResources();
+// evolve pass: begin, then evolve each house, then end
+void HouseEvolution_Tick_beginEvolve();
+void HouseEvolution_Tick_evolveAndConsumeResources(int buildingId);
+void HouseEvolution_Tick_endEvolve();
 
-void HouseEvolution_Tick_decayCultureService();
+void HouseEvolution_Tick_decayCultureService(int buildingId);
 
+// Reads: culture coverage, house culture services
+// Writes: house entertainment, education, health and numGods
+// Houses are updated on the job system, no random numbers are drawn
 void HouseEvolution_Tick_calculateCultureServiceAggregates();
 
 void HouseEvolution_determineEvolveText(int buildingId, int hasBadDesirabilityBuilding);
@@ -13,6 +13,7 @@
 
 #include "building/list.h"
 #include "building/model.h"
+#include "building/spatial.h"
 #include "figure/type.h"
 
 static void calculateWorkers();
@@ -24,7 +25,7 @@ static void createEmigrantForBuilding(int buildingId, int numPeople);
 static void fillBuildingListHouses()
 {
     building_list_large_clear(0);
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
+    for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
         if (BuildingIsInUse(i) && Data_Buildings[i].houseSize) {
             building_list_large_add(i);
         }
@@ -273,31 +274,39 @@ static void createEmigrantForBuilding(int buildingId, int numPeople)
 	Data_Figures[figureId].migrantNumPeople = numPeople;
 }
 
-int HousePopulation_getClosestHouseWithRoom(int x, int y)
+struct HouseQuery {
+	int x;
+	int y;
+};
+
+static int houseWithRoomDistance(int buildingId, void *data)
 {
-	int minDist = 1000;
-	int minBuildingId = 0;
-	for (int i = 1; i <= Data_Buildings_Extra.highestBuildingIdInUse; i++) {
-		struct Data_Building *b = &Data_Buildings[i];
-		if (BuildingIsInUse(i) && b->houseSize && b->distanceFromEntry > 0 && b->housePopulationRoom > 0) {
-			if (!b->immigrantFigureId) {
-				int dist = calc_maximum_distance(x, y, b->x, b->y);
-				if (dist < minDist) {
-					minDist = dist;
-					minBuildingId = i;
-				}
-			}
+	struct HouseQuery *query = (struct HouseQuery*) data;
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (buildingId > Data_Buildings_Extra.highestBuildingIdInUse) {
+		return -1;
+	}
+	if (BuildingIsInUse(buildingId) && b->houseSize && b->distanceFromEntry > 0 && b->housePopulationRoom > 0) {
+		if (!b->immigrantFigureId) {
+			return calc_maximum_distance(query->x, query->y, b->x, b->y);
 		}
 	}
-	return minBuildingId;
+	return -1;
+}
+
+int HousePopulation_getClosestHouseWithRoom(int x, int y)
+{
+	struct HouseQuery query = {x, y};
+	return building_spatial_find_nearest(BUILDING_HOUSE_VACANT_LOT, BUILDING_HOUSE_LUXURY_PALACE,
+		x, y, 1000, houseWithRoomDistance, &query);
 }
 
 int HousePopulation_addPeople(int amount)
 {
 	int added = 0;
 	int buildingId = Data_CityInfo.populationLastTargetHouseAdd;
-	for (int i = 1; i < MAX_BUILDINGS && added < amount; i++) {
-		if (++buildingId >= MAX_BUILDINGS) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity && added < amount; i++) {
+		if (++buildingId >= Data_Buildings_Extra.capacity) {
 			buildingId = 1;
 		}
 		struct Data_Building *b = &Data_Buildings[buildingId];
@@ -321,8 +330,8 @@ int HousePopulation_removePeople(int amount)
 {
 	int removed = 0;
 	int buildingId = Data_CityInfo.populationLastTargetHouseRemove;
-	for (int i = 1; i < 4 * MAX_BUILDINGS && removed < amount; i++) {
-		if (++buildingId >= MAX_BUILDINGS) {
+	for (int i = 1; i < 4 * Data_Buildings_Extra.capacity && removed < amount; i++) {
+		if (++buildingId >= Data_Buildings_Extra.capacity) {
 			buildingId = 1;
 		}
 		struct Data_Building *b = &Data_Buildings[buildingId];
@@ -344,7 +353,7 @@ int HousePopulation_calculatePeoplePerType()
 	Data_CityInfo.populationPeopleInTents = 0;
 	Data_CityInfo.populationPeopleInLargeInsulaAndAbove = 0;
 	int total = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (b->state == BuildingState_Unused ||
 			b->state == BuildingState_Undo ||
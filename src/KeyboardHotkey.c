@@ -3,6 +3,7 @@
 #include "CityView.h"
 #include "Event.h"
 #include "Graphics.h"
+#include "Runner.h"
 #include "System.h"
 #include "Video.h"
 
@@ -81,6 +82,22 @@ static void togglePause()
 	}
 }
 
+static void toggleFastForward()
+{
+	ExitMilitaryCommand();
+	if (UI_Window_getId() == Window_City) {
+		Runner_toggleFastForward();
+	}
+}
+
+static void skipTo(RunnerSkip skip)
+{
+	ExitMilitaryCommand();
+	if (UI_Window_getId() == Window_City) {
+		Runner_skipTo(skip);
+	}
+}
+
 static void showAdvisor(int advisor)
 {
 	ExitMilitaryCommand();
@@ -199,6 +216,15 @@ void KeyboardHotkey_character(int c)
 		case 'L': case 'l':
 			cycleLegion();
 			break;
+		case 'G': case 'g':
+			toggleFastForward();
+			break;
+		case 'M': case 'm':
+			skipTo(RunnerSkip_Month);
+			break;
+		case 'Y': case 'y':
+			skipTo(RunnerSkip_Year);
+			break;
 		case '1':
 			showAdvisor(Advisor_Labor);
 			break;
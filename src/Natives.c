@@ -56,8 +56,8 @@ void Natives_init()
 				case BUILDING_NATIVE_MEETING:
 					b->sentiment.nativeAnger = 100;
 					Data_Grid_buildingIds[gridOffset + 1] = buildingId;
-					Data_Grid_buildingIds[gridOffset + 162] = buildingId;
-					Data_Grid_buildingIds[gridOffset + 163] = buildingId;
+					Data_Grid_buildingIds[gridOffset + GRID_SIZE] = buildingId;
+					Data_Grid_buildingIds[gridOffset + GRID_SIZE + 1] = buildingId;
 					Terrain_markNativeLand(b->x, b->y, 2, 6);
 					if (!Data_CityInfo.nativeMainMeetingCenterX) {
 						Data_CityInfo.nativeMainMeetingCenterX = b->x;
@@ -80,7 +80,7 @@ static void determineMeetingCenter()
 {
 	// gather list of meeting centers
 	building_list_small_clear();
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].type == BUILDING_NATIVE_MEETING) {
 			building_list_small_add(i);
 		}
@@ -91,7 +91,7 @@ static void determineMeetingCenter()
 	}
 	const int *meetings = building_list_small_items();
 	// determine closest meeting center for hut
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].type == BUILDING_NATIVE_HUT) {
 			int minDist = 1000;
 			int minMeetingId = 0;
@@ -115,7 +115,7 @@ void Natives_checkLand()
 	if (Data_CityInfo.nativeAttackDuration) {
 		Data_CityInfo.nativeAttackDuration--;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (!BuildingIsInUse(i)) {
 			continue;
 		}
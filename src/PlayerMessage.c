@@ -2,6 +2,7 @@
 
 #include "CityView.h"
 #include "Formation.h"
+#include "Runner.h"
 #include "Sound.h"
 
 #include "UI/MessageDialog.h"
@@ -22,6 +23,7 @@ static int getNewMessageId();
 
 static int playSound = 1;
 static int consecutiveMessageDelay;
+static int dialogPending;
 
 static int hasVideo(int textId)
 {
@@ -32,12 +34,33 @@ static int hasVideo(int textId)
 	return file_exists((const char*)msg->video.text);
 }
 
+static void requestRefresh(int param)
+{
+	UI_Window_requestRefresh();
+}
+
+static void showMessageDialog(int sequence)
+{
+	dialogPending = 0;
+	for (int i = 0; i < 999 && Data_Message.messages[i].messageType; i++) {
+		struct Data_PlayerMessage *msg = &Data_Message.messages[i];
+		if (msg->sequence == sequence) {
+			UI_Tooltip_resetTimer();
+			UI_MessageDialog_setPlayerMessage(
+				msg->year, msg->month, msg->param1, msg->param2,
+				PlayerMessage_getAdvisorForMessageType(msg->messageType), 1);
+			UI_MessageDialog_show(PlayerMessage_getMessageTextId(msg->messageType), 0);
+			return;
+		}
+	}
+}
+
 void PlayerMessage_disableSoundForNextMessage()
 {
 	playSound = 0;
 }
 
-void PlayerMessage_post(int usePopup, int messageType, int param1, short param2)
+void PlayerMessage_post(int usePopup, int messageType, int param1, int param2)
 {
 	int id = getNewMessageId();
 	if (id < 0) {
@@ -58,13 +81,13 @@ void PlayerMessage_post(int usePopup, int messageType, int param1, short param2)
 	lang_message_type langMessageType = lang_get_message(textId)->message_type;
 	if (langMessageType == MESSAGE_TYPE_DISASTER || langMessageType == MESSAGE_TYPE_INVASION) {
 		Data_Message.hotspotCount = 1;
-		UI_Window_requestRefresh();
+		Runner_callUi(requestRefresh, 0, 0);
 	}
-	if (usePopup && UI_Window_getId() == Window_City) {
+	// the dialog of an earlier message may still be waiting to be shown
+	if (usePopup && UI_Window_getId() == Window_City && !dialogPending) {
 		consecutiveMessageDelay = 5;
 		Data_Message.currentProblemAreaMessageId = Data_Message.currentMessageId;
 		msg->readFlag = 1;
-		UI_Tooltip_resetTimer();
 		if (!hasVideo(textId)) {
 			if (lang_get_message(textId)->urgent == 1) {
 				Sound_Effects_playChannel(SoundChannel_FanfareUrgent);
@@ -72,10 +95,8 @@ void PlayerMessage_post(int usePopup, int messageType, int param1, short param2)
 				Sound_Effects_playChannel(SoundChannel_Fanfare);
 			}
 		}
-		UI_MessageDialog_setPlayerMessage(
-			msg->year, msg->month, msg->param1, msg->param2,
-			PlayerMessage_getAdvisorForMessageType(msg->messageType), usePopup);
-		UI_MessageDialog_show(textId, 0);
+		dialogPending = 1;
+		Runner_callUi(showMessageDialog, msg->sequence, 1);
 	} else if (usePopup) {
 		// add to queue to be processed when player returns to city
 		for (int i = 0; i < 20; i++) {
@@ -94,7 +115,7 @@ void PlayerMessage_post(int usePopup, int messageType, int param1, short param2)
 	playSound = 1;
 }
 
-void PlayerMessage_postWithPopupDelay(int type, int messageType, int param1, short param2)
+void PlayerMessage_postWithPopupDelay(int type, int messageType, int param1, int param2)
 {
 	int usePopup = 0;
 	if (Data_Message.messageDelay[type] <= 0) {
@@ -143,7 +164,6 @@ void PlayerMessage_processQueue()
 	msg->readFlag = 1;
 	Data_Message.currentProblemAreaMessageId = msgId;
 	int textId = PlayerMessage_getMessageTextId(msg->messageType);
-	UI_Tooltip_resetTimer();
 	if (!hasVideo(textId)) {
 		if (lang_get_message(textId)->urgent == 1) {
 			Sound_Effects_playChannel(SoundChannel_FanfareUrgent);
@@ -151,10 +171,7 @@ void PlayerMessage_processQueue()
 			Sound_Effects_playChannel(SoundChannel_Fanfare);
 		}
 	}
-	UI_MessageDialog_setPlayerMessage(
-		msg->year, msg->month, msg->param1, msg->param2,
-		PlayerMessage_getAdvisorForMessageType(msg->messageType), 1);
-	UI_MessageDialog_show(textId, 0);
+	showMessageDialog(msg->sequence);
 }
 
 static int getNewMessageId()
@@ -34,7 +34,7 @@ void Resource_calculateWarehouseStocks()
 		Data_CityInfo.resourceSpaceInWarehouses[i] = 0;
 		Data_CityInfo.resourceStored[i] = 0;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (BuildingIsInUse(i) && b->type == BUILDING_WAREHOUSE) {
 			b->hasRoadAccess = 0;
@@ -45,7 +45,7 @@ void Resource_calculateWarehouseStocks()
 			}
 		}
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || b->type != BUILDING_WAREHOUSE_SPACE) {
 			continue;
@@ -71,7 +71,7 @@ void Resource_calculateWorkshopStocks()
 		Data_CityInfo.resourceWorkshopRawMaterialStored[i] = 0;
 		Data_CityInfo.resourceWorkshopRawMaterialSpace[i] = 0;
 	}
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || !BuildingIsWorkshop(b->type)) {
 			continue;
@@ -108,7 +108,7 @@ int Resource_getWorkshopWithRoomForRawMaterial(
 	}
 	int minDist = 10000;
 	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || !BuildingIsWorkshop(b->type)) {
 			continue;
@@ -150,7 +150,7 @@ int Resource_getWorkshopForRawMaterial(
 	}
 	int minDist = 10000;
 	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || !BuildingIsWorkshop(b->type)) {
 			continue;
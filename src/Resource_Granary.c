@@ -8,6 +8,7 @@
 #include "Data/Scenario.h"
 
 #include "building/model.h"
+#include "building/spatial.h"
 
 static struct {
 	int buildingIds[100];
@@ -41,7 +42,7 @@ void Resource_gatherGranaryGettingInfo()
 	nonGettingGranaries.totalStorageFruit = 0;
 	nonGettingGranaries.totalStorageMeat = 0;
 
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY) {
 			continue;
@@ -76,6 +77,73 @@ void Resource_gatherGranaryGettingInfo()
 	}
 }
 
+struct StoringQuery {
+	int x;
+	int y;
+	int resource;
+	int distanceFromEntry;
+	int roadNetworkId;
+	int *understaffed;
+};
+
+static int storingGranaryDistance(int buildingId, void *data)
+{
+	struct StoringQuery *query = (struct StoringQuery*) data;
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (!BuildingIsInUse(buildingId)) {
+		return -1;
+	}
+	if (!b->hasRoadAccess || b->distanceFromEntry <= 0 || b->roadNetworkId != query->roadNetworkId) {
+		return -1;
+	}
+	int pctWorkers = calc_percentage(b->numWorkers, model_get_building(b->type)->laborers);
+	if (pctWorkers < 100) {
+		if (query->understaffed) {
+			*query->understaffed += 1;
+		}
+		return -1;
+	}
+	struct Data_Building_Storage *s = &Data_Building_Storages[b->storageId];
+	if (s->resourceState[query->resource] == BuildingStorageState_NotAccepting || s->emptyAll) {
+		return -1;
+	}
+	if (b->data.storage.resourceStored[Resource_None] < 100) {
+		return -1;
+	}
+	// there is room
+	return Resource_getDistance(b->x + 1, b->y + 1, query->x, query->y,
+		query->distanceFromEntry, b->distanceFromEntry);
+}
+
+static int gettingGranaryDistance(int buildingId, void *data)
+{
+	struct StoringQuery *query = (struct StoringQuery*) data;
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (!BuildingIsInUse(buildingId)) {
+		return -1;
+	}
+	if (!b->hasRoadAccess || b->distanceFromEntry <= 0 || b->roadNetworkId != query->roadNetworkId) {
+		return -1;
+	}
+	int pctWorkers = calc_percentage(b->numWorkers, model_get_building(b->type)->laborers);
+	if (pctWorkers < 100) {
+		return -1;
+	}
+	struct Data_Building_Storage *s = &Data_Building_Storages[b->storageId];
+	if (s->resourceState[query->resource] != BuildingStorageState_Getting || s->emptyAll) {
+		return -1;
+	}
+	if (b->data.storage.resourceStored[Resource_None] <= 100) {
+		return -1;
+	}
+	// there is room
+	return Resource_getDistance(b->x + 1, b->y + 1, query->x, query->y,
+		query->distanceFromEntry, b->distanceFromEntry);
+}
+
+// Distances are measured to the center of the granary, which is one tile further
+// than its position: searching from one tile back gives the same bounds.
+// Understaffed granaries are only counted completely when no granary is found.
 int Resource_getGranaryForStoringFood(
 	int forceOnStockpile, int x, int y, int resource, int distanceFromEntry, int roadNetworkId,
 	int *understaffed, int *xDst, int *yDst)
@@ -89,36 +157,9 @@ int Resource_getGranaryForStoringFood(
 	if (Data_CityInfo.resourceStockpiled[resource] && !forceOnStockpile) {
 		return 0;
 	}
-	int minDist = 10000;
-	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY) {
-			continue;
-		}
-		if (!b->hasRoadAccess || b->distanceFromEntry <= 0 || b->roadNetworkId != roadNetworkId) {
-			continue;
-		}
-		int pctWorkers = calc_percentage(b->numWorkers, model_get_building(b->type)->laborers);
-		if (pctWorkers < 100) {
-			if (understaffed) {
-				*understaffed += 1;
-			}
-			continue;
-		}
-		struct Data_Building_Storage *s = &Data_Building_Storages[b->storageId];
-		if (s->resourceState[resource] == BuildingStorageState_NotAccepting || s->emptyAll) {
-			continue;
-		}
-		if (b->data.storage.resourceStored[Resource_None] >= 100) {
-			// there is room
-			int dist = Resource_getDistance(b->x + 1, b->y + 1, x, y, distanceFromEntry, b->distanceFromEntry);
-			if (dist < minDist) {
-				minDist = dist;
-				minBuildingId = i;
-			}
-		}
-	}
+	struct StoringQuery query = {x, y, resource, distanceFromEntry, roadNetworkId, understaffed};
+	int minBuildingId = building_spatial_find_nearest(BUILDING_GRANARY, BUILDING_GRANARY,
+		x - 1, y - 1, 10000, storingGranaryDistance, &query);
 	// deliver to center of granary
 	*xDst = Data_Buildings[minBuildingId].x + 1;
 	*yDst = Data_Buildings[minBuildingId].y + 1;
@@ -138,33 +179,9 @@ int Resource_getGettingGranaryForStoringFood(
 	if (Data_CityInfo.resourceStockpiled[resource]) {
 		return 0;
 	}
-	int minDist = 10000;
-	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY) {
-			continue;
-		}
-		if (!b->hasRoadAccess || b->distanceFromEntry <= 0 || b->roadNetworkId != roadNetworkId) {
-			continue;
-		}
-		int pctWorkers = calc_percentage(b->numWorkers, model_get_building(b->type)->laborers);
-		if (pctWorkers < 100) {
-			continue;
-		}
-		struct Data_Building_Storage *s = &Data_Building_Storages[b->storageId];
-		if (s->resourceState[resource] != BuildingStorageState_Getting || s->emptyAll) {
-			continue;
-		}
-		if (b->data.storage.resourceStored[Resource_None] > 100) {
-			// there is room
-			int dist = Resource_getDistance(b->x + 1, b->y + 1, x, y, distanceFromEntry, b->distanceFromEntry);
-			if (dist < minDist) {
-				minDist = dist;
-				minBuildingId = i;
-			}
-		}
-	}
+	struct StoringQuery query = {x, y, resource, distanceFromEntry, roadNetworkId, 0};
+	int minBuildingId = building_spatial_find_nearest(BUILDING_GRANARY, BUILDING_GRANARY,
+		x - 1, y - 1, 10000, gettingGranaryDistance, &query);
 	*xDst = Data_Buildings[minBuildingId].x + 1;
 	*yDst = Data_Buildings[minBuildingId].y + 1;
 	return minBuildingId;
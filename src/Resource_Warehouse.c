@@ -12,7 +12,9 @@
 #include "Data/Scenario.h"
 
 #include "building/count.h"
+#include "building/index.h"
 #include "building/model.h"
+#include "building/spatial.h"
 #include "empire/trade_prices.h"
 #include "graphics/image.h"
 
@@ -32,16 +34,19 @@ void Resource_setWarehouseSpaceGraphic(int spaceId, int resource)
 	Data_Grid_graphicIds[Data_Buildings[spaceId].gridOffset] = graphicId;
 }
 
+static int nextCityWarehouse(int buildingId)
+{
+	// round robin over the warehouses in ID order
+	int nextId = building_index_find_next(BUILDING_WAREHOUSE, buildingId);
+	return nextId ? nextId : building_index_first(BUILDING_WAREHOUSE);
+}
+
 void Resource_addToCityWarehouses(int resource, int amount)
 {
 	int buildingId = Data_CityInfo.resourceLastTargetWarehouse;
-	for (int i = 1; i < MAX_BUILDINGS && amount > 0; i++) {
-		buildingId++;
-		if (buildingId >= MAX_BUILDINGS) {
-			buildingId = 1;
-		}
-		if (BuildingIsInUse(buildingId) &&
-			Data_Buildings[buildingId].type == BUILDING_WAREHOUSE) {
+	for (int i = building_index_count(BUILDING_WAREHOUSE); i > 0 && amount > 0; i--) {
+		buildingId = nextCityWarehouse(buildingId);
+		if (BuildingIsInUse(buildingId)) {
 			Data_CityInfo.resourceLastTargetWarehouse = buildingId;
 			while (amount && Resource_addToWarehouse(buildingId, resource)) {
 				amount--;
@@ -55,13 +60,9 @@ int Resource_removeFromCityWarehouses(int resource, int amount)
 	int amountLeft = amount;
 	int buildingId = Data_CityInfo.resourceLastTargetWarehouse;
 	// first go for non-getting warehouses
-	for (int i = 1; i < MAX_BUILDINGS && amountLeft > 0; i++) {
-		buildingId++;
-		if (buildingId >= MAX_BUILDINGS) {
-			buildingId = 1;
-		}
-		if (BuildingIsInUse(buildingId) &&
-			Data_Buildings[buildingId].type == BUILDING_WAREHOUSE) {
+	for (int i = building_index_count(BUILDING_WAREHOUSE); i > 0 && amountLeft > 0; i--) {
+		buildingId = nextCityWarehouse(buildingId);
+		if (BuildingIsInUse(buildingId)) {
 			int storageId = Data_Buildings[buildingId].storageId;
 			if (Data_Building_Storages[storageId].resourceState[resource] != BuildingStorageState_Getting) {
 				Data_CityInfo.resourceLastTargetWarehouse = buildingId;
@@ -70,13 +71,9 @@ int Resource_removeFromCityWarehouses(int resource, int amount)
 		}
 	}
 	// if that doesn't work, take it anyway
-	for (int i = 1; i < MAX_BUILDINGS && amountLeft > 0; i++) {
-		buildingId++;
-		if (buildingId >= MAX_BUILDINGS) {
-			buildingId = 1;
-		}
-		if (BuildingIsInUse(buildingId) &&
-			Data_Buildings[buildingId].type == BUILDING_WAREHOUSE) {
+	for (int i = building_index_count(BUILDING_WAREHOUSE); i > 0 && amountLeft > 0; i--) {
+		buildingId = nextCityWarehouse(buildingId);
+		if (BuildingIsInUse(buildingId)) {
 			Data_CityInfo.resourceLastTargetWarehouse = buildingId;
 			amountLeft = Resource_removeFromWarehouse(buildingId, resource, amountLeft);
 		}
@@ -84,56 +81,77 @@ int Resource_removeFromCityWarehouses(int resource, int amount)
 	return amount - amountLeft;
 }
 
+struct StoringQuery {
+	int srcBuildingId;
+	int x;
+	int y;
+	int resource;
+	int distanceFromEntry;
+	int roadNetworkId;
+	int *understaffed;
+};
+
+static int storingWarehouseSpaceDistance(int spaceId, void *data)
+{
+	struct StoringQuery *query = (struct StoringQuery*) data;
+	struct Data_Building *b = &Data_Buildings[spaceId];
+	if (!BuildingIsInUse(spaceId)) {
+		return -1;
+	}
+	if (!b->hasRoadAccess || b->distanceFromEntry <= 0 || b->roadNetworkId != query->roadNetworkId) {
+		return -1;
+	}
+	int dstBuildingId = Building_getMainBuildingId(spaceId);
+	if (query->srcBuildingId == dstBuildingId) {
+		return -1;
+	}
+	struct Data_Building_Storage *s = &Data_Building_Storages[Data_Buildings[dstBuildingId].storageId];
+	if (s->resourceState[query->resource] == BuildingStorageState_NotAccepting || s->emptyAll) {
+		return -1;
+	}
+	int pctWorkers = calc_percentage(
+		Data_Buildings[dstBuildingId].numWorkers,
+		model_get_building(Data_Buildings[dstBuildingId].type)->laborers);
+	if (pctWorkers < 100) {
+		if (query->understaffed) {
+			*query->understaffed += 1;
+		}
+		return -1;
+	}
+	int dist;
+	if (b->subtype.warehouseResourceId == Resource_None) { // empty warehouse space
+		dist = Resource_getDistance(b->x, b->y, query->x, query->y, query->distanceFromEntry, b->distanceFromEntry);
+	} else if (b->subtype.warehouseResourceId == query->resource && b->loadsStored < 4) {
+		dist = Resource_getDistance(b->x, b->y, query->x, query->y, query->distanceFromEntry, b->distanceFromEntry);
+	} else {
+		dist = 0;
+	}
+	return dist > 0 ? dist : -1;
+}
+
+// Understaffed warehouses are only counted completely when 0 is returned:
+// the search stops as soon as no closer warehouse is possible
 int Resource_getWarehouseForStoringResource(
 	int srcBuildingId, int x, int y, int resource, int distanceFromEntry, int roadNetworkId,
 	int *understaffed, int *xDst, int *yDst)
 {
-	int minDist = 10000;
-	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_WAREHOUSE_SPACE) {
-			continue;
-		}
-		if (!b->hasRoadAccess || b->distanceFromEntry <= 0 || b->roadNetworkId != roadNetworkId) {
-			continue;
-		}
-		int dstBuildingId = Building_getMainBuildingId(i);
-		if (srcBuildingId == dstBuildingId) {
-			continue;
-		}
-		struct Data_Building_Storage *s = &Data_Building_Storages[Data_Buildings[dstBuildingId].storageId];
-		if (s->resourceState[resource] == BuildingStorageState_NotAccepting || s->emptyAll) {
-			continue;
-		}
-		int pctWorkers = calc_percentage(
-			Data_Buildings[dstBuildingId].numWorkers,
-			model_get_building(Data_Buildings[dstBuildingId].type)->laborers);
-		if (pctWorkers < 100) {
-			if (understaffed) {
-				*understaffed += 1;
-			}
-			continue;
-		}
-		int dist;
-		if (b->subtype.warehouseResourceId == Resource_None) { // empty warehouse space
-			dist = Resource_getDistance(b->x, b->y, x, y, distanceFromEntry, b->distanceFromEntry);
-		} else if (b->subtype.warehouseResourceId == resource && b->loadsStored < 4) {
-			dist = Resource_getDistance(b->x, b->y, x, y, distanceFromEntry, b->distanceFromEntry);
-		} else {
-			dist = 0;
-		}
-		if (dist > 0 && dist < minDist) {
-			minDist = dist;
-			minBuildingId = i;
-		}
-	}
+	int understaffedBefore = understaffed ? *understaffed : 0;
+	struct StoringQuery query = {srcBuildingId, x, y, resource, distanceFromEntry, roadNetworkId, understaffed};
+	int minBuildingId = building_spatial_find_nearest(BUILDING_WAREHOUSE_SPACE, BUILDING_WAREHOUSE_SPACE,
+		x, y, 10000, storingWarehouseSpaceDistance, &query);
 	int resultBuildingId = Building_getMainBuildingId(minBuildingId);
 	struct Data_Building *b = &Data_Buildings[resultBuildingId];
 	if (b->hasRoadAccess == 1) {
 		*xDst = b->x;
 		*yDst = b->y;
 	} else if (!Terrain_hasRoadAccess(b->x, b->y, 3, xDst, yDst)) {
+		if (understaffed && minBuildingId) {
+			// the search stopped early: recount the understaffed warehouses
+			*understaffed = understaffedBefore;
+			FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_WAREHOUSE_SPACE) {
+				storingWarehouseSpaceDistance(i, &query);
+			}
+		}
 		return 0;
 	}
 	return minBuildingId;
@@ -144,9 +162,9 @@ int Resource_getWarehouseForGettingResource(int srcBuildingId, int resource, int
 	struct Data_Building *bSrc = &Data_Buildings[srcBuildingId];
 	int minDist = 10000;
 	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_WAREHOUSE) {
 		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_WAREHOUSE) {
+		if (!BuildingIsInUse(i)) {
 			continue;
 		}
 		if (i == srcBuildingId) {
@@ -375,9 +393,9 @@ static int determineGranaryAcceptFoods()
 		granaryAcceptingResource[i] = 0;
 	}
 	int canAccept = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_GRANARY) {
 		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY || !b->hasRoadAccess) {
+		if (!BuildingIsInUse(i) || !b->hasRoadAccess) {
 			continue;
 		}
 		int pctWorkers = calc_percentage(b->numWorkers, model_get_building(b->type)->laborers);
@@ -405,9 +423,9 @@ static int determineGranaryGetFoods()
 		granaryGettingResource[i] = 0;
 	}
 	int canGet = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_GRANARY) {
 		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_GRANARY || !b->hasRoadAccess) {
+		if (!BuildingIsInUse(i) || !b->hasRoadAccess) {
 			continue;
 		}
 		int pctWorkers = calc_percentage(b->numWorkers, model_get_building(b->type)->laborers);
@@ -1,6 +1,5 @@
 #include "Routing.h"
 
-#include "Grid.h"
 #include "TerrainGraphics.h"
 
 #include "Data/Building.h"
@@ -14,11 +13,21 @@
 
 #include "core/calc.h"
 #include "core/random.h"
+#include "core/trace.h"
 #include "graphics/image.h"
+#include "map/route_limit.h"
 
 #include <string.h>
 
-#define MAX_QUEUE 26244
+#define MAX_QUEUE (GRID_SIZE * GRID_SIZE)
+#define MAX_SEARCH_COST (GRID_SIZE * GRID_SIZE + 2 * GRID_SIZE)
+#define MAX_SEARCH_ENTRIES (2 * GRID_SIZE * GRID_SIZE)
+#define MAX_DIRTY_LAND_AREAS 64
+
+// build with -DROUTING_VERIFY_UPDATES=1 to check partial land updates against a full rebuild
+#ifndef ROUTING_VERIFY_UPDATES
+#define ROUTING_VERIFY_UPDATES 0
+#endif
 
 static struct {
 	int head;
@@ -31,42 +40,145 @@ static struct {
 	int isAqueduct;
 } state;
 
+// bumped whenever one of the routing grids is rebuilt
+static int terrainVersion;
+
+// parts of the land grids that need to be classified again
+static struct {
+	int numAreas;
+	int overflow;
+	struct {
+		int xMin;
+		int yMin;
+		int xMax;
+		int yMax;
+	} areas[MAX_DIRTY_LAND_AREAS];
+} dirtyLand;
+
 static int directionPath[500];
 
 static char tmpGrid[GRID_SIZE * GRID_SIZE];
 
+// A distance or tmpGrid value is only valid when its tile is stamped with
+// the current generation, so starting a query does not need to clear the grids
+static struct {
+	unsigned short current;
+	unsigned short distance[GRID_SIZE * GRID_SIZE];
+	unsigned short tmp[GRID_SIZE * GRID_SIZE];
+} generation;
+
+static void startQuery(int source)
+{
+	if (++generation.current == 0) {
+		memset(generation.distance, 0, sizeof(generation.distance));
+		memset(generation.tmp, 0, sizeof(generation.tmp));
+		generation.current = 1;
+	}
+	generation.distance[source] = generation.current;
+	Data_Grid_routingDistance[source] = 1;
+}
+
+static int getDistance(int gridOffset)
+{
+	return generation.distance[gridOffset] == generation.current ?
+		Data_Grid_routingDistance[gridOffset] : 0;
+}
+
+static void setDistance(int gridOffset, unsigned short dist)
+{
+	generation.distance[gridOffset] = generation.current;
+	Data_Grid_routingDistance[gridOffset] = dist;
+}
+
+static int nextDragCount(int gridOffset)
+{
+	if (generation.tmp[gridOffset] != generation.current) {
+		generation.tmp[gridOffset] = generation.current;
+		tmpGrid[gridOffset] = 0;
+	}
+	return tmpGrid[gridOffset]++;
+}
+
+// Open list of the goal-directed search: one stack of tiles per estimated cost
+static struct {
+	int active;
+	int overflow;
+	int numDirections;
+	int xDst;
+	int yDst;
+	int maxCost;
+	int numEntries;
+	int buckets[MAX_SEARCH_COST];
+	int next[MAX_SEARCH_ENTRIES + 1];
+	int offsets[MAX_SEARCH_ENTRIES + 1];
+	int dists[MAX_SEARCH_ENTRIES + 1];
+} search;
+
+static int estimateCost(int gridOffset, int dist)
+{
+	int dx = gridOffset % GRID_SIZE - search.xDst;
+	int dy = gridOffset / GRID_SIZE - search.yDst;
+	if (dx < 0) dx = -dx;
+	if (dy < 0) dy = -dy;
+	if (search.numDirections == 8) {
+		return dist + (dx > dy ? dx : dy);
+	} else {
+		return dist + dx + dy;
+	}
+}
+
+static void addToOpenList(int gridOffset, int dist)
+{
+	int cost = estimateCost(gridOffset, dist);
+	if (search.numEntries >= MAX_SEARCH_ENTRIES || cost >= MAX_SEARCH_COST) {
+		search.overflow = 1;
+		return;
+	}
+	int entry = ++search.numEntries;
+	search.offsets[entry] = gridOffset;
+	search.dists[entry] = dist;
+	search.next[entry] = search.buckets[cost];
+	search.buckets[cost] = entry;
+	if (cost > search.maxCost) {
+		search.maxCost = cost;
+	}
+}
+
 static void setDistAndEnqueue(int nextOffset, int dist)
 {
-	Data_Grid_routingDistance[nextOffset] = dist;
+	setDistance(nextOffset, dist);
+	if (search.active) {
+		addToOpenList(nextOffset, dist);
+		return;
+	}
 	queue.items[queue.tail++] = nextOffset;
 	if (queue.tail >= MAX_QUEUE) queue.tail = 0;
 }
 
 static void routeQueue(int source, int dest, void (*callback)(int nextOffset, int dist))
 {
-	Grid_clearShortGrid(Data_Grid_routingDistance);
-	Data_Grid_routingDistance[source] = 1;
+	startQuery(source);
 	queue.items[0] = source;
 	queue.head = 0;
 	queue.tail = 1;
 	while (queue.head != queue.tail) {
 		int offset = queue.items[queue.head];
 		if (offset == dest) break;
-		int dist = 1 + Data_Grid_routingDistance[offset];
-		int nextOffset = offset - 162;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		int dist = 1 + getDistance(offset);
+		int nextOffset = offset - GRID_SIZE;
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		nextOffset = offset + 1;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset + 162;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset + GRID_SIZE;
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		nextOffset = offset - 1;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		if (++queue.head >= MAX_QUEUE) queue.head = 0;
@@ -75,28 +187,27 @@ static void routeQueue(int source, int dest, void (*callback)(int nextOffset, in
 
 static void routeQueueWhileTrue(int source, int (*callback)(int nextOffset, int dist))
 {
-	Grid_clearShortGrid(Data_Grid_routingDistance);
-	Data_Grid_routingDistance[source] = 1;
+	startQuery(source);
 	queue.items[0] = source;
 	queue.head = 0;
 	queue.tail = 1;
 	while (queue.head != queue.tail) {
 		int offset = queue.items[queue.head];
-		int dist = 1 + Data_Grid_routingDistance[offset];
-		int nextOffset = offset - 162;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		int dist = 1 + getDistance(offset);
+		int nextOffset = offset - GRID_SIZE;
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			if (!callback(nextOffset, dist)) break;
 		}
 		nextOffset = offset + 1;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			if (!callback(nextOffset, dist)) break;
 		}
-		nextOffset = offset + 162;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset + GRID_SIZE;
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			if (!callback(nextOffset, dist)) break;
 		}
 		nextOffset = offset - 1;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			if (!callback(nextOffset, dist)) break;
 		}
 		if (++queue.head >= MAX_QUEUE) queue.head = 0;
@@ -105,8 +216,7 @@ static void routeQueueWhileTrue(int source, int (*callback)(int nextOffset, int
 
 static void routeQueueMax(int source, int dest, int maxTiles, void (*callback)(int, int))
 {
-	Grid_clearShortGrid(Data_Grid_routingDistance);
-	Data_Grid_routingDistance[source] = 1;
+	startQuery(source);
 	queue.items[0] = source;
 	queue.head = 0;
 	queue.tail = 1;
@@ -115,21 +225,21 @@ static void routeQueueMax(int source, int dest, int maxTiles, void (*callback)(i
 		int offset = queue.items[queue.head];
 		if (offset == dest) break;
 		if (++tiles > maxTiles) break;
-		int dist = 1 + Data_Grid_routingDistance[offset];
-		int nextOffset = offset - 162;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		int dist = 1 + getDistance(offset);
+		int nextOffset = offset - GRID_SIZE;
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		nextOffset = offset + 1;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset + 162;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset + GRID_SIZE;
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		nextOffset = offset - 1;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		if (++queue.head >= MAX_QUEUE) queue.head = 0;
@@ -138,9 +248,7 @@ static void routeQueueMax(int source, int dest, int maxTiles, void (*callback)(i
 
 static void routeQueueBoat(int source, void (*callback)(int, int))
 {
-	Grid_clearShortGrid(Data_Grid_routingDistance);
-	Grid_clearByteGrid(tmpGrid);
-	Data_Grid_routingDistance[source] = 1;
+	startQuery(source);
 	queue.items[0] = source;
 	queue.head = 0;
 	queue.tail = 1;
@@ -149,25 +257,25 @@ static void routeQueueBoat(int source, void (*callback)(int, int))
 		int offset = queue.items[queue.head];
 		if (++tiles > 50000) break;
 		int drag = Data_Grid_routingWater[offset] == Routing_Water_m2_MapEdge ? 4 : 0;
-		if (drag && tmpGrid[offset]++ < drag) {
+		if (drag && nextDragCount(offset) < drag) {
 			queue.items[queue.tail++] = offset;
 			if (queue.tail >= MAX_QUEUE) queue.tail = 0;
 		} else {
-			int dist = 1 + Data_Grid_routingDistance[offset];
-			int nextOffset = offset - 162;
-			if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+			int dist = 1 + getDistance(offset);
+			int nextOffset = offset - GRID_SIZE;
+			if (nextOffset >= 0 && !getDistance(nextOffset)) {
 				callback(nextOffset, dist);
 			}
 			nextOffset = offset + 1;
-			if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+			if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 				callback(nextOffset, dist);
 			}
-			nextOffset = offset + 162;
-			if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+			nextOffset = offset + GRID_SIZE;
+			if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 				callback(nextOffset, dist);
 			}
 			nextOffset = offset - 1;
-			if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+			if (nextOffset >= 0 && !getDistance(nextOffset)) {
 				callback(nextOffset, dist);
 			}
 		}
@@ -177,8 +285,7 @@ static void routeQueueBoat(int source, void (*callback)(int, int))
 
 static void routeQueueDir8(int source, void (*callback)(int, int))
 {
-	Grid_clearShortGrid(Data_Grid_routingDistance);
-	Data_Grid_routingDistance[source] = 1;
+	startQuery(source);
 	queue.items[0] = source;
 	queue.head = 0;
 	queue.tail = 1;
@@ -186,211 +293,407 @@ static void routeQueueDir8(int source, void (*callback)(int, int))
 	while (queue.head != queue.tail) {
 		if (++tiles > 50000) break;
 		int offset = queue.items[queue.head];
-		int dist = 1 + Data_Grid_routingDistance[offset];
-		int nextOffset = offset - 162;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		int dist = 1 + getDistance(offset);
+		int nextOffset = offset - GRID_SIZE;
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		nextOffset = offset + 1;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset + 162;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset + GRID_SIZE;
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		nextOffset = offset - 1;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset - 161;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset - GRID_SIZE + 1;
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset + 163;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset + GRID_SIZE + 1;
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset + 161;
-		if (nextOffset < 162 * 162 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset + GRID_SIZE - 1;
+		if (nextOffset < GRID_SIZE * GRID_SIZE && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
-		nextOffset = offset - 163;
-		if (nextOffset >= 0 && !Data_Grid_routingDistance[nextOffset]) {
+		nextOffset = offset - GRID_SIZE - 1;
+		if (nextOffset >= 0 && !getDistance(nextOffset)) {
 			callback(nextOffset, dist);
 		}
 		if (++queue.head >= MAX_QUEUE) queue.head = 0;
 	}
 }
 
+static void searchNeighbour(int nextOffset, int dist, void (*callback)(int, int))
+{
+	int nextDist = getDistance(nextOffset);
+	if (!nextDist || dist < nextDist) {
+		callback(nextOffset, dist);
+	}
+}
+
+// Goal-directed variant of routeQueue/routeQueueDir8: tiles are expanded by
+// distance plus estimated distance to the destination. The search only stops
+// after all tiles estimated at most as far as the destination are expanded, so
+// every distance that Routing_getPath compares is the same as after the flood
+// fill. Returns 1 if the destination was reached, 0 if it cannot be reached,
+// -1 if the search gave up and the flood fill has to be used
+static int routeSearch(int source, int dest, int numDirections, int maxTiles, void (*callback)(int, int))
+{
+	if (Data_Settings_Map.gridBorderSize <= 0) {
+		return -1; // no border: neighbours wrap around to the next row
+	}
+	startQuery(source);
+	search.active = 1;
+	search.overflow = 0;
+	search.numDirections = numDirections;
+	search.xDst = dest % GRID_SIZE;
+	search.yDst = dest / GRID_SIZE;
+	search.maxCost = 0;
+	search.numEntries = 0;
+	addToOpenList(source, 1);
+
+	int found = 0;
+	int tiles = 0;
+	int cost = estimateCost(source, 1);
+	while (cost <= search.maxCost && !search.overflow && tiles <= maxTiles) {
+		int entry = search.buckets[cost];
+		if (!entry) {
+			if (found) {
+				break; // all tiles as far as the destination are expanded
+			}
+			cost++;
+			continue;
+		}
+		search.buckets[cost] = search.next[entry];
+		int offset = search.offsets[entry];
+		int dist = search.dists[entry];
+		if (dist != getDistance(offset)) {
+			continue; // tile was reached by a shorter route later on
+		}
+		if (offset == dest) {
+			found = 1;
+			continue;
+		}
+		if (++tiles > maxTiles) {
+			break;
+		}
+		dist++;
+		if (offset - GRID_SIZE >= 0) searchNeighbour(offset - GRID_SIZE, dist, callback);
+		if (offset + 1 < GRID_SIZE * GRID_SIZE) searchNeighbour(offset + 1, dist, callback);
+		if (offset + GRID_SIZE < GRID_SIZE * GRID_SIZE) searchNeighbour(offset + GRID_SIZE, dist, callback);
+		if (offset - 1 >= 0) searchNeighbour(offset - 1, dist, callback);
+		if (numDirections == 8) {
+			if (offset - GRID_SIZE + 1 >= 0) searchNeighbour(offset - GRID_SIZE + 1, dist, callback);
+			if (offset + GRID_SIZE + 1 < GRID_SIZE * GRID_SIZE) searchNeighbour(offset + GRID_SIZE + 1, dist, callback);
+			if (offset + GRID_SIZE - 1 < GRID_SIZE * GRID_SIZE) searchNeighbour(offset + GRID_SIZE - 1, dist, callback);
+			if (offset - GRID_SIZE - 1 >= 0) searchNeighbour(offset - GRID_SIZE - 1, dist, callback);
+		}
+	}
+	for (; cost <= search.maxCost; cost++) {
+		search.buckets[cost] = 0;
+	}
+	search.active = 0;
+	if (search.overflow || tiles > maxTiles) {
+		return -1;
+	}
+	return found;
+}
+
+static int routeToDestination(int source, int dest, void (*callback)(int, int))
+{
+	int found = routeSearch(source, dest, 4, MAX_QUEUE, callback);
+	if (found < 0) {
+		routeQueue(source, dest, callback);
+		found = getDistance(dest) != 0;
+	}
+	return found;
+}
+
+static int landCitizenTile(int gridOffset)
+{
+	if (Data_Grid_terrain[gridOffset] & Terrain_Road) {
+		return Routing_Citizen_0_Road;
+	} else if (Data_Grid_terrain[gridOffset] & (Terrain_Rubble | Terrain_AccessRamp | Terrain_Garden)) {
+		return Routing_Citizen_2_PassableTerrain;
+	} else if (Data_Grid_terrain[gridOffset] & (Terrain_Building | Terrain_Gatehouse)) {
+		int buildingId = Data_Grid_buildingIds[gridOffset];
+		if (!buildingId) {
+			// shouldn't happen
+			Data_Grid_routingLandNonCitizen[gridOffset] = 4; // BUG: should be citizen?
+			Data_Grid_terrain[gridOffset] &= ~Terrain_Building; // remove 8 = building
+			Data_Grid_graphicIds[gridOffset] = (Data_Grid_random[gridOffset] & 7) + image_group(ID_Graphic_TerrainGrass1);
+			Data_Grid_edge[gridOffset] = Edge_LeftmostTile;
+			Data_Grid_bitfields[gridOffset] &= 0xf0; // remove sizes
+			return Routing_Citizen_m1_Blocked;
+		}
+		int land = Routing_Citizen_m1_Blocked;
+		switch (Data_Buildings[buildingId].type) {
+			case BUILDING_WAREHOUSE:
+			case BUILDING_GATEHOUSE:
+				land = Routing_Citizen_0_Road;
+				break;
+			case BUILDING_FORT_GROUND:
+				land = Routing_Citizen_2_PassableTerrain;
+				break;
+			case BUILDING_TRIUMPHAL_ARCH:
+				if (Data_Buildings[buildingId].subtype.orientation == 3) {
+					switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
+						case Edge_X0Y1:
+						case Edge_X1Y1:
+						case Edge_X2Y1:
+							land = Routing_Citizen_0_Road;
+							break;
+					}
+				} else {
+					switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
+						case Edge_X1Y0:
+						case Edge_X1Y1:
+						case Edge_X1Y2:
+							land = Routing_Citizen_0_Road;
+							break;
+					}
+				}
+				break;
+			case BUILDING_GRANARY:
+				switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
+					case Edge_X1Y0:
+					case Edge_X0Y1:
+					case Edge_X1Y1:
+					case Edge_X2Y1:
+					case Edge_X1Y2:
+						land = Routing_Citizen_0_Road;
+						break;
+				}
+				break;
+			case BUILDING_RESERVOIR:
+				switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
+					case Edge_X1Y0:
+					case Edge_X0Y1:
+					case Edge_X2Y1:
+					case Edge_X1Y2:
+						land = Routing_Citizen_m4_ReservoirConnector; // aqueduct connect points
+						break;
+				}
+				break;
+		}
+		return land;
+	} else if (Data_Grid_terrain[gridOffset] & Terrain_Aqueduct) {
+		int graphicId = Data_Grid_graphicIds[gridOffset] - image_group(ID_Graphic_Aqueduct);
+		int land;
+		if (graphicId <= 3) {
+			land = Routing_Citizen_m3_Aqueduct;
+		} else if (graphicId <= 7) {
+			land = Routing_Citizen_m1_Blocked;
+		} else if (graphicId <= 9) {
+			land = Routing_Citizen_m3_Aqueduct;
+		} else if (graphicId <= 14) {
+			land = Routing_Citizen_m1_Blocked;
+		} else if (graphicId <= 18) {
+			land = Routing_Citizen_m3_Aqueduct;
+		} else if (graphicId <= 22) {
+			land = Routing_Citizen_m1_Blocked;
+		} else if (graphicId <= 24) {
+			land = Routing_Citizen_m3_Aqueduct;
+		} else {
+			land = Routing_Citizen_m1_Blocked;
+		}
+		return land;
+	} else if (Data_Grid_terrain[gridOffset] & Terrain_NotClear) {
+		return Routing_Citizen_m1_Blocked;
+	} else {
+		return Routing_Citizen_4_ClearTerrain;
+	}
+}
+
 void Routing_determineLandCitizen()
 {
+	++terrainVersion;
 	memset(Data_Grid_routingLandCitizen, -1, GRID_SIZE * GRID_SIZE);
 	int gridOffset = Data_Settings_Map.gridStartOffset;
 	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
 		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
-			if (Data_Grid_terrain[gridOffset] & Terrain_Road) {
-				Data_Grid_routingLandCitizen[gridOffset] = Routing_Citizen_0_Road;
-			} else if (Data_Grid_terrain[gridOffset] & (Terrain_Rubble | Terrain_AccessRamp | Terrain_Garden)) {
-				Data_Grid_routingLandCitizen[gridOffset] = Routing_Citizen_2_PassableTerrain;
-			} else if (Data_Grid_terrain[gridOffset] & (Terrain_Building | Terrain_Gatehouse)) {
-				int buildingId = Data_Grid_buildingIds[gridOffset];
-				if (!buildingId) {
-					// shouldn't happen
-					Data_Grid_routingLandNonCitizen[gridOffset] = 4; // BUG: should be citizen?
-					Data_Grid_terrain[gridOffset] &= ~Terrain_Building; // remove 8 = building
-					Data_Grid_graphicIds[gridOffset] = (Data_Grid_random[gridOffset] & 7) + image_group(ID_Graphic_TerrainGrass1);
-					Data_Grid_edge[gridOffset] = Edge_LeftmostTile;
-					Data_Grid_bitfields[gridOffset] &= 0xf0; // remove sizes
-					continue;
-				}
-				int land = Routing_Citizen_m1_Blocked;
-				switch (Data_Buildings[buildingId].type) {
-					case BUILDING_WAREHOUSE:
-					case BUILDING_GATEHOUSE:
-						land = Routing_Citizen_0_Road;
-						break;
-					case BUILDING_FORT_GROUND:
-						land = Routing_Citizen_2_PassableTerrain;
-						break;
-					case BUILDING_TRIUMPHAL_ARCH:
-						if (Data_Buildings[buildingId].subtype.orientation == 3) {
-							switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
-								case Edge_X0Y1:
-								case Edge_X1Y1:
-								case Edge_X2Y1:
-									land = Routing_Citizen_0_Road;
-									break;
-							}
-						} else {
-							switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
-								case Edge_X1Y0:
-								case Edge_X1Y1:
-								case Edge_X1Y2:
-									land = Routing_Citizen_0_Road;
-									break;
-							}
-						}
-						break;
-					case BUILDING_GRANARY:
-						switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
-							case Edge_X1Y0:
-							case Edge_X0Y1:
-							case Edge_X1Y1:
-							case Edge_X2Y1:
-							case Edge_X1Y2:
-								land = Routing_Citizen_0_Road;
-								break;
-						}
-						break;
-					case BUILDING_RESERVOIR:
-						switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
-							case Edge_X1Y0:
-							case Edge_X0Y1:
-							case Edge_X2Y1:
-							case Edge_X1Y2:
-								land = Routing_Citizen_m4_ReservoirConnector; // aqueduct connect points
-								break;
-						}
+			Data_Grid_routingLandCitizen[gridOffset] = landCitizenTile(gridOffset);
+		}
+	}
+	Routing_updateEntryDistance();
+}
+
+static int landNonCitizenTile(int gridOffset)
+{
+	int terrain = Data_Grid_terrain[gridOffset] & Terrain_NotClear;
+	if (Data_Grid_terrain[gridOffset] & Terrain_Gatehouse) {
+		return Routing_NonCitizen_4_Gatehouse;
+	} else if (terrain & Terrain_Road) {
+		return Routing_NonCitizen_0_Passable;
+	} else if (terrain & (Terrain_Garden | Terrain_AccessRamp | Terrain_Rubble)) {
+		return Routing_NonCitizen_2_Clearable;
+	} else if (terrain & Terrain_Building) {
+		int land = Routing_NonCitizen_1_Building;
+		switch (Data_Buildings[Data_Grid_buildingIds[gridOffset]].type) {
+			case BUILDING_WAREHOUSE:
+			case BUILDING_FORT_GROUND:
+				land = Routing_NonCitizen_0_Passable;
+				break;
+			case BUILDING_BURNING_RUIN:
+			case BUILDING_NATIVE_HUT:
+			case BUILDING_NATIVE_MEETING:
+			case BUILDING_NATIVE_CROPS:
+				land = Routing_NonCitizen_m1_Blocked;
+				break;
+			case BUILDING_FORT:
+				land = Routing_NonCitizen_5_Fort;
+				break;
+			case BUILDING_GRANARY:
+				switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
+					case Edge_X1Y0:
+					case Edge_X0Y1:
+					case Edge_X1Y1:
+					case Edge_X2Y1:
+					case Edge_X1Y2:
+						land = Routing_NonCitizen_0_Passable;
 						break;
 				}
-				Data_Grid_routingLandCitizen[gridOffset] = land;
-			} else if (Data_Grid_terrain[gridOffset] & Terrain_Aqueduct) {
-				int graphicId = Data_Grid_graphicIds[gridOffset] - image_group(ID_Graphic_Aqueduct);
-				int land;
-				if (graphicId <= 3) {
-					land = Routing_Citizen_m3_Aqueduct;
-				} else if (graphicId <= 7) {
-					land = Routing_Citizen_m1_Blocked;
-				} else if (graphicId <= 9) {
-					land = Routing_Citizen_m3_Aqueduct;
-				} else if (graphicId <= 14) {
-					land = Routing_Citizen_m1_Blocked;
-				} else if (graphicId <= 18) {
-					land = Routing_Citizen_m3_Aqueduct;
-				} else if (graphicId <= 22) {
-					land = Routing_Citizen_m1_Blocked;
-				} else if (graphicId <= 24) {
-					land = Routing_Citizen_m3_Aqueduct;
-				} else {
-					land = Routing_Citizen_m1_Blocked;
-				}
-				Data_Grid_routingLandCitizen[gridOffset] = land;
-			} else if (Data_Grid_terrain[gridOffset] & Terrain_NotClear) {
-				Data_Grid_routingLandCitizen[gridOffset] = Routing_Citizen_m1_Blocked;
-			} else {
-				Data_Grid_routingLandCitizen[gridOffset] = Routing_Citizen_4_ClearTerrain;
-			}
+				break;
 		}
+		return land;
+	} else if (Data_Grid_terrain[gridOffset] & Terrain_Aqueduct) {
+		return Routing_NonCitizen_2_Clearable;
+	} else if (Data_Grid_terrain[gridOffset] & Terrain_Wall) {
+		return Routing_NonCitizen_3_Wall;
+	} else if (Data_Grid_terrain[gridOffset] & Terrain_NotClear) {
+		return Routing_NonCitizen_m1_Blocked;
+	} else {
+		return Routing_NonCitizen_0_Passable;
 	}
 }
 
 void Routing_determineLandNonCitizen()
 {
+	++terrainVersion;
 	memset(Data_Grid_routingLandNonCitizen, -1, GRID_SIZE * GRID_SIZE);
 	int gridOffset = Data_Settings_Map.gridStartOffset;
 	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
 		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
-			int terrain = Data_Grid_terrain[gridOffset] & Terrain_NotClear;
-			if (Data_Grid_terrain[gridOffset] & Terrain_Gatehouse) {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_4_Gatehouse;
-			} else if (terrain & Terrain_Road) {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_0_Passable;
-			} else if (terrain & (Terrain_Garden | Terrain_AccessRamp | Terrain_Rubble)) {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_2_Clearable;
-			} else if (terrain & Terrain_Building) {
-				int land = Routing_NonCitizen_1_Building;
-				switch (Data_Buildings[Data_Grid_buildingIds[gridOffset]].type) {
-					case BUILDING_WAREHOUSE:
-					case BUILDING_FORT_GROUND:
-						land = Routing_NonCitizen_0_Passable;
-						break;
-					case BUILDING_BURNING_RUIN:
-					case BUILDING_NATIVE_HUT:
-					case BUILDING_NATIVE_MEETING:
-					case BUILDING_NATIVE_CROPS:
-						land = Routing_NonCitizen_m1_Blocked;
-						break;
-					case BUILDING_FORT:
-						land = Routing_NonCitizen_5_Fort;
-						break;
-					case BUILDING_GRANARY:
-						switch (Data_Grid_edge[gridOffset] & Edge_MaskXY) {
-							case Edge_X1Y0:
-							case Edge_X0Y1:
-							case Edge_X1Y1:
-							case Edge_X2Y1:
-							case Edge_X1Y2:
-								land = Routing_NonCitizen_0_Passable;
-								break;
-						}
-						break;
+			Data_Grid_routingLandNonCitizen[gridOffset] = landNonCitizenTile(gridOffset);
+		}
+	}
+}
+
+void Routing_markLandDirty(int x, int y, int size)
+{
+	int xMin = x < 0 ? 0 : x;
+	int yMin = y < 0 ? 0 : y;
+	int xMax = x + size - 1;
+	int yMax = y + size - 1;
+	if (xMax >= Data_Settings_Map.width) {
+		xMax = Data_Settings_Map.width - 1;
+	}
+	if (yMax >= Data_Settings_Map.height) {
+		yMax = Data_Settings_Map.height - 1;
+	}
+	if (xMin > xMax || yMin > yMax) {
+		return;
+	}
+	if (dirtyLand.numAreas > 0) {
+		// grow the last area when that does not add much, so dragged houses end up in one area
+		int last = dirtyLand.numAreas - 1;
+		int xMinUnion = xMin < dirtyLand.areas[last].xMin ? xMin : dirtyLand.areas[last].xMin;
+		int yMinUnion = yMin < dirtyLand.areas[last].yMin ? yMin : dirtyLand.areas[last].yMin;
+		int xMaxUnion = xMax > dirtyLand.areas[last].xMax ? xMax : dirtyLand.areas[last].xMax;
+		int yMaxUnion = yMax > dirtyLand.areas[last].yMax ? yMax : dirtyLand.areas[last].yMax;
+		int unionTiles = (xMaxUnion - xMinUnion + 1) * (yMaxUnion - yMinUnion + 1);
+		int separateTiles = (xMax - xMin + 1) * (yMax - yMin + 1) +
+			(dirtyLand.areas[last].xMax - dirtyLand.areas[last].xMin + 1) *
+			(dirtyLand.areas[last].yMax - dirtyLand.areas[last].yMin + 1);
+		if (unionTiles <= 2 * separateTiles) {
+			dirtyLand.areas[last].xMin = xMinUnion;
+			dirtyLand.areas[last].yMin = yMinUnion;
+			dirtyLand.areas[last].xMax = xMaxUnion;
+			dirtyLand.areas[last].yMax = yMaxUnion;
+			return;
+		}
+	}
+	if (dirtyLand.numAreas >= MAX_DIRTY_LAND_AREAS) {
+		dirtyLand.overflow = 1;
+		return;
+	}
+	dirtyLand.areas[dirtyLand.numAreas].xMin = xMin;
+	dirtyLand.areas[dirtyLand.numAreas].yMin = yMin;
+	dirtyLand.areas[dirtyLand.numAreas].xMax = xMax;
+	dirtyLand.areas[dirtyLand.numAreas].yMax = yMax;
+	dirtyLand.numAreas++;
+}
+
+static void verifyLand()
+{
+	int mismatch = 0;
+	int gridOffset = Data_Settings_Map.gridStartOffset;
+	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
+		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
+			int citizen = landCitizenTile(gridOffset);
+			int nonCitizen = landNonCitizenTile(gridOffset);
+			if (Data_Grid_routingLandCitizen[gridOffset] != citizen) {
+				TRACE_ERROR(TRACE_EVENT_ROUTING_GRID_MISMATCH, gridOffset, 0,
+					Data_Grid_routingLandCitizen[gridOffset], citizen);
+				mismatch = 1;
+			}
+			if (Data_Grid_routingLandNonCitizen[gridOffset] != nonCitizen) {
+				TRACE_ERROR(TRACE_EVENT_ROUTING_GRID_MISMATCH, gridOffset, 1,
+					Data_Grid_routingLandNonCitizen[gridOffset], nonCitizen);
+				mismatch = 1;
+			}
+		}
+	}
+	if (mismatch) {
+		Routing_determineLandCitizen();
+		Routing_determineLandNonCitizen();
+	}
+}
+
+void Routing_updateLand()
+{
+	if (dirtyLand.overflow) {
+		Routing_determineLandCitizen();
+		Routing_determineLandNonCitizen();
+	} else if (dirtyLand.numAreas > 0) {
+		++terrainVersion;
+		for (int i = 0; i < dirtyLand.numAreas; i++) {
+			for (int y = dirtyLand.areas[i].yMin; y <= dirtyLand.areas[i].yMax; y++) {
+				for (int x = dirtyLand.areas[i].xMin; x <= dirtyLand.areas[i].xMax; x++) {
+					int gridOffset = GridOffset(x, y);
+					Data_Grid_routingLandCitizen[gridOffset] = landCitizenTile(gridOffset);
+					Data_Grid_routingLandNonCitizen[gridOffset] = landNonCitizenTile(gridOffset);
 				}
-				Data_Grid_routingLandNonCitizen[gridOffset] = land;
-			} else if (Data_Grid_terrain[gridOffset] & Terrain_Aqueduct) {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_2_Clearable;
-			} else if (Data_Grid_terrain[gridOffset] & Terrain_Wall) {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_3_Wall;
-			} else if (Data_Grid_terrain[gridOffset] & Terrain_NotClear) {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_m1_Blocked;
-			} else {
-				Data_Grid_routingLandNonCitizen[gridOffset] = Routing_NonCitizen_0_Passable;
 			}
 		}
+		Routing_updateEntryDistance();
+	}
+	dirtyLand.numAreas = 0;
+	dirtyLand.overflow = 0;
+	if (ROUTING_VERIFY_UPDATES) {
+		verifyLand();
 	}
 }
 
 void Routing_determineWater()
 {
+	++terrainVersion;
 	memset(Data_Grid_routingWater, -1, GRID_SIZE * GRID_SIZE);
 	int gridOffset = Data_Settings_Map.gridStartOffset;
 	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
 		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
 			if (Data_Grid_terrain[gridOffset] & Terrain_Water) {
-				if ((Data_Grid_terrain[gridOffset - 162] & Terrain_Water) &&
+				if ((Data_Grid_terrain[gridOffset - GRID_SIZE] & Terrain_Water) &&
 					(Data_Grid_terrain[gridOffset - 1] & Terrain_Water) &&
 					(Data_Grid_terrain[gridOffset + 1] & Terrain_Water) &&
-					(Data_Grid_terrain[gridOffset + 162] & Terrain_Water)) {
+					(Data_Grid_terrain[gridOffset + GRID_SIZE] & Terrain_Water)) {
 					if (x > 0 && x < Data_Settings_Map.width - 1 &&
 						y > 0 && y < Data_Settings_Map.height - 1) {
 						switch (Data_Grid_spriteOffsets[gridOffset]) {
@@ -420,6 +723,7 @@ void Routing_determineWater()
 
 void Routing_determineWalls()
 {
+	++terrainVersion;
 	memset(Data_Grid_routingWalls, -1, GRID_SIZE * GRID_SIZE);
 	int gridOffset = Data_Settings_Map.gridStartOffset;
 	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
@@ -428,10 +732,10 @@ void Routing_determineWalls()
 				int adjacent = 0;
 				switch (Data_Settings_Map.orientation) {
 					case Dir_0_Top:
-						if (Data_Grid_terrain[gridOffset + 162] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset + GRID_SIZE] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
-						if (Data_Grid_terrain[gridOffset + 163] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset + GRID_SIZE + 1] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
 						if (Data_Grid_terrain[gridOffset + 1] & Terrain_WallOrGatehouse) {
@@ -439,10 +743,10 @@ void Routing_determineWalls()
 						}
 						break;
 					case Dir_2_Right:
-						if (Data_Grid_terrain[gridOffset + 162] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset + GRID_SIZE] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
-						if (Data_Grid_terrain[gridOffset + 161] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset + GRID_SIZE - 1] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
 						if (Data_Grid_terrain[gridOffset - 1] & Terrain_WallOrGatehouse) {
@@ -450,10 +754,10 @@ void Routing_determineWalls()
 						}
 						break;
 					case Dir_4_Bottom:
-						if (Data_Grid_terrain[gridOffset - 162] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset - GRID_SIZE] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
-						if (Data_Grid_terrain[gridOffset - 163] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset - GRID_SIZE - 1] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
 						if (Data_Grid_terrain[gridOffset - 1] & Terrain_WallOrGatehouse) {
@@ -461,10 +765,10 @@ void Routing_determineWalls()
 						}
 						break;
 					case Dir_6_Left:
-						if (Data_Grid_terrain[gridOffset - 162] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset - GRID_SIZE] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
-						if (Data_Grid_terrain[gridOffset - 161] & Terrain_WallOrGatehouse) {
+						if (Data_Grid_terrain[gridOffset - GRID_SIZE + 1] & Terrain_WallOrGatehouse) {
 							adjacent++;
 						}
 						if (Data_Grid_terrain[gridOffset + 1] & Terrain_WallOrGatehouse) {
@@ -488,12 +792,19 @@ void Routing_determineWalls()
 
 void Routing_clearLandTypeCitizen()
 {
+	++terrainVersion;
 	int gridOffset = 0;
 	for (int y = 0; y < GRID_SIZE; y++) {
 		for (int x = 0; x < GRID_SIZE; x++) {
 			Data_Grid_routingLandCitizen[gridOffset++] = Routing_Citizen_m1_Blocked;
 		}
 	}
+	Routing_updateEntryDistance();
+}
+
+int Routing_getTerrainVersion()
+{
+	return terrainVersion;
 }
 
 static void callbackGetDistance(int nextOffset, int dist)
@@ -512,7 +823,7 @@ void Routing_getDistance(int x, int y)
 
 int Routing_getCalculatedDistance(int gridOffset)
 {
-	return Data_Grid_routingDistance[gridOffset];
+	return getDistance(gridOffset);
 }
 
 static int callbackDeleteClosestWallOrAqueduct(int nextOffset, int dist)
@@ -578,7 +889,7 @@ int Routing_canTravelOverLandCitizen(int xSrc, int ySrc, int xDst, int yDst)
 	int destOffset = GridOffset(xDst, yDst);
 	++Data_Routes.totalRoutesCalculated;
 	routeQueue(sourceOffset, destOffset, callbackCanTravelOverLandCitizen);
-	return Data_Grid_routingDistance[destOffset] != 0;
+	return getDistance(destOffset) != 0;
 }
 
 static void callbackCanTravelOverRoadGardenCitizen(int nextOffset, int dist)
@@ -595,7 +906,7 @@ int Routing_canTravelOverRoadGardenCitizen(int xSrc, int ySrc, int xDst, int yDs
 	int destOffset = GridOffset(xDst, yDst);
 	++Data_Routes.totalRoutesCalculated;
 	routeQueue(sourceOffset, destOffset, callbackCanTravelOverRoadGardenCitizen);
-	return Data_Grid_routingDistance[destOffset] != 0;
+	return getDistance(destOffset) != 0;
 }
 
 static void callbackCanTravelOverWalls(int nextOffset, int dist)
@@ -612,7 +923,7 @@ int Routing_canTravelOverWalls(int xSrc, int ySrc, int xDst, int yDst)
 	int destOffset = GridOffset(xDst, yDst);
 	++Data_Routes.totalRoutesCalculated;
 	routeQueue(sourceOffset, destOffset, callbackCanTravelOverWalls);
-	return Data_Grid_routingDistance[destOffset] != 0;
+	return getDistance(destOffset) != 0;
 }
 
 static void callbackCanTravelOverLandNonCitizenThroughBuilding(int nextOffset, int dist)
@@ -649,7 +960,7 @@ int Routing_canTravelOverLandNonCitizen(int xSrc, int ySrc, int xDst, int yDst,
 	} else {
 		routeQueueMax(sourceOffset, destOffset, maxTiles, callbackCanTravelOverLandNonCitizen);
 	}
-	return Data_Grid_routingDistance[destOffset] != 0;
+	return getDistance(destOffset) != 0;
 }
 
 static void callbackCanTravelThroughEverythingNonCitizen(int nextOffset, int dist)
@@ -665,7 +976,62 @@ int Routing_canTravelThroughEverythingNonCitizen(int xSrc, int ySrc, int xDst, i
 	int destOffset = GridOffset(xDst, yDst);
 	++Data_Routes.totalRoutesCalculated;
 	routeQueue(sourceOffset, destOffset, callbackCanTravelThroughEverythingNonCitizen);
-	return Data_Grid_routingDistance[destOffset] != 0;
+	return getDistance(destOffset) != 0;
+}
+
+int Routing_findRouteOverLandCitizen(int xSrc, int ySrc, int xDst, int yDst)
+{
+	++Data_Routes.totalRoutesCalculated;
+	return routeToDestination(GridOffset(xSrc, ySrc), GridOffset(xDst, yDst),
+		callbackCanTravelOverLandCitizen);
+}
+
+int Routing_findRouteOverRoadGardenCitizen(int xSrc, int ySrc, int xDst, int yDst)
+{
+	++Data_Routes.totalRoutesCalculated;
+	return routeToDestination(GridOffset(xSrc, ySrc), GridOffset(xDst, yDst),
+		callbackCanTravelOverRoadGardenCitizen);
+}
+
+int Routing_findRouteOverWalls(int xSrc, int ySrc, int xDst, int yDst)
+{
+	++Data_Routes.totalRoutesCalculated;
+	return routeToDestination(GridOffset(xSrc, ySrc), GridOffset(xDst, yDst),
+		callbackCanTravelOverWalls);
+}
+
+int Routing_findRouteOverLandNonCitizen(int xSrc, int ySrc, int xDst, int yDst, int onlyThroughBuildingId, int maxTiles)
+{
+	int sourceOffset = GridOffset(xSrc, ySrc);
+	int destOffset = GridOffset(xDst, yDst);
+	++Data_Routes.totalRoutesCalculated;
+	++Data_Routes.enemyRoutesCalculated;
+	if (onlyThroughBuildingId) {
+		state.throughBuildingId = onlyThroughBuildingId;
+		return routeToDestination(sourceOffset, destOffset,
+			callbackCanTravelOverLandNonCitizenThroughBuilding);
+	}
+	// the flood fill gives up after maxTiles tiles: only trust the search
+	// when all tiles the flood fill takes before the destination fit within that limit
+	int found = -1;
+	if (map_route_limit_tiles_before(calc_total_distance(xSrc, ySrc, xDst, yDst) + 1) <= maxTiles) {
+		found = routeSearch(sourceOffset, destOffset, 4, maxTiles, callbackCanTravelOverLandNonCitizen);
+		if (found > 0 && map_route_limit_tiles_before(getDistance(destOffset)) > maxTiles) {
+			found = -1;
+		}
+	}
+	if (found < 0) {
+		routeQueueMax(sourceOffset, destOffset, maxTiles, callbackCanTravelOverLandNonCitizen);
+		found = getDistance(destOffset) != 0;
+	}
+	return found;
+}
+
+int Routing_findRouteThroughEverythingNonCitizen(int xSrc, int ySrc, int xDst, int yDst)
+{
+	++Data_Routes.totalRoutesCalculated;
+	return routeToDestination(GridOffset(xSrc, ySrc), GridOffset(xDst, yDst),
+		callbackCanTravelThroughEverythingNonCitizen);
 }
 
 int Routing_canPlaceRoadUnderAqueduct(int gridOffset)
@@ -696,21 +1062,21 @@ int Routing_canPlaceRoadUnderAqueduct(int gridOffset)
 		checkRoadY = !checkRoadY;
 	}
 	if (checkRoadY) {
-		if ((Data_Grid_terrain[gridOffset - 162] & Terrain_Road) ||
-			Data_Grid_routingDistance[gridOffset - 162] > 0) {
+		if ((Data_Grid_terrain[gridOffset - GRID_SIZE] & Terrain_Road) ||
+			getDistance(gridOffset - GRID_SIZE) > 0) {
 			return 0;
 		}
-		if ((Data_Grid_terrain[gridOffset + 162] & Terrain_Road) ||
-			Data_Grid_routingDistance[gridOffset + 162] > 0) {
+		if ((Data_Grid_terrain[gridOffset + GRID_SIZE] & Terrain_Road) ||
+			getDistance(gridOffset + GRID_SIZE) > 0) {
 			return 0;
 		}
 	} else {
 		if ((Data_Grid_terrain[gridOffset - 1] & Terrain_Road) ||
-			Data_Grid_routingDistance[gridOffset - 1] > 0) {
+			getDistance(gridOffset - 1) > 0) {
 			return 0;
 		}
 		if ((Data_Grid_terrain[gridOffset + 1] & Terrain_Road) ||
-			Data_Grid_routingDistance[gridOffset + 1] > 0) {
+			getDistance(gridOffset + 1) > 0) {
 			return 0;
 		}
 	}
@@ -754,13 +1120,13 @@ static int canPlaceAqueductOnRoad(int gridOffset)
 		checkRoadY = !checkRoadY;
 	}
 	if (checkRoadY) {
-		if (Data_Grid_routingDistance[gridOffset - 162] > 0 ||
-			Data_Grid_routingDistance[gridOffset + 162] > 0) {
+		if (getDistance(gridOffset - GRID_SIZE) > 0 ||
+			getDistance(gridOffset + GRID_SIZE) > 0) {
 			return 0;
 		}
 	} else {
-		if (Data_Grid_routingDistance[gridOffset - 1] > 0 ||
-			Data_Grid_routingDistance[gridOffset + 1] > 0) {
+		if (getDistance(gridOffset - 1) > 0 ||
+			getDistance(gridOffset + 1) > 0) {
 			return 0;
 		}
 	}
@@ -809,7 +1175,7 @@ static void callbackGetDistanceForBuildingRoadOrAqueduct(int nextOffset, int dis
 			if (state.isAqueduct) {
 				blocked = 1;
 			} else if (!Routing_canPlaceRoadUnderAqueduct(nextOffset)) {
-				Data_Grid_routingDistance[nextOffset] = -1;
+				setDistance(nextOffset, -1);
 				blocked = 1;
 			}
 			break;
@@ -828,7 +1194,7 @@ static void callbackGetDistanceForBuildingRoadOrAqueduct(int nextOffset, int dis
 	}
 	if (Data_Grid_terrain[nextOffset] & Terrain_Road) {
 		if (state.isAqueduct && !canPlaceAqueductOnRoad(nextOffset)) {
-			Data_Grid_routingDistance[nextOffset] = -1;
+			setDistance(nextOffset, -1);
 			blocked = 1;
 		}
 	}
@@ -887,7 +1253,7 @@ int Routing_placeRoutedBuilding(int xSrc, int ySrc, int xDst, int yDst, RoutedBu
 		if (++guard >= 400) {
 			return 0;
 		}
-		int distance = Data_Grid_routingDistance[gridOffset];
+		int distance = getDistance(gridOffset);
 		if (distance <= 0) {
 			return 0;
 		}
@@ -914,7 +1280,7 @@ int Routing_placeRoutedBuilding(int xSrc, int ySrc, int xDst, int yDst, RoutedBu
 		for (int i = 0; i < 4; i++) {
 			int index = directionIndices[direction][i];
 			int newGridOffset = gridOffset + Constant_DirectionGridOffsets[index];
-			int newDist = Data_Grid_routingDistance[newGridOffset];
+			int newDist = getDistance(newGridOffset);
 			if (newDist > 0 && newDist < distance) {
 				gridOffset = newGridOffset;
 				xDst = GridOffsetToX(gridOffset);
@@ -1100,12 +1466,12 @@ static void updateXYGridOffsetForDirection(int direction, int *x, int *y, int *g
 	switch (direction) {
 		case Dir_0_Top:
 			--(*y);
-			(*gridOffset) -= 162;
+			(*gridOffset) -= GRID_SIZE;
 			break;
 		case Dir_1_TopRight:
 			++(*x);
 			--(*y);
-			(*gridOffset) -= 161;
+			(*gridOffset) -= GRID_SIZE - 1;
 			break;
 		case Dir_2_Right:
 			++(*x);
@@ -1114,16 +1480,16 @@ static void updateXYGridOffsetForDirection(int direction, int *x, int *y, int *g
 		case Dir_3_BottomRight:
 			++(*x);
 			++(*y);
-			(*gridOffset) += 163;
+			(*gridOffset) += GRID_SIZE + 1;
 			break;
 		case Dir_4_Bottom:
 			++(*y);
-			(*gridOffset) += 162;
+			(*gridOffset) += GRID_SIZE;
 			break;
 		case Dir_5_BottomLeft:
 			--(*x);
 			++(*y);
-			(*gridOffset) += 161;
+			(*gridOffset) += GRID_SIZE - 1;
 			break;
 		case Dir_6_Left:
 			--(*x);
@@ -1132,7 +1498,7 @@ static void updateXYGridOffsetForDirection(int direction, int *x, int *y, int *g
 		case Dir_7_TopLeft:
 			--(*x);
 			--(*y);
-			(*gridOffset) -= 163;
+			(*gridOffset) -= GRID_SIZE + 1;
 			break;
 	}
 }
@@ -1143,7 +1509,7 @@ static void callbackGetDistanceWaterBoat(int nextOffset, int dist)
 		Data_Grid_routingWater[nextOffset] != Routing_Water_m3_LowBridge) {
 		setDistAndEnqueue(nextOffset, dist);
 		if (Data_Grid_routingWater[nextOffset] == Routing_Water_m2_MapEdge) {
-			Data_Grid_routingDistance[nextOffset] += 4;
+			setDistance(nextOffset, getDistance(nextOffset) + 4);
 		}
 	}
 }
@@ -1173,10 +1539,22 @@ void Routing_getDistanceWaterFlotsam(int x, int y)
 	routeQueueDir8(sourceGridOffset, callbackGetDistanceWaterFlotsam);
 }
 
+void Routing_findRouteWaterFlotsam(int xSrc, int ySrc, int xDst, int yDst)
+{
+	int sourceGridOffset = GridOffset(xSrc, ySrc);
+	if (Data_Grid_routingWater[sourceGridOffset] == Routing_Water_m1_Blocked) {
+		return;
+	}
+	if (routeSearch(sourceGridOffset, GridOffset(xDst, yDst), 8, MAX_QUEUE,
+			callbackGetDistanceWaterFlotsam) < 0) {
+		routeQueueDir8(sourceGridOffset, callbackGetDistanceWaterFlotsam);
+	}
+}
+
 int Routing_getPath(int numDirections, int routingPathId, int xSrc, int ySrc, int xDst, int yDst)
 {
 	int dstGridOffset = GridOffset(xDst, yDst);
-	int distance = Data_Grid_routingDistance[dstGridOffset];
+	int distance = getDistance(dstGridOffset);
 	if (distance <= 0 || distance >= 998) {
 		return 0;
 	}
@@ -1189,13 +1567,13 @@ int Routing_getPath(int numDirections, int routingPathId, int xSrc, int ySrc, in
 	int step = numDirections == 8 ? 1 : 2;
 
 	while (distance > 1) {
-		distance = Data_Grid_routingDistance[gridOffset];
+		distance = getDistance(gridOffset);
 		int direction = -1;
 		int generalDirection = Routing_getGeneralDirection(x, y, xSrc, ySrc);
 		for (int d = 0; d < 8; d += step) {
 			if (d != lastDirection) {
 				int nextOffset = gridOffset + Constant_DirectionGridOffsets[d];
-				int nextDistance = Data_Grid_routingDistance[nextOffset];
+				int nextDistance = getDistance(nextOffset);
 				if (nextDistance) {
 					if (nextDistance < distance) {
 						distance = nextDistance;
@@ -1227,7 +1605,7 @@ int Routing_getPath(int numDirections, int routingPathId, int xSrc, int ySrc, in
 int Routing_getClosestXYWithinRange(int numDirections, int xSrc, int ySrc, int xDst, int yDst, int range, int *xOut, int *yOut)
 {
 	int dstGridOffset = GridOffset(xDst, yDst);
-	int distance = Data_Grid_routingDistance[dstGridOffset];
+	int distance = getDistance(dstGridOffset);
 	if (distance <= 0 || distance >= 998) {
 		return 0;
 	}
@@ -1240,7 +1618,7 @@ int Routing_getClosestXYWithinRange(int numDirections, int xSrc, int ySrc, int x
 	int step = numDirections == 8 ? 1 : 2;
 
 	while (distance > 1) {
-		distance = Data_Grid_routingDistance[gridOffset];
+		distance = getDistance(gridOffset);
 		*xOut = x;
 		*yOut = y;
 		if (distance <= range) {
@@ -1251,7 +1629,7 @@ int Routing_getClosestXYWithinRange(int numDirections, int xSrc, int ySrc, int x
 		for (int d = 0; d < 8; d += step) {
 			if (d != lastDirection) {
 				int nextOffset = gridOffset + Constant_DirectionGridOffsets[d];
-				int nextDistance = Data_Grid_routingDistance[nextOffset];
+				int nextDistance = getDistance(nextOffset);
 				if (nextDistance) {
 					if (nextDistance < distance) {
 						distance = nextDistance;
@@ -1281,7 +1659,7 @@ int Routing_getPathOnWater(int routingPathId, int xSrc, int ySrc, int xDst, int
 {
 	int rand = random_byte() & 3;
 	int dstGridOffset = GridOffset(xDst, yDst);
-	int distance = Data_Grid_routingDistance[dstGridOffset];
+	int distance = getDistance(dstGridOffset);
 	if (distance <= 0 || distance >= 998) {
 		return 0;
 	}
@@ -1293,7 +1671,7 @@ int Routing_getPathOnWater(int routingPathId, int xSrc, int ySrc, int xDst, int
 	int gridOffset = dstGridOffset;
 	while (distance > 1) {
 		int currentRand = rand;
-		distance = Data_Grid_routingDistance[gridOffset];
+		distance = getDistance(gridOffset);
 		if (isFlotsam) {
 			currentRand = Data_Grid_random[gridOffset] & 3;
 		}
@@ -1301,7 +1679,7 @@ int Routing_getPathOnWater(int routingPathId, int xSrc, int ySrc, int xDst, int
 		for (int d = 0; d < 8; d++) {
 			if (d != lastDirection) {
 				int nextOffset = gridOffset + Constant_DirectionGridOffsets[d];
-				int nextDistance = Data_Grid_routingDistance[nextOffset];
+				int nextDistance = getDistance(nextOffset);
 				if (nextDistance) {
 					if (nextDistance < distance) {
 						distance = nextDistance;
@@ -1338,7 +1716,7 @@ void Routing_block(int x, int y, int size)
 	}
 	for (int dy = 0; dy < size; dy++) {
 		for (int dx = 0; dx < size; dx++) {
-			Data_Grid_routingDistance[GridOffset(x+dx, y+dy)] = 0;
+			setDistance(GridOffset(x+dx, y+dy), 0);
 		}
 	}
 }
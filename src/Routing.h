@@ -28,14 +28,24 @@ enum {
 
 void Routing_determineLandCitizen();
 void Routing_determineLandNonCitizen();
+
+// partial update of both land grids: mark the changed tiles, then update once
+void Routing_markLandDirty(int x, int y, int size);
+void Routing_updateLand();
 void Routing_determineWater();
 void Routing_determineWalls();
 
 void Routing_clearLandTypeCitizen();
 
+int Routing_getTerrainVersion();
+
 void Routing_getDistance(int x, int y);
 int Routing_getCalculatedDistance(int gridOffset);
 
+// distances from the city entry point, kept up to date when the citizen land grid changes
+void Routing_updateEntryDistance();
+int Routing_getEntryDistance(int gridOffset);
+
 void Routing_deleteClosestWallOrAqueduct(int x, int y);
 
 int Routing_canTravelOverLandCitizen(int xSrc, int ySrc, int xDst, int yDst);
@@ -44,6 +54,14 @@ int Routing_canTravelOverWalls(int xSrc, int ySrc, int xDst, int yDst);
 int Routing_canTravelOverLandNonCitizen(int xSrc, int ySrc, int xDst, int yDst, int onlyThroughBuildingId, int maxTiles);
 int Routing_canTravelThroughEverythingNonCitizen(int xSrc, int ySrc, int xDst, int yDst);
 
+// Same as the canTravel functions, but only calculate the distances that
+// Routing_getPath needs for the route to the destination
+int Routing_findRouteOverLandCitizen(int xSrc, int ySrc, int xDst, int yDst);
+int Routing_findRouteOverRoadGardenCitizen(int xSrc, int ySrc, int xDst, int yDst);
+int Routing_findRouteOverWalls(int xSrc, int ySrc, int xDst, int yDst);
+int Routing_findRouteOverLandNonCitizen(int xSrc, int ySrc, int xDst, int yDst, int onlyThroughBuildingId, int maxTiles);
+int Routing_findRouteThroughEverythingNonCitizen(int xSrc, int ySrc, int xDst, int yDst);
+
 int Routing_getPath(int numDirections, int routingPathId, int xSrc, int ySrc, int xDst, int yDst);
 
 int Routing_canPlaceRoadUnderAqueduct(int gridOffset);
@@ -68,6 +86,7 @@ int Routing_getDirectionForMissile(int xSrc, int ySrc, int xDst, int yDst);
 
 void Routing_getDistanceWaterBoat(int x, int y);
 void Routing_getDistanceWaterFlotsam(int x, int y);
+void Routing_findRouteWaterFlotsam(int xSrc, int ySrc, int xDst, int yDst);
 int Routing_getPathOnWater(int routingPathId, int xSrc, int ySrc, int xDst, int yDst, int isFlotsam);
 
 int Routing_getClosestXYWithinRange(int numDirections, int xSrc, int ySrc, int xDst, int yDst, int range, int *xOut, int *yOut);
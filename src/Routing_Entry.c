@@ -0,0 +1,241 @@
+#include "Routing.h"
+
+#include "Data/CityInfo.h"
+#include "Data/Grid.h"
+#include "Data/Settings.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Distances from the city entry point over citizen land, the same as
+// Routing_getDistance from the entry point would calculate. They are kept in
+// their own grid and repaired when the routing grid changes instead of
+// flooding the whole map every time.
+
+#define MAX_CHANGES_FOR_REPAIR (GRID_SIZE * GRID_SIZE / 8)
+
+typedef struct {
+	int gridOffset;
+	int dist;
+} tile_dist;
+
+static struct {
+	int source;
+	unsigned short distance[GRID_SIZE * GRID_SIZE];
+	unsigned char passable[GRID_SIZE * GRID_SIZE];
+	int numRemoved;
+	int numAdded;
+	tile_dist removed[GRID_SIZE * GRID_SIZE];
+	int added[GRID_SIZE * GRID_SIZE];
+	int numSeeds;
+	tile_dist seeds[GRID_SIZE * GRID_SIZE];
+	int head;
+	int tail;
+	tile_dist queue[2 * GRID_SIZE * GRID_SIZE];
+} data = {-1};
+
+static int isPassable(int gridOffset)
+{
+	return Data_Grid_routingLandCitizen[gridOffset] >= Routing_Citizen_0_Road;
+}
+
+static int compareTileDist(const void *a, const void *b)
+{
+	const tile_dist *ta = (const tile_dist*) a;
+	const tile_dist *tb = (const tile_dist*) b;
+	if (ta->dist != tb->dist) {
+		return ta->dist - tb->dist;
+	}
+	return ta->gridOffset - tb->gridOffset;
+}
+
+// Neighbours are the same as in the routing flood fill, including its bounds checks
+#define FOR_NEIGHBOURS(offset, next) \
+	for (int n_ = 0; n_ < 4; n_++) { \
+		int next = (offset) + neighbourOffsets[n_]; \
+		if (next < 0 || next >= GRID_SIZE * GRID_SIZE) continue;
+#define END_FOR_NEIGHBOURS }
+
+static const int neighbourOffsets[4] = {GridDelta(0, -1), 1, GridDelta(0, 1), -1};
+
+static void enqueue(int gridOffset, int dist)
+{
+	data.distance[gridOffset] = dist;
+	data.queue[data.tail].gridOffset = gridOffset;
+	data.queue[data.tail].dist = dist;
+	data.tail++;
+}
+
+static void relaxNeighbours(int gridOffset, int dist)
+{
+	FOR_NEIGHBOURS(gridOffset, next)
+		if (data.passable[next] && (!data.distance[next] || data.distance[next] > dist + 1)) {
+			enqueue(next, dist + 1);
+		}
+	END_FOR_NEIGHBOURS
+}
+
+// Lowers distances from the seeds outwards, handling seeds and queued tiles
+// in order of distance so every tile gets its final distance the first time
+static void propagateFromSeeds()
+{
+	qsort(data.seeds, data.numSeeds, sizeof(tile_dist), compareTileDist);
+	data.head = data.tail = 0;
+	int seed = 0;
+	while (seed < data.numSeeds || data.head < data.tail) {
+		tile_dist item;
+		if (seed < data.numSeeds &&
+			(data.head >= data.tail || data.seeds[seed].dist <= data.queue[data.head].dist)) {
+			item = data.seeds[seed++];
+			if (data.distance[item.gridOffset] && data.distance[item.gridOffset] <= item.dist) {
+				continue;
+			}
+			data.distance[item.gridOffset] = item.dist;
+		} else {
+			item = data.queue[data.head++];
+			if (data.distance[item.gridOffset] != item.dist) {
+				continue;
+			}
+		}
+		relaxNeighbours(item.gridOffset, item.dist);
+	}
+	data.numSeeds = 0;
+}
+
+static void addSeedFromNeighbours(int gridOffset)
+{
+	int best = 0;
+	FOR_NEIGHBOURS(gridOffset, next)
+		int dist = data.distance[next];
+		if (dist && (!best || dist < best)) {
+			best = dist;
+		}
+	END_FOR_NEIGHBOURS
+	if (best) {
+		data.seeds[data.numSeeds].gridOffset = gridOffset;
+		data.seeds[data.numSeeds].dist = best + 1;
+		data.numSeeds++;
+	}
+}
+
+static int hasSupport(int gridOffset, int dist)
+{
+	FOR_NEIGHBOURS(gridOffset, next)
+		if (data.distance[next] == dist - 1) {
+			return 1;
+		}
+	END_FOR_NEIGHBOURS
+	return 0;
+}
+
+// Clears the distances of all tiles whose shortest route went through a
+// removed tile and that have no other neighbour one step closer to the
+// entry, then calculates them again from the tiles around them
+static void repairRemoved()
+{
+	qsort(data.removed, data.numRemoved, sizeof(tile_dist), compareTileDist);
+	for (int i = 0; i < data.numRemoved; i++) {
+		data.distance[data.removed[i].gridOffset] = 0;
+	}
+	// removed tiles and cleared tiles, merged in order of their old distance
+	data.head = data.tail = 0;
+	int removed = 0;
+	while (removed < data.numRemoved || data.head < data.tail) {
+		tile_dist item;
+		if (removed < data.numRemoved &&
+			(data.head >= data.tail || data.removed[removed].dist <= data.queue[data.head].dist)) {
+			item = data.removed[removed++];
+		} else {
+			item = data.queue[data.head++];
+		}
+		FOR_NEIGHBOURS(item.gridOffset, next)
+			if (data.distance[next] == item.dist + 1 && next != data.source &&
+				!hasSupport(next, item.dist + 1)) {
+				data.distance[next] = 0;
+				data.queue[data.tail].gridOffset = next;
+				data.queue[data.tail].dist = item.dist + 1;
+				data.tail++;
+			}
+		END_FOR_NEIGHBOURS
+	}
+	int numCleared = data.tail;
+	for (int i = 0; i < numCleared; i++) {
+		addSeedFromNeighbours(data.queue[i].gridOffset);
+	}
+	propagateFromSeeds();
+}
+
+static void repairAdded()
+{
+	for (int i = 0; i < data.numAdded; i++) {
+		addSeedFromNeighbours(data.added[i]);
+	}
+	propagateFromSeeds();
+}
+
+static void calculateAll(int source)
+{
+	for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+		data.passable[i] = isPassable(i);
+	}
+	memset(data.distance, 0, sizeof(data.distance));
+	data.source = source;
+	data.head = data.tail = 0;
+	enqueue(source, 1);
+	while (data.head < data.tail) {
+		tile_dist item = data.queue[data.head++];
+		FOR_NEIGHBOURS(item.gridOffset, next)
+			if (data.passable[next] && !data.distance[next]) {
+				enqueue(next, item.dist + 1);
+			}
+		END_FOR_NEIGHBOURS
+	}
+}
+
+void Routing_updateEntryDistance()
+{
+	int source = GridOffset(Data_CityInfo.entryPointX, Data_CityInfo.entryPointY);
+	if (source != data.source) {
+		calculateAll(source);
+		return;
+	}
+	data.numRemoved = data.numAdded = 0;
+	for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+		int passable = isPassable(i);
+		if (passable == data.passable[i]) {
+			continue;
+		}
+		if (i == source) {
+			data.passable[i] = passable;
+			continue;
+		}
+		if (data.numRemoved + data.numAdded >= MAX_CHANGES_FOR_REPAIR) {
+			calculateAll(source);
+			return;
+		}
+		if (passable) {
+			// stays blocked until the removals are repaired
+			data.added[data.numAdded++] = i;
+		} else {
+			data.passable[i] = 0;
+			if (data.distance[i]) {
+				data.removed[data.numRemoved].gridOffset = i;
+				data.removed[data.numRemoved].dist = data.distance[i];
+				data.numRemoved++;
+			}
+		}
+	}
+	repairRemoved();
+	for (int i = 0; i < data.numAdded; i++) {
+		data.passable[data.added[i]] = 1;
+	}
+	repairAdded();
+}
+
+int Routing_getEntryDistance(int gridOffset)
+{
+	if (data.source != GridOffset(Data_CityInfo.entryPointX, Data_CityInfo.entryPointY)) {
+		Routing_updateEntryDistance();
+	}
+	return data.distance[gridOffset];
+}
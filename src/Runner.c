@@ -2,6 +2,7 @@
 #include "Animation.h"
 #include "GameFile.h"
 #include "GameTick.h"
+#include "Runner.h"
 #include "Sound.h"
 #include "UI/Window.h"
 
@@ -10,6 +11,17 @@
 
 #include "core/time.h"
 #include "game/settings.h"
+#include "game/time.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+// Wall clock time per frame that fast-forward spends on ticks
+#define FAST_FORWARD_BUDGET_MILLIS 12
+// Wall clock time per frame that skipping spends on ticks, rendering is suspended
+#define SKIP_BUDGET_MILLIS 100
+#define MAX_UI_CALLS 64
 
 static const time_millis millisPerTickPerSpeed[] = {
 	0, 20, 35, 55, 80, 110, 160, 240, 350, 500, 700
@@ -17,21 +29,38 @@ static const time_millis millisPerTickPerSpeed[] = {
 
 static time_millis lastUpdate;
 
-static int getElapsedTicks()
+static struct {
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	int started;
+	int busy;
+	int quit;
+} simThread = {0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER};
+
+// only touched by the simulation thread while it is busy, and by the main thread while it is idle
+static struct {
+	struct {
+		RunnerUiCall call;
+		int param;
+	} calls[MAX_UI_CALLS];
+	int size;
+	int opensWindow;
+} uiCalls;
+
+static struct {
+	int fastForward;
+	RunnerSkip skip;
+	int skipFromMonth;
+	int skipFromYear;
+} data;
+
+static int canRunTicks()
 {
-	time_millis now = time_get_millis();
-	time_millis diff = now - lastUpdate;
-	if (now < lastUpdate) {
-		diff = 10000;
-	}
-	int gameSpeedIndex = (100 - setting_game_speed()) / 10;
-	if (gameSpeedIndex >= 10) {
+	if (Data_Settings.gamePaused) {
 		return 0;
-	} else if (gameSpeedIndex < 0) {
-		gameSpeedIndex = 0;
 	}
-
-	if (Data_Settings.gamePaused) {
+	if (uiCalls.opensWindow) {
 		return 0;
 	}
 	switch (UI_Window_getId()) {
@@ -49,6 +78,26 @@ static int getElapsedTicks()
 	if (Data_State.isScrollingMap) {
 		return 0;
 	}
+	return 1;
+}
+
+static int getElapsedTicks()
+{
+	time_millis now = time_get_millis();
+	time_millis diff = now - lastUpdate;
+	if (now < lastUpdate) {
+		diff = 10000;
+	}
+	int gameSpeedIndex = (100 - setting_game_speed()) / 10;
+	if (gameSpeedIndex >= 10) {
+		return 0;
+	} else if (gameSpeedIndex < 0) {
+		gameSpeedIndex = 0;
+	}
+
+	if (!canRunTicks()) {
+		return 0;
+	}
 	if (diff < millisPerTickPerSpeed[gameSpeedIndex] + 2) {
 		return 0;
 	}
@@ -57,18 +106,192 @@ static int getElapsedTicks()
 	return gameSpeedIndex == 0 ? 2 : 1;
 }
 
+static void requestRefresh(int param)
+{
+	UI_Window_requestRefresh();
+}
+
+static void runTick()
+{
+	GameTick_doTick();
+	GameFile_writeMissionSavedGameIfNeeded();
+}
+
+static int skipTargetReached()
+{
+	switch (data.skip) {
+		case RunnerSkip_Month:
+			return game_time_month() != data.skipFromMonth || game_time_year() != data.skipFromYear;
+		case RunnerSkip_Year:
+			return game_time_year() != data.skipFromYear;
+		default:
+			return 0;
+	}
+}
+
+static void runTicksWithinBudget(time_millis budget)
+{
+	time_millis start = time_get_wall_millis();
+	while (canRunTicks() && !skipTargetReached()) {
+		runTick();
+		if (time_get_wall_millis() - start >= budget) {
+			break;
+		}
+	}
+	lastUpdate = time_get_millis();
+}
+
 void Runner_run()
 {
 	Animation_updateTimers();
-	int numTicks = getElapsedTicks();
-	for (int i = 0; i < numTicks; i++) {
-		GameTick_doTick();
-		GameFile_writeMissionSavedGameIfNeeded();
+	if (data.skip) {
+		runTicksWithinBudget(SKIP_BUDGET_MILLIS);
+		// stop when done, or when the player needs to see something (pause, message)
+		if (skipTargetReached() || !canRunTicks()) {
+			data.skip = RunnerSkip_None;
+			Runner_callUi(requestRefresh, 0, 0);
+		}
+	} else if (data.fastForward) {
+		runTicksWithinBudget(FAST_FORWARD_BUDGET_MILLIS);
+	} else {
+		int numTicks = getElapsedTicks();
+		for (int i = 0; i < numTicks; i++) {
+			runTick();
+		}
+	}
+}
+
+static void makeUiCalls()
+{
+	for (int i = 0; i < uiCalls.size; i++) {
+		uiCalls.calls[i].call(uiCalls.calls[i].param);
 	}
+	uiCalls.size = 0;
+	uiCalls.opensWindow = 0;
 }
 
 void Runner_draw()
 {
+	makeUiCalls();
+	if (data.skip) {
+		return;
+	}
 	UI_Window_refresh(0);
 	Sound_City_play();
 }
+
+static void *simThreadMain(void *arg)
+{
+	pthread_mutex_lock(&simThread.mutex);
+	while (!simThread.quit) {
+		if (simThread.busy) {
+			pthread_mutex_unlock(&simThread.mutex);
+			Runner_run();
+			pthread_mutex_lock(&simThread.mutex);
+			simThread.busy = 0;
+			pthread_cond_broadcast(&simThread.cond);
+		} else {
+			pthread_cond_wait(&simThread.cond, &simThread.mutex);
+		}
+	}
+	pthread_mutex_unlock(&simThread.mutex);
+	return 0;
+}
+
+void Runner_startThread()
+{
+	if (simThread.started) {
+		return;
+	}
+	simThread.busy = 0;
+	simThread.quit = 0;
+	if (pthread_create(&simThread.thread, 0, simThreadMain, 0) == 0) {
+		simThread.started = 1;
+	}
+}
+
+void Runner_stopThread()
+{
+	if (!simThread.started) {
+		return;
+	}
+	Runner_waitUntilIdle(-1);
+	pthread_mutex_lock(&simThread.mutex);
+	simThread.quit = 1;
+	pthread_cond_broadcast(&simThread.cond);
+	pthread_mutex_unlock(&simThread.mutex);
+	pthread_join(simThread.thread, 0);
+	simThread.started = 0;
+	makeUiCalls();
+}
+
+void Runner_runAsync()
+{
+	if (!simThread.started) {
+		Runner_run();
+		return;
+	}
+	pthread_mutex_lock(&simThread.mutex);
+	simThread.busy = 1;
+	pthread_cond_broadcast(&simThread.cond);
+	pthread_mutex_unlock(&simThread.mutex);
+}
+
+void Runner_callUi(RunnerUiCall call, int param, int opensWindow)
+{
+	if (!simThread.started || !pthread_equal(pthread_self(), simThread.thread)) {
+		call(param);
+		return;
+	}
+	for (int i = 0; i < uiCalls.size; i++) {
+		if (uiCalls.calls[i].call == call && uiCalls.calls[i].param == param) {
+			return;
+		}
+	}
+	if (uiCalls.size < MAX_UI_CALLS) {
+		uiCalls.calls[uiCalls.size].call = call;
+		uiCalls.calls[uiCalls.size].param = param;
+		uiCalls.size++;
+	}
+	if (opensWindow) {
+		uiCalls.opensWindow = 1;
+	}
+}
+
+int Runner_waitUntilIdle(int timeoutMillis)
+{
+	if (!simThread.started) {
+		return 1;
+	}
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += timeoutMillis / 1000;
+	deadline.tv_nsec += (timeoutMillis % 1000) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+	pthread_mutex_lock(&simThread.mutex);
+	while (simThread.busy) {
+		if (timeoutMillis < 0) {
+			pthread_cond_wait(&simThread.cond, &simThread.mutex);
+		} else if (pthread_cond_timedwait(&simThread.cond, &simThread.mutex, &deadline) == ETIMEDOUT) {
+			break;
+		}
+	}
+	int idle = !simThread.busy;
+	pthread_mutex_unlock(&simThread.mutex);
+	return idle;
+}
+
+void Runner_toggleFastForward()
+{
+	data.fastForward = !data.fastForward;
+}
+
+void Runner_skipTo(RunnerSkip skip)
+{
+	data.skip = skip;
+	data.skipFromMonth = game_time_month();
+	data.skipFromYear = game_time_year();
+}
@@ -1,7 +1,33 @@
 #ifndef RUNNER_H
 #define RUNNER_H
 
+typedef enum {
+	RunnerSkip_None = 0,
+	RunnerSkip_Month = 1,
+	RunnerSkip_Year = 2,
+} RunnerSkip;
+
 void Runner_run();
 void Runner_draw();
 
+// Simulation thread: while Runner_run executes there, game state must not be touched
+void Runner_startThread();
+void Runner_stopThread();
+// Runs Runner_run on the simulation thread, or directly when the thread is not started
+void Runner_runAsync();
+// Returns 1 when the simulation thread is idle; a negative timeout waits forever
+int Runner_waitUntilIdle(int timeoutMillis);
+
+// UI side effects of game ticks. On the simulation thread the call is queued and
+// made on the main thread before the next frame is drawn, elsewhere it is made now.
+// Queued calls that open a window stop the ticks until they are made.
+typedef void (*RunnerUiCall)(int param);
+void Runner_callUi(RunnerUiCall call, int param, int opensWindow);
+
+// Fast-forward: run as many ticks as fit in a fixed time budget per frame
+void Runner_toggleFastForward();
+
+// Run ticks at full speed without rendering until the next month/year starts
+void Runner_skipTo(RunnerSkip skip);
+
 #endif
@@ -5,6 +5,7 @@
 #include "core/calc.h"
 #include "CityInfo.h"
 #include "CityView.h"
+#include "Desirability.h"
 #include "Empire.h"
 #include "Event.h"
 #include "Figure.h"
@@ -19,6 +20,7 @@
 #include "Sound.h"
 #include "Terrain.h"
 #include "TerrainGraphics.h"
+#include "UtilityManagement.h"
 
 #include "UI/Window.h"
 
@@ -42,6 +44,7 @@
 #include "figure/trader.h"
 #include "game/difficulty.h"
 #include "game/settings.h"
+#include "game/tick_scheduler.h"
 #include "game/time.h"
 #include "graphics/image.h"
 
@@ -182,7 +185,9 @@ static void initCustomScenario(const char *scenarioName)
 	figure_name_init();
     formations_clear();
 	FigureRoute_clearList();
+	FigureRoute_clearCache();
 	CityInfo_initGameTime();
+	tick_scheduler_reset();
 
 	loadScenario(scenarioName);
 
@@ -321,6 +326,7 @@ static void readScenarioAndInitGraphics()
 	TerrainGraphics_updateRegionAqueduct(0, 0, Data_Settings_Map.width - 1, Data_Settings_Map.height - 1, 0);
 
 	Natives_init();
+	Figure_initServiceCoverage();
 
 	CityView_checkCameraBoundaries();
 
@@ -339,15 +345,17 @@ static void initGrids()
 	Grid_clearShortGrid(Data_Grid_terrain);
 	Grid_clearUByteGrid(Data_Grid_aqueducts);
 	Grid_clearShortGrid(Data_Grid_figureIds);
+	Figure_rebuildTileLists();
 	Grid_clearUByteGrid(Data_Grid_bitfields);
 	Grid_clearUByteGrid(Data_Grid_spriteOffsets);
 	Grid_clearUByteGrid(Data_Grid_random);
 	Grid_clearByteGrid(Data_Grid_desirability);
+	Desirability_invalidate();
 	Grid_clearUByteGrid(Data_Grid_elevation);
 	Grid_clearUByteGrid(Data_Grid_buildingDamage);
 	Grid_clearUByteGrid(Data_Grid_rubbleBuildingType);
 	Grid_clearUByteGrid(Data_Grid_romanSoldierConcentration);
-	Grid_clearUByteGrid(Data_Grid_roadNetworks);
+	UtilityManagement_clearRoadNetworks();
 
 	TerrainGraphicsContext_init();
 	initGridTerrain();
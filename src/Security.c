@@ -44,7 +44,7 @@ void Security_Tick_updateBurningRuins()
 	Data_BuildingList.burning.index = 0;
 	Data_BuildingList.burning.size = 0;
 	Data_BuildingList.burning.totalBurning = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		struct Data_Building *b = &Data_Buildings[i];
 		if (!BuildingIsInUse(i) || b->type != BUILDING_BURNING_RUIN) {
 			continue;
@@ -323,65 +323,76 @@ static void fireBuilding(int buildingId, struct Data_Building *b)
 	Sound_Effects_playChannel(SoundChannel_Explosion);
 }
 
-void Security_Tick_checkFireCollapse()
+// state of the fire and collapse pass over all buildings
+static struct {
+	int randomGlobal;
+	int recalculateTerrain;
+} fireCollapse;
+
+void Security_Tick_beginFireCollapse()
 {
 	Data_CityInfo.numProtestersThisMonth = 0;
 	Data_CityInfo.numCriminalsThisMonth = 0;
 	
-	int recalculateTerrain = 0;
-	int randomGlobal = random_byte() & 7;
-	for (int i = 1; i <= Data_Buildings_Extra.highestBuildingIdInUse; i++) {
-		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->fireProof) {
-			continue;
-		}
-		if (b->type == BUILDING_HIPPODROME && b->prevPartBuildingId) {
-			continue;
-		}
-		int randomBuilding = (i + Data_Grid_random[b->gridOffset]) & 7;
-		// damage
-		b->damageRisk += (randomBuilding == randomGlobal) ? 3 : 1;
-		if (Data_Tutorial.tutorial1.fire == 1 && !Data_Tutorial.tutorial1.collapse) {
-			b->damageRisk += 5;
-		}
-		if (b->houseSize && b->subtype.houseLevel <= HOUSE_LARGE_TENT) {
-			b->damageRisk = 0;
+	fireCollapse.recalculateTerrain = 0;
+	fireCollapse.randomGlobal = random_byte() & 7;
+}
+
+void Security_Tick_checkFireCollapse(int buildingId)
+{
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (!BuildingIsInUse(buildingId) || b->fireProof) {
+		return;
+	}
+	if (b->type == BUILDING_HIPPODROME && b->prevPartBuildingId) {
+		return;
+	}
+	int randomBuilding = (buildingId + Data_Grid_random[b->gridOffset]) & 7;
+	// damage
+	b->damageRisk += (randomBuilding == fireCollapse.randomGlobal) ? 3 : 1;
+	if (Data_Tutorial.tutorial1.fire == 1 && !Data_Tutorial.tutorial1.collapse) {
+		b->damageRisk += 5;
+	}
+	if (b->houseSize && b->subtype.houseLevel <= HOUSE_LARGE_TENT) {
+		b->damageRisk = 0;
+	}
+	if (b->damageRisk > 200) {
+		collapseBuilding(buildingId, b);
+		fireCollapse.recalculateTerrain = 1;
+		return;
+	}
+	// fire
+	if (randomBuilding == fireCollapse.randomGlobal) {
+		if (!b->houseSize) {
+			b->fireRisk += 5;
+		} else if (b->housePopulation <= 0) {
+			b->fireRisk = 0;
+		} else if (b->subtype.houseLevel <= HOUSE_LARGE_SHACK) {
+			b->fireRisk += 10;
+		} else if (b->subtype.houseLevel <= HOUSE_GRAND_INSULA) {
+			b->fireRisk += 5;
+		} else {
+			b->fireRisk += 2;
 		}
-		if (b->damageRisk > 200) {
-			collapseBuilding(i, b);
-			recalculateTerrain = 1;
-			continue;
+		if (!Data_Tutorial.tutorial1.fire) {
+			b->fireRisk += 5;
 		}
-		// fire
-		if (randomBuilding == randomGlobal) {
-			if (!b->houseSize) {
-				b->fireRisk += 5;
-			} else if (b->housePopulation <= 0) {
-				b->fireRisk = 0;
-			} else if (b->subtype.houseLevel <= HOUSE_LARGE_SHACK) {
-				b->fireRisk += 10;
-			} else if (b->subtype.houseLevel <= HOUSE_GRAND_INSULA) {
-				b->fireRisk += 5;
-			} else {
-				b->fireRisk += 2;
-			}
-			if (!Data_Tutorial.tutorial1.fire) {
-				b->fireRisk += 5;
-			}
-			if (Data_Scenario.climate == Climate_Northern) {
-				b->fireRisk = 0;
-			}
-			if (Data_Scenario.climate == Climate_Desert) {
-				b->fireRisk += 3;
-			}
+		if (Data_Scenario.climate == Climate_Northern) {
+			b->fireRisk = 0;
 		}
-		if (b->fireRisk > 100) {
-			fireBuilding(i, b);
-			recalculateTerrain = 1;
+		if (Data_Scenario.climate == Climate_Desert) {
+			b->fireRisk += 3;
 		}
 	}
-	
-	if (recalculateTerrain) {
+	if (b->fireRisk > 100) {
+		fireBuilding(buildingId, b);
+		fireCollapse.recalculateTerrain = 1;
+	}
+}
+
+void Security_Tick_endFireCollapse()
+{
+	if (fireCollapse.recalculateTerrain) {
 		Routing_determineLandCitizen();
 		Routing_determineLandNonCitizen();
 	}
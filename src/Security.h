@@ -6,6 +6,9 @@ void Security_Tick_updateBurningRuins();
 int Security_Fire_getClosestBurningRuin(int x, int y, int *distance);
 
 void Security_Tick_generateCriminal();
-void Security_Tick_checkFireCollapse();
+// fire and collapse checks: begin, then check each building, then end
+void Security_Tick_beginFireCollapse();
+void Security_Tick_checkFireCollapse(int buildingId);
+void Security_Tick_endFireCollapse();
 
 #endif
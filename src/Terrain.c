@@ -15,16 +15,17 @@
 #include "Data/Settings.h"
 #include "Data/State.h"
 
-#include "core/calc.h"
 #include "graphics/image.h"
+#include "map/building_coverage.h"
+#include "map/ring.h"
 
 static const int tilesAroundBuildingGridOffsets[][20] = {
 	{0},
-	{-162, 1, 162, -1, 0},
-	{-162, -161, 2, 164, 325, 324, 161, -1, 0},
-	{-162, -161, -160, 3, 165, 327, 488, 487, 486, 323, 161, -1, 0},
-	{-162, -161, -160, -159, 4, 166, 328, 490, 651, 650, 649, 648, 485, 323, 161, -1, 0},
-	{-162, -161, -160, -159, -158, 5, 167, 329, 491, 653, 814, 813, 812, 811, 810, 647, 485, 323, 161, -1},
+	{GridDelta(0, -1), 1, GridDelta(0, 1), -1, 0},
+	{GridDelta(0, -1), GridDelta(1, -1), 2, GridDelta(2, 1), GridDelta(1, 2), GridDelta(0, 2), GridDelta(-1, 1), -1, 0},
+	{GridDelta(0, -1), GridDelta(1, -1), GridDelta(2, -1), 3, GridDelta(3, 1), GridDelta(3, 2), GridDelta(2, 3), GridDelta(1, 3), GridDelta(0, 3), GridDelta(-1, 2), GridDelta(-1, 1), -1, 0},
+	{GridDelta(0, -1), GridDelta(1, -1), GridDelta(2, -1), GridDelta(3, -1), 4, GridDelta(4, 1), GridDelta(4, 2), GridDelta(4, 3), GridDelta(3, 4), GridDelta(2, 4), GridDelta(1, 4), GridDelta(0, 4), GridDelta(-1, 3), GridDelta(-1, 2), GridDelta(-1, 1), -1, 0},
+	{GridDelta(0, -1), GridDelta(1, -1), GridDelta(2, -1), GridDelta(3, -1), GridDelta(4, -1), 5, GridDelta(5, 1), GridDelta(5, 2), GridDelta(5, 3), GridDelta(5, 4), GridDelta(4, 5), GridDelta(3, 5), GridDelta(2, 5), GridDelta(1, 5), GridDelta(0, 5), GridDelta(-1, 4), GridDelta(-1, 3), GridDelta(-1, 2), GridDelta(-1, 1), -1},
 };
 
 static const int tileEdgeSizeOffsets[5][5] = {
@@ -35,17 +36,6 @@ static const int tileEdgeSizeOffsets[5][5] = {
 	{32, 33, 34, 35, 36},
 };
 
-struct RingTile {
-	int x;
-	int y;
-	int gridOffset;
-} ringTiles[1080];
-
-// ringIndex[SIZE][DIST]
-int ringIndex[6][7];
-
-#define RING_SIZE(s,d) (4 * ((s) - 1) + 8 * (d))
-
 #define FOR_XY_ADJACENT \
 	{int baseOffset = GridOffset(x, y);\
 	for (int i = 0; i < 20; i++) {\
@@ -55,8 +45,8 @@ int ringIndex[6][7];
 #define END_FOR_XY_ADJACENT }}
 
 #define STORE_XY_ADJACENT(xTile,yTile) \
-	*(xTile) = x + (tilesAroundBuildingGridOffsets[size][i] + 172) % 162 - 10;\
-	*(yTile) = y + (tilesAroundBuildingGridOffsets[size][i] + 162) / 161 - 1;
+	*(xTile) = x + (tilesAroundBuildingGridOffsets[size][i] + GRID_SIZE + 10) % GRID_SIZE - 10;\
+	*(yTile) = y + (tilesAroundBuildingGridOffsets[size][i] + GRID_SIZE) / (GRID_SIZE - 1) - 1;
 
 #define FOR_XY_RADIUS \
 	int xMin = x - radius;\
@@ -71,7 +61,7 @@ int ringIndex[6][7];
 #define END_FOR_XY_RADIUS \
 			++gridOffset;\
 		}\
-		gridOffset += 162 - (xMax - xMin + 1);\
+		gridOffset += GRID_SIZE - (xMax - xMin + 1);\
 	}
 
 #define STORE_XY_RADIUS(xTile,yTile) \
@@ -101,12 +91,14 @@ void Terrain_addBuildingToGrids(int buildingId, int x, int y, int size, int grap
 		default:
 			return;
 	}
+	Routing_markLandDirty(x, y, size);
 	for (int dy = 0; dy < size; dy++) {
 		for (int dx = 0; dx < size; dx++) {
 			int gridOffset = GridOffset(x + dx, y + dy);
 			Data_Grid_terrain[gridOffset] &= Terrain_2e80;
 			Data_Grid_terrain[gridOffset] |= terrain;
 			Data_Grid_buildingIds[gridOffset] = buildingId;
+			map_building_coverage_tile_changed(gridOffset);
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoOverlay;
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoSizes;
 			switch (size) {
@@ -160,6 +152,7 @@ void Terrain_removeBuildingFromGrids(int buildingId, int x, int y)
 	if (buildingId && BuildingIsFarm(Data_Buildings[buildingId].type)) {
 		size = 3;
 	}
+	Routing_markLandDirty(x, y, size);
 	for (int dy = 0; dy < size; dy++) {
 		for (int dx = 0; dx < size; dx++) {
 			int gridOffset = GridOffset(x + dx, y + dy);
@@ -175,6 +168,7 @@ void Terrain_removeBuildingFromGrids(int buildingId, int x, int y)
 			Data_Grid_edge[gridOffset] |= Edge_LeftmostTile;
 			Data_Grid_aqueducts[gridOffset] = 0;
 			Data_Grid_buildingIds[gridOffset] = 0;
+			map_building_coverage_tile_changed(gridOffset);
 			Data_Grid_buildingDamage[gridOffset] = 0;
 			Data_Grid_spriteOffsets[gridOffset] = 0;
 			if (Data_Grid_terrain[gridOffset] & Terrain_Water) {
@@ -563,7 +557,7 @@ static int getReachableRoadWithinRadius(int x, int y, int size, int radius, int
 {
 	FOR_XY_RADIUS {
 		if (Data_Grid_terrain[gridOffset] & Terrain_Road) {
-			if (Data_Grid_routingDistance[gridOffset] > 0) {
+			if (Routing_getEntryDistance(gridOffset) > 0) {
 				if (xTile && yTile) {
 					STORE_XY_RADIUS(xTile, yTile);
 				}
@@ -590,7 +584,7 @@ int Terrain_getRoadToLargestRoadNetwork(int x, int y, int size, int *xTile, int
 	int minIndex = 12;
 	int minGridOffset = -1;
 	FOR_XY_ADJACENT {
-		if (Data_Grid_terrain[gridOffset] & Terrain_Road && Data_Grid_routingDistance[gridOffset] > 0) {
+		if (Data_Grid_terrain[gridOffset] & Terrain_Road && Routing_getEntryDistance(gridOffset) > 0) {
 			int index = 11;
 			for (int n = 0; n < 10; n++) {
 				if (Data_CityInfo.largestRoadNetworks[n].id == Data_Grid_roadNetworks[gridOffset]) {
@@ -612,7 +606,7 @@ int Terrain_getRoadToLargestRoadNetwork(int x, int y, int size, int *xTile, int
 	int minDist = 100000;
 	minGridOffset = -1;
 	FOR_XY_ADJACENT {
-		int dist = Data_Grid_routingDistance[gridOffset];
+		int dist = Routing_getEntryDistance(gridOffset);
 		if (dist > 0 && dist < minDist) {
 			minDist = dist;
 			minGridOffset = gridOffset;
@@ -635,7 +629,7 @@ int Terrain_getRoadToLargestRoadNetworkHippodrome(int x, int y, int size, int *x
 	for (int xOffset = 0; xOffset <= 10; xOffset += 5) {
 		x = xBase + xOffset;
 		FOR_XY_ADJACENT {
-			if (Data_Grid_terrain[gridOffset] & Terrain_Road && Data_Grid_routingDistance[gridOffset] > 0) {
+			if (Data_Grid_terrain[gridOffset] & Terrain_Road && Routing_getEntryDistance(gridOffset) > 0) {
 				int index = 11;
 				for (int n = 0; n < 10; n++) {
 					if (Data_CityInfo.largestRoadNetworks[n].id == Data_Grid_roadNetworks[gridOffset]) {
@@ -660,7 +654,7 @@ int Terrain_getRoadToLargestRoadNetworkHippodrome(int x, int y, int size, int *x
 	for (int xOffset = 0; xOffset <= 10; xOffset += 5) {
 		x = xBase + xOffset;
 		FOR_XY_ADJACENT {
-			int dist = Data_Grid_routingDistance[gridOffset];
+			int dist = Routing_getEntryDistance(gridOffset);
 			if (dist > 0 && dist < minDist) {
 				minDist = dist;
 				minGridOffset = gridOffset;
@@ -966,50 +960,6 @@ int Terrain_hasBuildingOnNativeLand(int x, int y, int size, int radius)
 	return 0;
 }
 
-void Terrain_initDistanceRing()
-{
-	int index = 0;
-	int x, y;
-	for (int s = 1; s <= 5; s++) {
-		for (int d = 1; d <= 6; d++) {
-			ringIndex[s][d] = index;
-			// top row, from x=0
-			for (y = -d, x = 0; x < s + d; x++, index++) {
-				ringTiles[index].x = x;
-				ringTiles[index].y = y;
-			}
-			// right row down
-			for (x = s + d - 1, y = -d + 1; y < s + d; y++, index++) {
-				ringTiles[index].x = x;
-				ringTiles[index].y = y;
-			}
-			// bottom row to the left
-			for (y = s + d - 1, x = s + d - 2; x >= -d; x--, index++) {
-				ringTiles[index].x = x;
-				ringTiles[index].y = y;
-			}
-			// exception (bug in game): size 4 distance 2, left corner is off by x+1, y-1
-			if (s == 4 && d == 2) {
-				ringTiles[index-1].x += 1;
-				ringTiles[index-1].y -= 1;
-			}
-			// left row up
-			for (x = -d, y = s + d - 2; y >= -d; y--, index++) {
-				ringTiles[index].x = x;
-				ringTiles[index].y = y;
-			}
-			// top row up to x=0
-			for (y = -d, x = -d + 1; x < 0; x++, index++) {
-				ringTiles[index].x = x;
-				ringTiles[index].y = y;
-			}
-		}
-	}
-	for (int i = 0; i < index; i++) {
-		ringTiles[i].gridOffset = DELTA(ringTiles[i].x, ringTiles[i].y);
-	}
-}
-
 static int isInsideMapForRing(int x, int y)
 {
 	return x >= -1 && x <= Data_Settings_Map.width &&
@@ -1018,12 +968,13 @@ static int isInsideMapForRing(int x, int y)
 
 int Terrain_isAllRockAndTreesAtDistanceRing(int x, int y, int distance)
 {
-	int start = ringIndex[1][distance];
-	int end = start + RING_SIZE(1,distance);
+	int start = map_ring_start(1, distance);
+	int end = map_ring_end(1, distance);
 	int baseOffset = GridOffset(x, y);
 	for (int i = start; i < end; i++) {
-		if (isInsideMapForRing(x + ringTiles[i].x, y + ringTiles[i].y)) {
-			int terrain = Data_Grid_terrain[baseOffset + ringTiles[i].gridOffset];
+		const ring_tile *tile = map_ring_tile(i);
+		if (isInsideMapForRing(x + tile->x, y + tile->y)) {
+			int terrain = Data_Grid_terrain[baseOffset + tile->grid_offset];
 			if (!(terrain & Terrain_Rock) || !(terrain & Terrain_Tree)) {
 				return 0;
 			}
@@ -1034,12 +985,13 @@ int Terrain_isAllRockAndTreesAtDistanceRing(int x, int y, int distance)
 
 int Terrain_isAllMeadowAtDistanceRing(int x, int y, int distance)
 {
-	int start = ringIndex[1][distance];
-	int end = start + RING_SIZE(1,distance);
+	int start = map_ring_start(1, distance);
+	int end = map_ring_end(1, distance);
 	int baseOffset = GridOffset(x, y);
 	for (int i = start; i < end; i++) {
-		if (isInsideMapForRing(x + ringTiles[i].x, y + ringTiles[i].y)) {
-			int terrain = Data_Grid_terrain[baseOffset + ringTiles[i].gridOffset];
+		const ring_tile *tile = map_ring_tile(i);
+		if (isInsideMapForRing(x + tile->x, y + tile->y)) {
+			int terrain = Data_Grid_terrain[baseOffset + tile->grid_offset];
 			if (!(terrain & Terrain_Meadow)) {
 				return 0;
 			}
@@ -1048,51 +1000,29 @@ int Terrain_isAllMeadowAtDistanceRing(int x, int y, int distance)
 	return 1;
 }
 
-static void addDesirabilityDistanceRing(int x, int y, int size, int distance, int desirability)
+static void addDesirability(int x, int y, int size, int desBase, int desStep, int desStepSize, int desRange,
+	const map_ring_area *area)
 {
-	int isPartiallyOutsideMap = 0;
-	if (x - distance < -1 || x + distance + size - 1 > Data_Settings_Map.width) {
-		isPartiallyOutsideMap = 1;
-	}
-	if (y - distance < -1 || y + distance + size - 1 > Data_Settings_Map.height) {
-		isPartiallyOutsideMap = 1;
-	}
-	int start = ringIndex[size][distance];
-	int end = start + RING_SIZE(size,distance);
-	int baseOffset = GridOffset(x, y);
-
-	if (isPartiallyOutsideMap) {
-		for (int i = start; i < end; i++) {
-			if (isInsideMapForRing(x + ringTiles[i].x, y + ringTiles[i].y)) {
-				Data_Grid_desirability[baseOffset + ringTiles[i].gridOffset] += desirability;
-				Data_Grid_desirability[baseOffset] = calc_bound(Data_Grid_desirability[baseOffset], -100, 100); // BUG: bounding on wrong tile
-			}
-		}
-	} else {
-		for (int i = start; i < end; i++) {
-			Data_Grid_desirability[baseOffset + ringTiles[i].gridOffset] =
-                calc_bound(Data_Grid_desirability[baseOffset + ringTiles[i].gridOffset] + desirability, -100, 100);
-		}
-	}
+	map_ring_grid grid = {
+		Data_Grid_desirability,
+		Data_Settings_Map.gridStartOffset,
+		Data_Settings_Map.width,
+		Data_Settings_Map.height
+	};
+	map_ring_desirability desirability = {size, desBase, desStep, desStepSize, desRange};
+	map_ring_add_desirability(&grid, x, y, &desirability, area);
 }
 
 void Terrain_addDesirability(int x, int y, int size, int desBase, int desStep, int desStepSize, int desRange)
 {
-	if (size > 0) {
-		if (desRange > 6) desRange = 6;
-		int tilesWithinStep = 0;
-		int distance = 1;
-		while (desRange > 0) {
-			addDesirabilityDistanceRing(x, y, size, distance, desBase);
-			distance++;
-			desRange--;
-			tilesWithinStep++;
-			if (tilesWithinStep >= desStep) {
-				desBase += desStepSize;
-				tilesWithinStep = 0;
-			}
-		}
-	}
+	addDesirability(x, y, size, desBase, desStep, desStepSize, desRange, 0);
+}
+
+void Terrain_addDesirabilityInArea(int x, int y, int size, int desBase, int desStep, int desStepSize, int desRange,
+	int xMin, int yMin, int xMax, int yMax)
+{
+	map_ring_area area = {xMin, yMin, xMax, yMax};
+	addDesirability(x, y, size, desBase, desStep, desStepSize, desRange, &area);
 }
 
 int Terrain_countTerrainTypeDirectlyAdjacentTo(int gridOffset, int terrainMask)
@@ -21,16 +21,16 @@ static int getDirectionYBridgeTiles(int gridOffset)
 {
 	int dirY = 0;
 	// Y direction
-	if (IS_BRIDGE(gridOffset-162)) {
+	if (IS_BRIDGE(gridOffset - GRID_SIZE)) {
 		dirY++;
 	}
-	if (IS_BRIDGE(gridOffset-324)) {
+	if (IS_BRIDGE(gridOffset - 2 * GRID_SIZE)) {
 		dirY++;
 	}
-	if (IS_BRIDGE(gridOffset+162)) {
+	if (IS_BRIDGE(gridOffset + GRID_SIZE)) {
 		dirY++;
 	}
-	if (IS_BRIDGE(gridOffset+324)) {
+	if (IS_BRIDGE(gridOffset + 2 * GRID_SIZE)) {
 		dirY++;
 	}
 	return dirY;
@@ -74,13 +74,13 @@ int TerrainBridge_determineLengthAndDirection(int x, int y, int isShipBridge, in
 		return 0;
 	}
 	if (!(Data_Grid_terrain[GridOffset(x, y-1)] & Terrain_Water)) {
-		bridge.directionGridOffset = 162;
+		bridge.directionGridOffset = GRID_SIZE;
 		bridge.direction = Dir_4_Bottom;
 	} else if (!(Data_Grid_terrain[GridOffset(x+1, y)] & Terrain_Water)) {
 		bridge.directionGridOffset = -1;
 		bridge.direction = Dir_6_Left;
 	} else if (!(Data_Grid_terrain[GridOffset(x, y+1)] & Terrain_Water)) {
-		bridge.directionGridOffset = -162;
+		bridge.directionGridOffset = -GRID_SIZE;
 		bridge.direction = Dir_0_Top;
 	} else if (!(Data_Grid_terrain[GridOffset(x-1, y)] & Terrain_Water)) {
 		bridge.directionGridOffset = 1;
@@ -230,7 +230,7 @@ void TerrainBridge_removeFromSpriteGrid(int gridOffset, int onlyMarkDeleted)
 	int dirX = getDirectionXBridgeTiles(gridOffset);
 	int dirY = getDirectionYBridgeTiles(gridOffset);
 
-	int offsetUp = dirX > dirY ? 1 : 162;
+	int offsetUp = dirX > dirY ? 1 : GRID_SIZE;
 	// find lower end of the bridge
 	while ((Data_Grid_terrain[gridOffset - offsetUp] & Terrain_Water) &&
 			Data_Grid_spriteOffsets[gridOffset - offsetUp]) {
@@ -264,7 +264,7 @@ int TerrainBridge_countFiguresOnBridge(int gridOffset)
 	int dirX = getDirectionXBridgeTiles(gridOffset);
 	int dirY = getDirectionYBridgeTiles(gridOffset);
 	
-	int offsetUp = dirX > dirY ? 1 : 162;
+	int offsetUp = dirX > dirY ? 1 : GRID_SIZE;
 	// find lower end of the bridge
 	while ((Data_Grid_terrain[gridOffset - offsetUp] & Terrain_Water) &&
 			Data_Grid_spriteOffsets[gridOffset - offsetUp]) {
@@ -7,6 +7,7 @@
 #include "Data/Constants.h"
 
 #include "graphics/image.h"
+#include "map/building_coverage.h"
 
 static void TerrainGraphics_setTileRubble(int x, int y);
 static void TerrainGraphics_updateTileMeadow(int x, int y);
@@ -244,10 +245,10 @@ static int getAccessRampGraphicOffset(int x, int y)
 		return -1;
 	}
 	static const int offsets[4][6] = {
-		{162, 163, 0, 1, 324, 325},
-		{0, 162, 1, 163, -1, 161},
-		{0, 1, 162, 163, -162, -161},
-		{1, 163, 0, 162, 2, 164},
+		{GridDelta(0, 1), GridDelta(1, 1), 0, 1, GridDelta(0, 2), GridDelta(1, 2)},
+		{0, GridDelta(0, 1), 1, GridDelta(1, 1), -1, GridDelta(-1, 1)},
+		{0, 1, GridDelta(0, 1), GridDelta(1, 1), GridDelta(0, -1), GridDelta(1, -1)},
+		{1, GridDelta(1, 1), 0, GridDelta(0, 1), 2, GridDelta(2, 1)},
 	};
 	int baseOffset = GridOffset(x, y);
 	int graphicOffset = -1;
@@ -559,6 +560,7 @@ void TerrainGraphics_setBuildingAreaRubble(int buildingId, int x, int y, int siz
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoSizes;
 			Data_Grid_aqueducts[gridOffset] = 0;
 			Data_Grid_buildingIds[gridOffset] = 0;
+			map_building_coverage_tile_changed(gridOffset);
 			Data_Grid_buildingDamage[gridOffset] = 0;
 			Data_Grid_spriteOffsets[gridOffset] = 0;
 			Data_Grid_edge[gridOffset] = Edge_LeftmostTile;
@@ -581,6 +583,7 @@ static void setFarmCropTile(int buildingId, int x, int y, int dx, int dy, int cr
 	Data_Grid_terrain[gridOffset] &= Terrain_2e80;
 	Data_Grid_terrain[gridOffset] |= Terrain_Building;
 	Data_Grid_buildingIds[gridOffset] = buildingId;
+	map_building_coverage_tile_changed(gridOffset);
 	Data_Grid_bitfields[gridOffset] &= Bitfield_NoOverlay;
 	Data_Grid_edge[gridOffset] = EdgeXY(dx, dy) | Edge_LeftmostTile;
 	Data_Grid_graphicIds[gridOffset] = cropGraphicId + (growth < 4 ? growth : 4);
@@ -606,6 +609,7 @@ void TerrainGraphics_setBuildingFarm(int buildingId, int x, int y, int cropGraph
 			Data_Grid_terrain[gridOffset] &= Terrain_2e80;
 			Data_Grid_terrain[gridOffset] |= Terrain_Building;
 			Data_Grid_buildingIds[gridOffset] = buildingId;
+			map_building_coverage_tile_changed(gridOffset);
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoOverlay;
 			Data_Grid_bitfields[gridOffset] |= Bitfield_Size2;
 			Data_Grid_graphicIds[gridOffset] = image_group(ID_Graphic_FarmHouse);
@@ -1138,6 +1142,7 @@ static void TerrainGraphics_updateAreaEmptyLand(int x, int y, int size, int grap
 			int gridOffset = GridOffset(x + dx, y + dy);
 			Data_Grid_terrain[gridOffset] &= Terrain_2e80;
 			Data_Grid_buildingIds[gridOffset] = 0;
+			map_building_coverage_tile_changed(gridOffset);
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoOverlay;
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoSizes;
 			Data_Grid_edge[gridOffset] |= Edge_LeftmostTile;
@@ -283,7 +283,7 @@ static const int contextSizes[] = {
 };
 
 static const int contextTileOffsets[] = {
-	-162, -161, 1, 163, 162, 161, -1, -163
+	GridDelta(0, -1), GridDelta(1, -1), 1, GridDelta(1, 1), GridDelta(0, 1), GridDelta(-1, 1), -1, GridDelta(-1, -1)
 };
 
 static void clearCurrentOffset(struct TerrainGraphicsContext *items, int numItems)
@@ -2,6 +2,7 @@
 #include "Terrain_private.h"
 
 #include "core/calc.h"
+#include "map/building_coverage.h"
 
 #include "Data/Building.h"
 #include "Data/CityInfo.h"
@@ -44,6 +45,7 @@ void Terrain_addWatersideBuildingToGrids(int buildingId, int x, int y, int size,
 				Data_Grid_terrain[gridOffset] |= Terrain_Building;
 			}
 			Data_Grid_buildingIds[gridOffset] = buildingId;
+			map_building_coverage_tile_changed(gridOffset);
 			Data_Grid_bitfields[gridOffset] &= Bitfield_NoOverlay;
 			Data_Grid_bitfields[gridOffset] |= sizeMask;
 			Data_Grid_graphicIds[gridOffset] = graphicId;
@@ -71,7 +73,7 @@ int Terrain_determineOrientationWatersideSize2(int x, int y, int adjustXY,
 	}
 
 	int baseOffset = GridOffset(x, y);
-	int tileOffsets[] = {0, 1, 162, 163};
+	int tileOffsets[] = {0, 1, GridDelta(0, 1), GridDelta(1, 1)};
 	const int shouldBeWater[4][4] = {{1, 1, 0, 0}, {0, 1, 0, 1}, {0, 0, 1, 1}, {1, 0, 1, 0}};
 	for (int dir = 0; dir < 4; dir++) {
 		int okTiles = 0;
@@ -99,10 +101,10 @@ int Terrain_determineOrientationWatersideSize2(int x, int y, int adjustXY,
 		}
 		// check six water tiles in front
 		const int tilesToCheck[4][6] = {
-			{-1, -163, -162, -161, -160, 2},
-			{-161, -160, 2, 164, 326, 325},
-			{164, 326, 325, 324, 323, 161},
-			{324, 323, 161, -1, -163, -162},
+			{-1, GridDelta(-1, -1), GridDelta(0, -1), GridDelta(1, -1), GridDelta(2, -1), 2},
+			{GridDelta(1, -1), GridDelta(2, -1), 2, GridDelta(2, 1), GridDelta(2, 2), GridDelta(1, 2)},
+			{GridDelta(2, 1), GridDelta(2, 2), GridDelta(1, 2), GridDelta(0, 2), GridDelta(-1, 2), GridDelta(-1, 1)},
+			{GridDelta(0, 2), GridDelta(-1, 2), GridDelta(-1, 1), -1, GridDelta(-1, -1), GridDelta(0, -1)},
 		};
 		for (int i = 0; i < 6; i++) {
 			if (!(Data_Grid_terrain[baseOffset + tilesToCheck[dir][i]] & Terrain_Water)) {
@@ -139,7 +141,7 @@ int Terrain_determineOrientationWatersideSize3(int x, int y, int adjustXY,
 	}
 
 	int baseOffset = GridOffset(x, y);
-	int tileOffsets[] = {0, 1, 2, 162, 163, 164, 324, 325, 326};
+	int tileOffsets[] = {0, 1, 2, GridDelta(0, 1), GridDelta(1, 1), GridDelta(2, 1), GridDelta(0, 2), GridDelta(1, 2), GridDelta(2, 2)};
 	int shouldBeWater[4][9] = {
 		{1, 1, 1, 0, 0, 0, 0, 0, 0},
 		{0, 0, 1, 0, 0, 1, 0, 0, 1},
@@ -171,7 +173,7 @@ int Terrain_determineOrientationWatersideSize3(int x, int y, int adjustXY,
 			}
 		}
 		// check two water tiles at the side
-		int tilesToCheck[4][2] = {{-1, 3}, {-160, 488}, {327, 323}, {-162, 486}};
+		int tilesToCheck[4][2] = {{-1, 3}, {GridDelta(2, -1), GridDelta(2, 3)}, {GridDelta(3, 2), GridDelta(-1, 2)}, {GridDelta(0, -1), GridDelta(0, 3)}};
 		for (int i = 0; i < 2; i++) {
 			if (!(Data_Grid_terrain[baseOffset + tilesToCheck[dir][i]] & Terrain_Water)) {
 				okTiles = 0;
@@ -194,7 +196,7 @@ int Terrain_determineOrientationWatersideSize3(int x, int y, int adjustXY,
 int Terrain_Water_getWharfTileForNewFishingBoat(int figureId, int *xTile, int *yTile)
 {
 	int wharfId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (BuildingIsInUse(i) && Data_Buildings[i].type == BUILDING_WHARF) {
 			int wharfBoatId = Data_Buildings[i].data.other.boatFigureId;
 			if (!wharfBoatId || wharfBoatId == figureId) {
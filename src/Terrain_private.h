@@ -23,7 +23,7 @@
 			block;\
 			++gridOffset;\
 		}\
-		gridOffset += 162 - (xMax - xMin + 1);\
+		gridOffset += GRID_SIZE - (xMax - xMin + 1);\
 	}}
 
 #endif
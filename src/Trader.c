@@ -16,6 +16,7 @@
 #include "Data/Figure.h"
 
 #include "building/count.h"
+#include "building/index.h"
 #include "empire/trade_prices.h"
 #include "empire/trade_route.h"
 #include "figure/type.h"
@@ -201,8 +202,8 @@ int Trader_getClosestWarehouseForTradeCaravan(int figureId, int x, int y, int ci
 	}
 	int minDistance = 10000;
 	int minBuildingId = 0;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (!BuildingIsInUse(i) || Data_Buildings[i].type != BUILDING_WAREHOUSE) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_WAREHOUSE) {
+		if (!BuildingIsInUse(i)) {
 			continue;
 		}
 		if (!Data_Buildings[i].hasRoadAccess || Data_Buildings[i].distanceFromEntry <= 0) {
@@ -292,8 +293,8 @@ int Trader_getClosestWarehouseForImportDocker(int x, int y, int cityId, int dist
 	int minDistance = 10000;
 	int minBuildingId = 0;
 	int resourceId = Data_CityInfo.tradeNextImportResourceDocker;
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (!BuildingIsInUse(i) || Data_Buildings[i].type != BUILDING_WAREHOUSE) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_WAREHOUSE) {
+		if (!BuildingIsInUse(i)) {
 			continue;
 		}
 		if (!Data_Buildings[i].hasRoadAccess || Data_Buildings[i].distanceFromEntry <= 0) {
@@ -368,8 +369,8 @@ int Trader_getClosestWarehouseForExportDocker(int x, int y, int cityId, int dist
 	int minBuildingId = 0;
 	int resourceId = Data_CityInfo.tradeNextExportResourceDocker;
 	
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (!BuildingIsInUse(i) || Data_Buildings[i].type != BUILDING_WAREHOUSE) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_WAREHOUSE) {
+		if (!BuildingIsInUse(i)) {
 			continue;
 		}
 		if (!Data_Buildings[i].hasRoadAccess || Data_Buildings[i].distanceFromEntry <= 0) {
@@ -253,7 +253,7 @@ void UI_BuildingInfo_init()
 	for (int i = 0; i < 7; i++) {
 		context.figure.figureIds[i] = 0;
 	}
-	static const int figureOffsets[] = {0, -162, 162, 1, -1, -163, -161, 161, 163};
+	static const int figureOffsets[] = {0, GridDelta(0, -1), GridDelta(0, 1), 1, -1, GridDelta(-1, -1), GridDelta(1, -1), GridDelta(-1, 1), GridDelta(1, 1)};
 	for (int i = 0; i < 9 && context.figure.count < 7; i++) {
 		int figureId = Data_Grid_figureIds[gridOffset + figureOffsets[i]];
 		while (figureId > 0 && context.figure.count < 7) {
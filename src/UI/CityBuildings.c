@@ -603,8 +603,8 @@ static void updateCityViewCoords(const mouse *m)
 	int gridOffset = Data_Settings_Map.current.gridOffset =
 		CityView_pixelCoordsToGridOffset(m->x, m->y);
 	if (gridOffset) {
-		Data_Settings_Map.current.x = (gridOffset - Data_Settings_Map.gridStartOffset) % 162;
-		Data_Settings_Map.current.y = (gridOffset - Data_Settings_Map.gridStartOffset) / 162;
+		Data_Settings_Map.current.x = (gridOffset - Data_Settings_Map.gridStartOffset) % GRID_SIZE;
+		Data_Settings_Map.current.y = (gridOffset - Data_Settings_Map.gridStartOffset) / GRID_SIZE;
 	}
 }
 
@@ -42,28 +42,28 @@ static const int yViewOffsets[25] = {
 
 static const int tileGridOffsets[4][25] = {
 	{0,
-	162, 1, 163,
-	324, 2, 325, 164, 326,
-	486, 3, 487, 165, 488, 327, 489,
-	648, 4, 649, 166, 650, 328, 651, 490, 652},
+	GridDelta(0, 1), 1, GridDelta(1, 1),
+	GridDelta(0, 2), 2, GridDelta(1, 2), GridDelta(2, 1), GridDelta(2, 2),
+	GridDelta(0, 3), 3, GridDelta(1, 3), GridDelta(3, 1), GridDelta(2, 3), GridDelta(3, 2), GridDelta(3, 3),
+	GridDelta(0, 4), 4, GridDelta(1, 4), GridDelta(4, 1), GridDelta(2, 4), GridDelta(4, 2), GridDelta(3, 4), GridDelta(4, 3), GridDelta(4, 4)},
 	{0,
-	-1, 162, 161,
-	-2, 324, 160, 323, 322,
-	-3, 486, 159, 485, 321, 484, 483,
-	-4, 648, 158, 647, 320, 646, 482, 645, 644},
+	-1, GridDelta(0, 1), GridDelta(-1, 1),
+	-2, GridDelta(0, 2), GridDelta(-2, 1), GridDelta(-1, 2), GridDelta(-2, 2),
+	-3, GridDelta(0, 3), GridDelta(-3, 1), GridDelta(-1, 3), GridDelta(-3, 2), GridDelta(-2, 3), GridDelta(-3, 3),
+	-4, GridDelta(0, 4), GridDelta(-4, 1), GridDelta(-1, 4), GridDelta(-4, 2), GridDelta(-2, 4), GridDelta(-4, 3), GridDelta(-3, 4), GridDelta(-4, 4)},
 	{0,
-	-162, -1, -163,
-	-324, -2, -325, -164, -326,
-	-486, -3, -487, -165, -488, -327, -489,
-	-648, -4, -649, -166, -650, -328, -651, -490, -652},
+	GridDelta(0, -1), -1, GridDelta(-1, -1),
+	GridDelta(0, -2), -2, GridDelta(-1, -2), GridDelta(-2, -1), GridDelta(-2, -2),
+	GridDelta(0, -3), -3, GridDelta(-1, -3), GridDelta(-3, -1), GridDelta(-2, -3), GridDelta(-3, -2), GridDelta(-3, -3),
+	GridDelta(0, -4), -4, GridDelta(-1, -4), GridDelta(-4, -1), GridDelta(-2, -4), GridDelta(-4, -2), GridDelta(-3, -4), GridDelta(-4, -3), GridDelta(-4, -4)},
 	{0,
-	1, -162, -161,
-	2, -324, -160, -323, -322,
-	3, -486, -159, -485, -321, -484, -483,
-	4, -648, -158, -647, -320, -646, -482, -645, -644},
+	1, GridDelta(0, -1), GridDelta(1, -1),
+	2, GridDelta(0, -2), GridDelta(2, -1), GridDelta(1, -2), GridDelta(2, -2),
+	3, GridDelta(0, -3), GridDelta(3, -1), GridDelta(1, -3), GridDelta(3, -2), GridDelta(2, -3), GridDelta(3, -3),
+	4, GridDelta(0, -4), GridDelta(4, -1), GridDelta(1, -4), GridDelta(4, -2), GridDelta(2, -4), GridDelta(4, -3), GridDelta(3, -4), GridDelta(4, -4)},
 };
 
-static const int fortGroundGridOffsets[4] = {-159, -158, 4, 3};
+static const int fortGroundGridOffsets[4] = {GridDelta(3, -1), GridDelta(4, -1), 4, 3};
 static const int fortGroundXViewOffsets[4] = {120, 90, -120, -90};
 static const int fortGroundYViewOffsets[4] = {30, -75, -60, 45};
 
@@ -422,7 +422,7 @@ static void drawBuildingGhostAqueduct()
 		if (Data_Grid_terrain[gridOffset] & Terrain_Road) {
 			int groupOffset = graphic->groupOffset;
 			if (!graphic->aqueductOffset) {
-				if (Data_Grid_terrain[gridOffset - 162] & Terrain_Road) {
+				if (Data_Grid_terrain[gridOffset - GRID_SIZE] & Terrain_Road) {
 					groupOffset = 3;
 				} else {
 					groupOffset = 2;
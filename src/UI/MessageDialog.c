@@ -561,7 +561,7 @@ static void buttonGoToProblem(int param1, int param2)
 			gridOffset = invasionGridOffset;
 		}
 	}
-	if (gridOffset > 0 && gridOffset < 26244) {
+	if (gridOffset > 0 && gridOffset < GRID_SIZE * GRID_SIZE) {
 		CityView_goToGridOffset(gridOffset);
 	}
 	UI_Window_goTo(Window_City);
@@ -1,5 +1,6 @@
 #include "Undo.h"
 
+#include "Building.h"
 #include "Grid.h"
 #include "Resource.h"
 #include "Routing.h"
@@ -46,7 +47,7 @@ int Undo_recordBeforeBuild()
 	data.buildingCost = 0;
 	data.buildingType = Data_State.selectedBuilding.type;
 	clearBuildingList();
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	for (int i = 1; i < Data_Buildings_Extra.capacity; i++) {
 		if (Data_Buildings[i].state == BuildingState_Undo) {
 			Data_State.undoAvailable = 0;
 			return 0;
@@ -187,6 +188,7 @@ void Undo_perform()
 				int buildingId = data.buildingIndex[i];
 				memcpy(&Data_Buildings[buildingId], &data.buildings[i],
 					sizeof(struct Data_Building));
+				Building_updateIndex(buildingId);
 				placeBuildingOnTerrain(buildingId);
 			}
 		}
@@ -12,35 +12,83 @@
 #include "Data/Scenario.h"
 #include "Data/Settings.h"
 
+#include "building/index.h"
 #include "building/list.h"
+#include "core/jobs.h"
 #include "graphics/image.h"
+#include "map/aqueduct.h"
 
 #include <string.h>
 
-static const int adjacentOffsets[] = {-162, 1, 162, -1};
-static short queue[1000];
+static const int adjacentOffsets[] = {GridDelta(0, -1), 1, GridDelta(0, 1), -1};
+static int queue[1000];
 static int qHead;
 static int qTail;
 
-void UtilityManagement_updateHouseWaterAccess()
+enum {
+	RoadNetworkTile_Connected = 1,
+	RoadNetworkTile_Road = 2
+};
+
+// Road networks as union-find over the tiles, updated from the changed tiles only
+static struct {
+	int valid;
+	int terrainVersion;
+	unsigned char state[GRID_SIZE * GRID_SIZE];
+	int parent[GRID_SIZE * GRID_SIZE];
+	int size[GRID_SIZE * GRID_SIZE];
+	int numAdded;
+	int numRemoved;
+	int added[GRID_SIZE * GRID_SIZE];
+	int removed[GRID_SIZE * GRID_SIZE];
+	int visitGeneration;
+	int visited[GRID_SIZE * GRID_SIZE];
+	int items[GRID_SIZE * GRID_SIZE];
+} roadNetworks;
+
+#if MAP_AQUEDUCT_MAX_RESERVOIRS < MAX_BUILDINGS
+#error "MAP_AQUEDUCT_MAX_RESERVOIRS must hold all buildings"
+#endif
+
+// Reservoirs and fountains of the last update: the aqueduct water is only updated when they change
+static struct {
+	int valid;
+	int terrainVersion;
+	int numReservoirs;
+	int reservoirs[MAX_BUILDINGS]; // building id, negative when next to water
+	int numFountains;
+	int fountains[MAX_BUILDINGS];
+	int fountainRadius;
+	int fullReservoirs[MAX_BUILDINGS];
+} water;
+
+// Each house only writes its own water access: ranges of houses run on the job system
+static void updateFountainAccess(int firstBuildingId, int endBuildingId, void *unused)
 {
-    building_list_small_clear();
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (!BuildingIsInUse(i)) {
+	for (int i = firstBuildingId; i < endBuildingId; i++) {
+		struct Data_Building *b = &Data_Buildings[i];
+		if (!BuildingIsInUse(i) || !b->houseSize ||
+			b->type < BUILDING_HOUSE_VACANT_LOT || b->type > BUILDING_HOUSE_LUXURY_PALACE) {
 			continue;
 		}
-		if (Data_Buildings[i].type == BUILDING_WELL) {
+		b->hasWaterAccess = 0;
+		b->hasWellAccess = 0;
+		if (Terrain_existsTileWithinAreaWithType(b->x, b->y, b->size, Terrain_FountainRange)) {
+			b->hasWaterAccess = 1;
+		}
+	}
+}
+
+void UtilityManagement_updateHouseWaterAccess()
+{
+    building_list_small_clear();
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_WELL) {
+		if (BuildingIsInUse(i)) {
 			building_list_small_add(i);
-		} else if (Data_Buildings[i].houseSize) {
-			Data_Buildings[i].hasWaterAccess = 0;
-			Data_Buildings[i].hasWellAccess = 0;
-			if (Terrain_existsTileWithinAreaWithType(
-				Data_Buildings[i].x, Data_Buildings[i].y,
-				Data_Buildings[i].size, Terrain_FountainRange)) {
-				Data_Buildings[i].hasWaterAccess = 1;
-			}
 		}
 	}
+	jobs_parallel_for(1, Data_Buildings_Extra.capacity, 256, updateFountainAccess, 0);
+	// wells write to the houses around them, so they stay serial
 	int total_wells = building_list_small_size();
     const int *wells = building_list_small_items();
     for (int i = 0; i < total_wells; i++) {
@@ -49,114 +97,117 @@ void UtilityManagement_updateHouseWaterAccess()
 }
 
 
-static void setAllAqueductsToNoWater()
+static int aqueductTileType(int gridOffset)
 {
-	int graphicId = image_group(ID_Graphic_Aqueduct) + 15;
-	int gridOffset = Data_Settings_Map.gridStartOffset;
-	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
-		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
-			if (Data_Grid_terrain[gridOffset] & Terrain_Aqueduct) {
-				Data_Grid_aqueducts[gridOffset] = 0;
-				if (Data_Grid_graphicIds[gridOffset] < graphicId) {
-					Data_Grid_graphicIds[gridOffset] += 15;
-				}
-			}
+	int buildingId = Data_Grid_buildingIds[gridOffset];
+	if (buildingId && Data_Buildings[buildingId].type == BUILDING_RESERVOIR) {
+		// check if aqueduct connects to reservoir --> doesn't connect to corner
+		int xy = Data_Grid_edge[gridOffset] & Edge_MaskXY;
+		if (xy != Edge_X0Y0 && xy != Edge_X2Y0 && xy != Edge_X0Y2 && xy != Edge_X2Y2) {
+			return buildingId;
 		}
+		return MAP_AQUEDUCT_NONE;
 	}
+	return Data_Grid_terrain[gridOffset] & Terrain_Aqueduct ? MAP_AQUEDUCT_PIPE : MAP_AQUEDUCT_NONE;
 }
 
-static void fillAqueductsFromOffset(int gridOffset)
+static int reservoirOffset(int buildingId)
 {
-	if (!(Data_Grid_terrain[gridOffset] & Terrain_Aqueduct)) {
-		return;
+	return Data_Buildings[buildingId].gridOffset;
+}
+
+static int reservoirReached(int buildingId)
+{
+	struct Data_Building *b = &Data_Buildings[buildingId];
+	if (b->hasWaterAccess) {
+		return 0;
 	}
-	memset(queue, 0, sizeof(queue));
-	qHead = qTail = 0;
-	int guard = 0;
-	int nextOffset;
-	int graphicWithoutWater = image_group(ID_Graphic_Aqueduct) + 15;
-	do {
-		if (++guard >= GRID_SIZE * GRID_SIZE) {
-			break;
+	b->hasWaterAccess = 2;
+	return BuildingIsInUse(buildingId);
+}
+
+// Fills the aqueducts from the reservoirs and only touches aqueduct tiles whose water changed
+static void updateAqueductWater()
+{
+	map_aqueduct_grid grid = {
+		Data_Settings_Map.gridStartOffset, Data_Settings_Map.width, Data_Settings_Map.height,
+		aqueductTileType, reservoirOffset
+	};
+	map_aqueduct_build(&grid);
+	int total_reservoirs = building_list_large_size();
+	const int *reservoirs = building_list_large_items();
+	int numFull = 0;
+	for (int i = 0; i < total_reservoirs; i++) {
+		if (Data_Buildings[reservoirs[i]].hasWaterAccess == 2) {
+			water.fullReservoirs[numFull++] = reservoirs[i];
 		}
-		Data_Grid_aqueducts[gridOffset] = 1;
-		if (Data_Grid_graphicIds[gridOffset] >= graphicWithoutWater) {
-			Data_Grid_graphicIds[gridOffset] -= 15;
+	}
+	map_aqueduct_fill(water.fullReservoirs, numFull, reservoirReached);
+	// reservoirs in use that got water fill their aqueducts, which marks them as done
+	for (int i = 0; i < total_reservoirs; i++) {
+		if (Data_Buildings[reservoirs[i]].hasWaterAccess == 2) {
+			Data_Buildings[reservoirs[i]].hasWaterAccess = 1;
 		}
-		nextOffset = -1;
-		for (int i = 0; i < 4; i++) {
-			int newOffset = gridOffset + adjacentOffsets[i];
-			int buildingId = Data_Grid_buildingIds[newOffset];
-			if (buildingId && Data_Buildings[buildingId].type == BUILDING_RESERVOIR) {
-				// check if aqueduct connects to reservoir --> doesn't connect to corner
-				int xy = Data_Grid_edge[newOffset] & Edge_MaskXY;
-				if (xy != Edge_X0Y0 && xy != Edge_X2Y0 && xy != Edge_X0Y2 && xy != Edge_X2Y2) {
-					if (!Data_Buildings[buildingId].hasWaterAccess) {
-						Data_Buildings[buildingId].hasWaterAccess = 2;
-					}
+	}
+	int graphicWithoutWater = image_group(ID_Graphic_Aqueduct) + 15;
+	int gridOffset = Data_Settings_Map.gridStartOffset;
+	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
+		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
+			if (!(Data_Grid_terrain[gridOffset] & Terrain_Aqueduct)) {
+				continue;
+			}
+			if (map_aqueduct_has_water(gridOffset)) {
+				Data_Grid_aqueducts[gridOffset] = 1;
+				if (Data_Grid_graphicIds[gridOffset] >= graphicWithoutWater) {
+					Data_Grid_graphicIds[gridOffset] -= 15;
 				}
-			} else if (Data_Grid_terrain[newOffset] & Terrain_Aqueduct) {
-				if (!Data_Grid_aqueducts[newOffset]) {
-					if (nextOffset == -1) {
-						nextOffset = newOffset;
-					} else {
-						queue[qTail++] = newOffset;
-						if (qTail >= 1000) {
-							qTail = 0;
-						}
-					}
+			} else {
+				Data_Grid_aqueducts[gridOffset] = 0;
+				if (Data_Grid_graphicIds[gridOffset] < graphicWithoutWater) {
+					Data_Grid_graphicIds[gridOffset] += 15;
 				}
 			}
 		}
-		if (nextOffset == -1) {
-			if (qHead == qTail) {
-				return;
-			}
-			nextOffset = queue[qHead++];
-			if (qHead >= 1000) {
-				qHead = 0;
-			}
-		}
-		gridOffset = nextOffset;
-	} while (nextOffset > -1);
+	}
 }
 
-void UtilityManagement_updateReservoirFountain()
+// Gathers the reservoirs and checks whether they or the aqueducts changed since the last update
+static int reservoirsChanged()
 {
-	Grid_andShortGrid(Data_Grid_terrain, ~(Terrain_FountainRange | Terrain_ReservoirRange));
-	// reservoirs
-	setAllAqueductsToNoWater();
+	int changed = !water.valid || water.terrainVersion != Routing_getTerrainVersion();
 	building_list_large_clear(1);
-	// mark reservoirs next to water
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
-		if (BuildingIsInUse(i) && Data_Buildings[i].type == BUILDING_RESERVOIR) {
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_RESERVOIR) {
+		if (BuildingIsInUse(i)) {
+			int index = building_list_large_size();
 			building_list_large_add(i);
-			if (Terrain_existsTileWithinAreaWithType(
-				Data_Buildings[i].x - 1, Data_Buildings[i].y - 1, 5, Terrain_Water)) {
-				Data_Buildings[i].hasWaterAccess = 2;
-			} else {
-				Data_Buildings[i].hasWaterAccess = 0;
+			int nearWater = Terrain_existsTileWithinAreaWithType(
+				Data_Buildings[i].x - 1, Data_Buildings[i].y - 1, 5, Terrain_Water);
+			int key = nearWater ? -i : i;
+			if (index >= water.numReservoirs || water.reservoirs[index] != key) {
+				changed = 1;
 			}
+			water.reservoirs[index] = key;
 		}
 	}
+	if (building_list_large_size() != water.numReservoirs) {
+		changed = 1;
+	}
+	water.numReservoirs = building_list_large_size();
+	water.terrainVersion = Routing_getTerrainVersion();
+	water.valid = 1;
+	return changed;
+}
+
+static void updateReservoirs()
+{
+	Grid_andShortGrid(Data_Grid_terrain, ~Terrain_ReservoirRange);
 	int total_reservoirs = building_list_large_size();
 	const int *reservoirs = building_list_large_items();
-	// fill reservoirs from full ones
-	int changed = 1;
-	static const int connectorOffsets[] = {-161, 165, 487, 161};
-	while (changed == 1) {
-		changed = 0;
-		for (int i = 0; i < total_reservoirs; i++) {
-			int buildingId = reservoirs[i];
-			if (Data_Buildings[buildingId].hasWaterAccess == 2) {
-				Data_Buildings[buildingId].hasWaterAccess = 1;
-				changed = 1;
-				for (int d = 0; d < 4; d++) {
-					fillAqueductsFromOffset(Data_Buildings[buildingId].gridOffset + connectorOffsets[d]);
-				}
-			}
-		}
+	// mark reservoirs next to water
+	for (int i = 0; i < total_reservoirs; i++) {
+		Data_Buildings[reservoirs[i]].hasWaterAccess = water.reservoirs[i] < 0 ? 2 : 0;
 	}
+	updateAqueductWater();
 	// mark reservoir ranges
 	for (int i = 0; i < total_reservoirs; i++) {
 		int buildingId = reservoirs[i];
@@ -166,10 +217,22 @@ void UtilityManagement_updateReservoirFountain()
 				3, 10, Terrain_ReservoirRange);
 		}
 	}
+}
+
+void UtilityManagement_updateReservoirFountain()
+{
+	int reservoirsUpdated = 0;
+	if (reservoirsChanged()) {
+		updateReservoirs();
+		reservoirsUpdated = 1;
+	}
 	// fountains
-	for (int i = 1; i < MAX_BUILDINGS; i++) {
+	int radius = Data_Scenario.climate == Climate_Desert ? 3 : 4;
+	int numFountains = 0;
+	int fountainsChanged = reservoirsUpdated || radius != water.fountainRadius;
+	FOR_EACH_BUILDING_OF_TYPE(i, BUILDING_FOUNTAIN) {
 		struct Data_Building *b = &Data_Buildings[i];
-		if (!BuildingIsInUse(i) || b->type != BUILDING_FOUNTAIN) {
+		if (!BuildingIsInUse(i)) {
 			continue;
 		}
 		int des = Data_Grid_desirability[b->gridOffset];
@@ -183,16 +246,32 @@ void UtilityManagement_updateReservoirFountain()
 		} else {
 			graphicId = image_group(ID_Graphic_Fountain1);
 		}
-		Terrain_addBuildingToGrids(i, b->x, b->y, 1, graphicId, Terrain_Building);
+		if (Data_Grid_graphicIds[b->gridOffset] != graphicId || Data_Grid_buildingIds[b->gridOffset] != i) {
+			Terrain_addBuildingToGrids(i, b->x, b->y, 1, graphicId, Terrain_Building);
+		}
 		if ((Data_Grid_terrain[b->gridOffset] & Terrain_ReservoirRange) && b->numWorkers) {
 			b->hasWaterAccess = 1;
-			Terrain_setWithRadius(b->x, b->y, 1,
-				Data_Scenario.climate == Climate_Desert ? 3 : 4,
-				Terrain_FountainRange);
+			if (numFountains >= water.numFountains || water.fountains[numFountains] != i) {
+				fountainsChanged = 1;
+			}
+			water.fountains[numFountains++] = i;
 		} else {
 			b->hasWaterAccess = 0;
 		}
 	}
+	if (numFountains != water.numFountains) {
+		fountainsChanged = 1;
+	}
+	water.numFountains = numFountains;
+	water.fountainRadius = radius;
+	// fountain ranges only change with the working fountains or the reservoir ranges
+	if (fountainsChanged) {
+		Grid_andShortGrid(Data_Grid_terrain, ~Terrain_FountainRange);
+		for (int i = 0; i < numFountains; i++) {
+			struct Data_Building *b = &Data_Buildings[water.fountains[i]];
+			Terrain_setWithRadius(b->x, b->y, 1, radius, Terrain_FountainRange);
+		}
+	}
 }
 
 static int markRoadNetwork(int gridOffset, unsigned char roadNetworkId)
@@ -242,7 +321,7 @@ static int markRoadNetwork(int gridOffset, unsigned char roadNetworkId)
 	return size;
 }
 
-void UtilityManagement_determineRoadNetworks()
+static void determineRoadNetworksByFlooding()
 {
 	for (int i = 0; i < 10; i++) {
 		Data_CityInfo.largestRoadNetworks[i].id = 0;
@@ -272,3 +351,203 @@ void UtilityManagement_determineRoadNetworks()
 		}
 	}
 }
+
+static int isRoadNetworkTile(int gridOffset)
+{
+	int land = Data_Grid_routingLandCitizen[gridOffset];
+	return land == Routing_Citizen_0_Road ||
+		(land == Routing_Citizen_2_PassableTerrain && Data_Grid_terrain[gridOffset] & Terrain_AccessRamp);
+}
+
+static int findRoot(int gridOffset)
+{
+	int root = gridOffset;
+	while (roadNetworks.parent[root] != root) {
+		root = roadNetworks.parent[root];
+	}
+	while (roadNetworks.parent[gridOffset] != root) {
+		int next = roadNetworks.parent[gridOffset];
+		roadNetworks.parent[gridOffset] = root;
+		gridOffset = next;
+	}
+	return root;
+}
+
+static void unite(int gridOffset1, int gridOffset2)
+{
+	int root1 = findRoot(gridOffset1);
+	int root2 = findRoot(gridOffset2);
+	if (root1 == root2) {
+		return;
+	}
+	if (roadNetworks.size[root1] < roadNetworks.size[root2]) {
+		int tmp = root1;
+		root1 = root2;
+		root2 = tmp;
+	}
+	roadNetworks.parent[root2] = root1;
+	roadNetworks.size[root1] += roadNetworks.size[root2];
+}
+
+static void addTile(int gridOffset)
+{
+	roadNetworks.state[gridOffset] |= RoadNetworkTile_Connected;
+	roadNetworks.parent[gridOffset] = gridOffset;
+	roadNetworks.size[gridOffset] = 1;
+	for (int i = 0; i < 4; i++) {
+		int newOffset = gridOffset + adjacentOffsets[i];
+		if (roadNetworks.state[newOffset] & RoadNetworkTile_Connected) {
+			unite(gridOffset, newOffset);
+		}
+	}
+}
+
+// Gives the network around the tile a new root, used when a removed tile may have split it
+static void relabelNetwork(int gridOffset)
+{
+	if (roadNetworks.visited[gridOffset] == roadNetworks.visitGeneration) {
+		return;
+	}
+	int head = 0;
+	int tail = 0;
+	roadNetworks.items[tail++] = gridOffset;
+	roadNetworks.visited[gridOffset] = roadNetworks.visitGeneration;
+	while (head < tail) {
+		int offset = roadNetworks.items[head++];
+		roadNetworks.parent[offset] = gridOffset;
+		for (int i = 0; i < 4; i++) {
+			int newOffset = offset + adjacentOffsets[i];
+			if (roadNetworks.state[newOffset] & RoadNetworkTile_Connected &&
+				roadNetworks.visited[newOffset] != roadNetworks.visitGeneration) {
+				roadNetworks.visited[newOffset] = roadNetworks.visitGeneration;
+				roadNetworks.items[tail++] = newOffset;
+			}
+		}
+	}
+	roadNetworks.size[gridOffset] = tail;
+}
+
+static void removeTiles()
+{
+	for (int i = 0; i < roadNetworks.numRemoved; i++) {
+		int gridOffset = roadNetworks.removed[i];
+		roadNetworks.state[gridOffset] &= ~RoadNetworkTile_Connected;
+	}
+	if (++roadNetworks.visitGeneration == 0) {
+		memset(roadNetworks.visited, 0, sizeof(roadNetworks.visited));
+		roadNetworks.visitGeneration = 1;
+	}
+	for (int i = 0; i < roadNetworks.numRemoved; i++) {
+		int gridOffset = roadNetworks.removed[i];
+		for (int n = 0; n < 4; n++) {
+			int newOffset = gridOffset + adjacentOffsets[n];
+			if (roadNetworks.state[newOffset] & RoadNetworkTile_Connected) {
+				relabelNetwork(newOffset);
+			}
+		}
+	}
+}
+
+static int findChanges()
+{
+	int changed = 0;
+	roadNetworks.numAdded = roadNetworks.numRemoved = 0;
+	int gridOffset = Data_Settings_Map.gridStartOffset;
+	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
+		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
+			int connected = isRoadNetworkTile(gridOffset) ? RoadNetworkTile_Connected : 0;
+			int road = Data_Grid_terrain[gridOffset] & Terrain_Road ? RoadNetworkTile_Road : 0;
+			int state = roadNetworks.state[gridOffset];
+			if (state == (connected | road)) {
+				continue;
+			}
+			changed = 1;
+			roadNetworks.state[gridOffset] = (state & RoadNetworkTile_Connected) | road;
+			if (connected && !(state & RoadNetworkTile_Connected)) {
+				roadNetworks.added[roadNetworks.numAdded++] = gridOffset;
+			} else if (!connected && (state & RoadNetworkTile_Connected)) {
+				roadNetworks.removed[roadNetworks.numRemoved++] = gridOffset;
+			}
+		}
+	}
+	return changed;
+}
+
+// Numbers the networks in the order the full flood fill finds them, returns 0 if the IDs do not fit
+static int labelRoadNetworks()
+{
+	for (int i = 0; i < 10; i++) {
+		Data_CityInfo.largestRoadNetworks[i].id = 0;
+		Data_CityInfo.largestRoadNetworks[i].size = 0;
+	}
+	Grid_clearUByteGrid(Data_Grid_roadNetworks);
+	int roadNetworkId = 1;
+	int gridOffset = Data_Settings_Map.gridStartOffset;
+	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
+		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
+			if (!(roadNetworks.state[gridOffset] & RoadNetworkTile_Road) ||
+				!(roadNetworks.state[gridOffset] & RoadNetworkTile_Connected)) {
+				continue;
+			}
+			int root = findRoot(gridOffset);
+			if (Data_Grid_roadNetworks[root]) {
+				continue;
+			}
+			if (roadNetworkId > 255) {
+				return 0;
+			}
+			Data_Grid_roadNetworks[root] = roadNetworkId;
+			int size = roadNetworks.size[root];
+			for (int n = 0; n < 10; n++) {
+				if (size > Data_CityInfo.largestRoadNetworks[n].size) {
+					// move everyone down
+					for (int m = 9; m > n; m--) {
+						Data_CityInfo.largestRoadNetworks[m].id = Data_CityInfo.largestRoadNetworks[m-1].id;
+						Data_CityInfo.largestRoadNetworks[m].size = Data_CityInfo.largestRoadNetworks[m-1].size;
+					}
+					Data_CityInfo.largestRoadNetworks[n].id = roadNetworkId;
+					Data_CityInfo.largestRoadNetworks[n].size = size;
+					break;
+				}
+			}
+			roadNetworkId++;
+		}
+	}
+	gridOffset = Data_Settings_Map.gridStartOffset;
+	for (int y = 0; y < Data_Settings_Map.height; y++, gridOffset += Data_Settings_Map.gridBorderSize) {
+		for (int x = 0; x < Data_Settings_Map.width; x++, gridOffset++) {
+			if (roadNetworks.state[gridOffset] & RoadNetworkTile_Connected) {
+				Data_Grid_roadNetworks[gridOffset] = Data_Grid_roadNetworks[findRoot(gridOffset)];
+			}
+		}
+	}
+	return 1;
+}
+
+void UtilityManagement_determineRoadNetworks()
+{
+	if (roadNetworks.valid && roadNetworks.terrainVersion == Routing_getTerrainVersion()) {
+		return;
+	}
+	if (!roadNetworks.valid) {
+		memset(roadNetworks.state, 0, sizeof(roadNetworks.state));
+	}
+	roadNetworks.terrainVersion = Routing_getTerrainVersion();
+	if (!findChanges() && roadNetworks.valid) {
+		return;
+	}
+	roadNetworks.valid = 1;
+	removeTiles();
+	for (int i = 0; i < roadNetworks.numAdded; i++) {
+		addTile(roadNetworks.added[i]);
+	}
+	if (!labelRoadNetworks()) {
+		determineRoadNetworksByFlooding();
+	}
+}
+
+void UtilityManagement_clearRoadNetworks()
+{
+	Grid_clearUByteGrid(Data_Grid_roadNetworks);
+	roadNetworks.valid = 0;
+}
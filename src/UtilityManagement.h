@@ -1,9 +1,14 @@
 #ifndef UTILITYMANAGEMENT_H
 #define UTILITYMANAGEMENT_H
 
+// Reads: house positions, Data_Grid_terrain, wells
+// Writes: house hasWaterAccess and hasWellAccess
+// Fountain access is checked on the job system, wells run serially; no random numbers are drawn
 void UtilityManagement_updateHouseWaterAccess();
 void UtilityManagement_updateReservoirFountain();
 
 void UtilityManagement_determineRoadNetworks();
+// clears the road networks, the next determine labels all of them again
+void UtilityManagement_clearRoadNetworks();
 
 #endif
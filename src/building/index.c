@@ -0,0 +1,166 @@
+#include "index.h"
+
+#include <string.h>
+
+struct link {
+    int prev;
+    int next;
+};
+
+struct type_list {
+    int first;
+    int last;
+    int count;
+};
+
+static struct {
+    char indexed[BUILDING_INDEX_MAX_BUILDINGS];
+    int type[BUILDING_INDEX_MAX_BUILDINGS];
+    struct link by_type[BUILDING_INDEX_MAX_BUILDINGS];
+    struct link all[BUILDING_INDEX_MAX_BUILDINGS];
+    struct type_list types[BUILDING_TYPE_MAX];
+    int first;
+    int last;
+} data;
+
+static int is_valid(int building_id)
+{
+    return building_id > 0 && building_id < BUILDING_INDEX_MAX_BUILDINGS;
+}
+
+static int is_indexed(int building_id)
+{
+    return is_valid(building_id) && data.indexed[building_id];
+}
+
+void building_index_clear()
+{
+    memset(&data, 0, sizeof(data));
+}
+
+static void insert(struct link *links, int *first, int *last, int prev, int building_id)
+{
+    int next = prev ? links[prev].next : *first;
+    links[building_id].prev = prev;
+    links[building_id].next = next;
+    if (prev) {
+        links[prev].next = building_id;
+    } else {
+        *first = building_id;
+    }
+    if (next) {
+        links[next].prev = building_id;
+    } else {
+        *last = building_id;
+    }
+}
+
+static void remove_link(struct link *links, int *first, int *last, int building_id)
+{
+    int prev = links[building_id].prev;
+    int next = links[building_id].next;
+    if (prev) {
+        links[prev].next = next;
+    } else {
+        *first = next;
+    }
+    if (next) {
+        links[next].prev = prev;
+    } else {
+        *last = prev;
+    }
+    links[building_id].prev = links[building_id].next = 0;
+}
+
+static void add_to_type(int building_id, building_type type)
+{
+    struct type_list *list = &data.types[type];
+    // new buildings mostly get the highest ID of their type, so search backwards
+    int prev = list->last;
+    while (prev && prev > building_id) {
+        prev = data.by_type[prev].prev;
+    }
+    insert(data.by_type, &list->first, &list->last, prev, building_id);
+    list->count++;
+    data.indexed[building_id] = 1;
+    data.type[building_id] = type;
+}
+
+static void remove_from_type(int building_id)
+{
+    struct type_list *list = &data.types[data.type[building_id]];
+    remove_link(data.by_type, &list->first, &list->last, building_id);
+    list->count--;
+    data.indexed[building_id] = 0;
+}
+
+void building_index_add(int building_id, building_type type)
+{
+    if (!is_valid(building_id) || type < 0 || type >= BUILDING_TYPE_MAX) {
+        return;
+    }
+    if (is_indexed(building_id)) {
+        if (data.type[building_id] != type) {
+            remove_from_type(building_id);
+            add_to_type(building_id, type);
+        }
+        return;
+    }
+    int prev = building_id - 1;
+    while (prev > 0 && !data.indexed[prev]) {
+        prev--;
+    }
+    insert(data.all, &data.first, &data.last, prev, building_id);
+    add_to_type(building_id, type);
+}
+
+void building_index_remove(int building_id)
+{
+    if (!is_indexed(building_id)) {
+        return;
+    }
+    remove_link(data.all, &data.first, &data.last, building_id);
+    remove_from_type(building_id);
+}
+
+int building_index_contains(int building_id)
+{
+    return is_indexed(building_id);
+}
+
+int building_index_count(building_type type)
+{
+    return type >= 0 && type < BUILDING_TYPE_MAX ? data.types[type].count : 0;
+}
+
+int building_index_first(building_type type)
+{
+    return type >= 0 && type < BUILDING_TYPE_MAX ? data.types[type].first : 0;
+}
+
+int building_index_next(int building_id)
+{
+    return is_indexed(building_id) ? data.by_type[building_id].next : 0;
+}
+
+int building_index_find_next(building_type type, int building_id)
+{
+    if (is_indexed(building_id) && data.type[building_id] == (int) type) {
+        return data.by_type[building_id].next;
+    }
+    int id = building_index_first(type);
+    while (id && id <= building_id) {
+        id = data.by_type[id].next;
+    }
+    return id;
+}
+
+int building_index_first_of_any_type()
+{
+    return data.first;
+}
+
+int building_index_next_of_any_type(int building_id)
+{
+    return is_indexed(building_id) ? data.all[building_id].next : 0;
+}
@@ -0,0 +1,101 @@
+#ifndef BUILDING_INDEX_H
+#define BUILDING_INDEX_H
+
+#include "building/type.h"
+
+/**
+ * @file
+ * Index of the buildings in use, per building type.
+ *
+ * Each type keeps a linked list of its buildings sorted by ascending ID,
+ * so iterating over one type visits the buildings in the same order as a
+ * scan over all building IDs. The index is not saved: it is rebuilt from
+ * the building list after loading.
+ */
+
+#define BUILDING_INDEX_MAX_BUILDINGS 8000
+
+/**
+ * Iterates over all buildings of a type in ascending ID order.
+ * The building must not be removed from the index inside the loop.
+ */
+#define FOR_EACH_BUILDING_OF_TYPE(building_id, type) \
+    for (int building_id = building_index_first(type); building_id; \
+        building_id = building_index_next(building_id))
+
+/**
+ * Iterates over all indexed buildings in ascending ID order.
+ * The building must not be removed from the index inside the loop.
+ */
+#define FOR_EACH_INDEXED_BUILDING(building_id) \
+    for (int building_id = building_index_first_of_any_type(); building_id; \
+        building_id = building_index_next_of_any_type(building_id))
+
+/**
+ * Removes all buildings from the index
+ */
+void building_index_clear();
+
+/**
+ * Adds a building to the index, or moves it when its type has changed
+ * @param building_id Building ID
+ * @param type Building type
+ */
+void building_index_add(int building_id, building_type type);
+
+/**
+ * Removes a building from the index, does nothing if it is not indexed
+ * @param building_id Building ID
+ */
+void building_index_remove(int building_id);
+
+/**
+ * Returns whether the building is indexed
+ * @param building_id Building ID
+ * @return Boolean true if the building is indexed
+ */
+int building_index_contains(int building_id);
+
+/**
+ * Returns the number of indexed buildings of a type
+ * @param type Building type
+ * @return Number of buildings
+ */
+int building_index_count(building_type type);
+
+/**
+ * Returns the building of a type with the lowest ID
+ * @param type Building type
+ * @return Building ID, 0 if there are no buildings of the type
+ */
+int building_index_first(building_type type);
+
+/**
+ * Returns the next building of the same type
+ * @param building_id Indexed building ID
+ * @return Next building ID, 0 if this was the last one
+ */
+int building_index_next(int building_id);
+
+/**
+ * Returns the first building of a type with an ID higher than the given ID
+ * @param type Building type
+ * @param building_id Building ID, does not have to be indexed
+ * @return Building ID, 0 if there is no such building
+ */
+int building_index_find_next(building_type type, int building_id);
+
+/**
+ * Returns the indexed building with the lowest ID
+ * @return Building ID, 0 if the index is empty
+ */
+int building_index_first_of_any_type();
+
+/**
+ * Returns the next indexed building, regardless of type
+ * @param building_id Indexed building ID
+ * @return Next building ID, 0 if this was the last one
+ */
+int building_index_next_of_any_type(int building_id);
+
+#endif // BUILDING_INDEX_H
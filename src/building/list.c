@@ -3,7 +3,8 @@
 #include <string.h>
 
 #define MAX_SMALL 500
-#define MAX_LARGE 2000
+#define MAX_LARGE 8000
+#define MAX_LARGE_SAVED 2000
 
 static struct {
     struct {
@@ -69,7 +70,8 @@ void building_list_save_state(buffer *small, buffer *large)
     for (int i = 0; i < MAX_SMALL; i++) {
         buffer_write_i16(small, data.small.items[i]);
     }
-    for (int i = 0; i < MAX_LARGE; i++) {
+    // the save layout only has room for the first entries, the list is rebuilt before use anyway
+    for (int i = 0; i < MAX_LARGE_SAVED; i++) {
         buffer_write_i16(large, data.large.items[i]);
     }
 }
@@ -79,7 +81,7 @@ void building_list_load_state(buffer *small, buffer *large)
     for (int i = 0; i < MAX_SMALL; i++) {
         data.small.items[i] = buffer_read_i16(small);
     }
-    for (int i = 0; i < MAX_LARGE; i++) {
+    for (int i = 0; i < MAX_LARGE_SAVED; i++) {
         data.large.items[i] = buffer_read_i16(large);
     }
 }
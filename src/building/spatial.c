@@ -0,0 +1,182 @@
+#include "spatial.h"
+
+#include <string.h>
+
+#define BUCKETS_PER_SIDE ((BUILDING_SPATIAL_MAP_SIZE + BUILDING_SPATIAL_BUCKET_SIZE - 1) / BUILDING_SPATIAL_BUCKET_SIZE)
+#define NUM_BUCKETS (BUCKETS_PER_SIDE * BUCKETS_PER_SIDE)
+
+struct entry {
+    char indexed;
+    short type;
+    short bucket;
+    int prev;
+    int next;
+};
+
+static struct {
+    struct entry entries[BUILDING_SPATIAL_MAX_BUILDINGS];
+    int first[BUILDING_TYPE_MAX][NUM_BUCKETS];
+} data;
+
+struct result {
+    int k;
+    int count;
+    int distances[BUILDING_SPATIAL_MAX_K];
+    int *building_ids;
+};
+
+static int bucket_coordinate(int value)
+{
+    int bucket = value / BUILDING_SPATIAL_BUCKET_SIZE;
+    if (value < 0 || bucket < 0) {
+        return 0;
+    }
+    return bucket < BUCKETS_PER_SIDE ? bucket : BUCKETS_PER_SIDE - 1;
+}
+
+static int is_valid(int building_id)
+{
+    return building_id > 0 && building_id < BUILDING_SPATIAL_MAX_BUILDINGS;
+}
+
+void building_spatial_clear()
+{
+    memset(&data, 0, sizeof(data));
+}
+
+void building_spatial_remove(int building_id)
+{
+    if (!is_valid(building_id) || !data.entries[building_id].indexed) {
+        return;
+    }
+    struct entry *e = &data.entries[building_id];
+    if (e->prev) {
+        data.entries[e->prev].next = e->next;
+    } else {
+        data.first[e->type][e->bucket] = e->next;
+    }
+    if (e->next) {
+        data.entries[e->next].prev = e->prev;
+    }
+    memset(e, 0, sizeof(struct entry));
+}
+
+void building_spatial_update(int building_id, building_type type, int x, int y)
+{
+    if (!is_valid(building_id) || type < 0 || type >= BUILDING_TYPE_MAX) {
+        return;
+    }
+    int bucket = bucket_coordinate(y) * BUCKETS_PER_SIDE + bucket_coordinate(x);
+    struct entry *e = &data.entries[building_id];
+    if (e->indexed && e->type == type && e->bucket == bucket) {
+        return;
+    }
+    building_spatial_remove(building_id);
+    e->indexed = 1;
+    e->type = type;
+    e->bucket = bucket;
+    e->prev = 0;
+    e->next = data.first[type][bucket];
+    if (e->next) {
+        data.entries[e->next].prev = building_id;
+    }
+    data.first[type][bucket] = building_id;
+}
+
+static void add_candidate(struct result *result, int building_id, int distance)
+{
+    int index = result->count;
+    if (index == result->k) {
+        int worst = index - 1;
+        if (distance > result->distances[worst] ||
+            (distance == result->distances[worst] && building_id > result->building_ids[worst])) {
+            return;
+        }
+        index = worst;
+    } else {
+        result->count++;
+    }
+    while (index > 0 && (distance < result->distances[index - 1] ||
+        (distance == result->distances[index - 1] && building_id < result->building_ids[index - 1]))) {
+        result->distances[index] = result->distances[index - 1];
+        result->building_ids[index] = result->building_ids[index - 1];
+        index--;
+    }
+    result->distances[index] = distance;
+    result->building_ids[index] = building_id;
+}
+
+static void visit_bucket(struct result *result, int bucket, building_type first_type, building_type last_type,
+    int max_distance, building_spatial_distance distance, void *callback_data)
+{
+    for (int type = first_type; type <= last_type; type++) {
+        for (int id = data.first[type][bucket]; id; id = data.entries[id].next) {
+            int d = distance(id, callback_data);
+            if (d >= 0 && d < max_distance) {
+                add_candidate(result, id, d);
+            }
+        }
+    }
+}
+
+static int max_of(int a, int b)
+{
+    return a > b ? a : b;
+}
+
+int building_spatial_find_k_nearest(building_type first_type, building_type last_type, int x, int y,
+    int max_distance, building_spatial_distance distance, void *callback_data, int k, int *building_ids)
+{
+    if (first_type < 0) {
+        first_type = 0;
+    }
+    if (last_type >= BUILDING_TYPE_MAX) {
+        last_type = BUILDING_TYPE_MAX - 1;
+    }
+    if (k > BUILDING_SPATIAL_MAX_K) {
+        k = BUILDING_SPATIAL_MAX_K;
+    }
+    if (k <= 0 || first_type > last_type) {
+        return 0;
+    }
+    struct result result = {k, 0, {0}, building_ids};
+    int center_x = bucket_coordinate(x);
+    int center_y = bucket_coordinate(y);
+    int max_ring = max_of(max_of(center_x, BUCKETS_PER_SIDE - 1 - center_x),
+        max_of(center_y, BUCKETS_PER_SIDE - 1 - center_y));
+    for (int ring = 0; ring <= max_ring; ring++) {
+        // the query point lies in or beyond the center bucket, so buildings in this
+        // ring are at least this far away in x or y
+        int min_ring_distance = ring ? (ring - 1) * BUILDING_SPATIAL_BUCKET_SIZE + 1 : 0;
+        if (min_ring_distance >= max_distance) {
+            break;
+        }
+        if (result.count == k && min_ring_distance > result.distances[k - 1]) {
+            break;
+        }
+        for (int bucket_y = center_y - ring; bucket_y <= center_y + ring; bucket_y++) {
+            if (bucket_y < 0 || bucket_y >= BUCKETS_PER_SIDE) {
+                continue;
+            }
+            int on_edge = bucket_y == center_y - ring || bucket_y == center_y + ring;
+            int step = on_edge || ring == 0 ? 1 : 2 * ring;
+            for (int bucket_x = center_x - ring; bucket_x <= center_x + ring; bucket_x += step) {
+                if (bucket_x >= 0 && bucket_x < BUCKETS_PER_SIDE) {
+                    visit_bucket(&result, bucket_y * BUCKETS_PER_SIDE + bucket_x,
+                        first_type, last_type, max_distance, distance, callback_data);
+                }
+            }
+        }
+    }
+    return result.count;
+}
+
+int building_spatial_find_nearest(building_type first_type, building_type last_type, int x, int y,
+    int max_distance, building_spatial_distance distance, void *data)
+{
+    int building_id;
+    if (building_spatial_find_k_nearest(first_type, last_type, x, y, max_distance, distance, data, 1, &building_id)) {
+        return building_id;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#ifndef BUILDING_SPATIAL_H
+#define BUILDING_SPATIAL_H
+
+#include "building/type.h"
+
+/**
+ * @file
+ * Spatial index of buildings for nearest-building queries.
+ *
+ * Buildings are kept in a uniform grid of square buckets per building type.
+ * Queries visit the buckets in rings around the query point and stop as soon
+ * as no bucket further out can contain a closer building.
+ */
+
+#define BUILDING_SPATIAL_MAX_BUILDINGS 8000
+#ifdef GRID_SIZE
+#define BUILDING_SPATIAL_MAP_SIZE GRID_SIZE
+#else
+#define BUILDING_SPATIAL_MAP_SIZE 162
+#endif
+#define BUILDING_SPATIAL_BUCKET_SIZE 8
+#define BUILDING_SPATIAL_MAX_K 16
+
+/**
+ * Distance function for queries
+ * @param building_id Candidate building
+ * @param data Query data passed by the caller
+ * @return Distance to the building, which may not be less than the maximum of the
+ *         x and y distances between the query point and the building position,
+ *         or -1 to skip the building
+ */
+typedef int (*building_spatial_distance)(int building_id, void *data);
+
+/**
+ * Removes all buildings from the index
+ */
+void building_spatial_clear();
+
+/**
+ * Adds a building to the index, or updates it when its type or position changed
+ * @param building_id Building ID
+ * @param type Building type
+ * @param x X position of the building
+ * @param y Y position of the building
+ */
+void building_spatial_update(int building_id, building_type type, int x, int y);
+
+/**
+ * Removes a building from the index, does nothing if it is not indexed
+ * @param building_id Building ID
+ */
+void building_spatial_remove(int building_id);
+
+/**
+ * Finds the closest building of a range of types. Ties go to the lowest building ID,
+ * which gives the same result as checking all buildings in ID order.
+ * @param first_type First building type to consider
+ * @param last_type Last building type to consider, inclusive
+ * @param x X of the query point
+ * @param y Y of the query point
+ * @param max_distance Only buildings closer than this are returned
+ * @param distance Distance function, filters candidates as well
+ * @param data Data passed to the distance function
+ * @return Closest building ID, 0 if no building qualifies
+ */
+int building_spatial_find_nearest(building_type first_type, building_type last_type, int x, int y,
+    int max_distance, building_spatial_distance distance, void *data);
+
+/**
+ * Finds the k closest buildings of a range of types, ordered by distance and then ID
+ * @param first_type First building type to consider
+ * @param last_type Last building type to consider, inclusive
+ * @param x X of the query point
+ * @param y Y of the query point
+ * @param max_distance Only buildings closer than this are returned
+ * @param distance Distance function, filters candidates as well
+ * @param data Data passed to the distance function
+ * @param k Number of buildings to find, at most BUILDING_SPATIAL_MAX_K
+ * @param building_ids Array of size k to store the buildings in
+ * @return Number of buildings found
+ */
+int building_spatial_find_k_nearest(building_type first_type, building_type last_type, int x, int y,
+    int max_distance, building_spatial_distance distance, void *data, int k, int *building_ids);
+
+#endif // BUILDING_SPATIAL_H
@@ -0,0 +1,124 @@
+#include "core/id_pool.h"
+
+#include <string.h>
+
+#define NUM_WORDS (ID_POOL_MAX_IDS / 64)
+#define NUM_SUMMARY_WORDS (NUM_WORDS / 64)
+#define ALL_BITS 0xffffffffffffffffULL
+
+static int is_valid(const id_pool *pool, int id)
+{
+    return id > 0 && id < pool->size;
+}
+
+static void update_full_word(id_pool *pool, int word)
+{
+    if (pool->used[word] == ALL_BITS) {
+        pool->full_words[word / 64] |= 1ULL << (word % 64);
+    } else {
+        pool->full_words[word / 64] &= ~(1ULL << (word % 64));
+    }
+}
+
+static int clamp_size(int size)
+{
+    if (size < 1) {
+        return 1;
+    } else if (size > ID_POOL_MAX_IDS) {
+        return ID_POOL_MAX_IDS;
+    }
+    return size;
+}
+
+void id_pool_init(id_pool *pool, int size)
+{
+    memset(pool, 0, sizeof(id_pool));
+    // ID 0 is permanently in use, just like the IDs past the end
+    pool->used[0] = 1;
+    pool->size = 1;
+    id_pool_resize(pool, size);
+}
+
+void id_pool_resize(id_pool *pool, int size)
+{
+    size = clamp_size(size);
+    for (int id = pool->size; id < size; id++) {
+        pool->used[id / 64] &= ~(1ULL << (id % 64));
+    }
+    for (int id = size; id < ID_POOL_MAX_IDS; id++) {
+        pool->used[id / 64] |= 1ULL << (id % 64);
+    }
+    pool->size = size;
+    pool->num_free = 0;
+    for (int word = 0; word < NUM_WORDS; word++) {
+        update_full_word(pool, word);
+        pool->num_free += __builtin_popcountll(~pool->used[word]);
+    }
+}
+
+void id_pool_set_used(id_pool *pool, int id)
+{
+    if (!is_valid(pool, id) || !id_pool_is_free(pool, id)) {
+        return;
+    }
+    pool->used[id / 64] |= 1ULL << (id % 64);
+    update_full_word(pool, id / 64);
+    pool->num_free--;
+}
+
+void id_pool_set_free(id_pool *pool, int id)
+{
+    if (!is_valid(pool, id) || id_pool_is_free(pool, id)) {
+        return;
+    }
+    pool->used[id / 64] &= ~(1ULL << (id % 64));
+    update_full_word(pool, id / 64);
+    pool->num_free++;
+}
+
+int id_pool_is_free(const id_pool *pool, int id)
+{
+    return is_valid(pool, id) && !(pool->used[id / 64] & (1ULL << (id % 64)));
+}
+
+int id_pool_first_free(const id_pool *pool)
+{
+    return id_pool_next_free(pool, 0);
+}
+
+static int first_free_word(const id_pool *pool, int word)
+{
+    for (int summary = word / 64; summary < NUM_SUMMARY_WORDS; summary++) {
+        uint64_t free_words = ~pool->full_words[summary];
+        if (summary == word / 64) {
+            free_words &= ALL_BITS << (word % 64);
+        }
+        if (free_words) {
+            return summary * 64 + __builtin_ctzll(free_words);
+        }
+    }
+    return -1;
+}
+
+int id_pool_next_free(const id_pool *pool, int id)
+{
+    int start = id < 0 ? 1 : id + 1;
+    if (start >= pool->size) {
+        return 0;
+    }
+    int word = start / 64;
+    uint64_t free_bits = ~pool->used[word] & (ALL_BITS << (start % 64));
+    if (free_bits) {
+        return word * 64 + __builtin_ctzll(free_bits);
+    }
+    word = first_free_word(pool, word + 1);
+    if (word < 0) {
+        return 0;
+    }
+    return word * 64 + __builtin_ctzll(~pool->used[word]);
+}
+
+int id_pool_num_free(const id_pool *pool)
+{
+    return pool->num_free;
+}
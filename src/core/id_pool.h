@@ -0,0 +1,86 @@
+#ifndef CORE_ID_POOL_H
+#define CORE_ID_POOL_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Allocator for the IDs of a fixed-size object list.
+ *
+ * Keeps a bitmap of the IDs in use plus a summary of the full bitmap words,
+ * so the lowest free ID is found with two bit scans. ID 0 is never handed
+ * out: the game uses it as "no object".
+ */
+
+#define ID_POOL_MAX_IDS 8192
+
+/**
+ * Struct representing an ID pool
+ */
+typedef struct {
+    uint64_t used[ID_POOL_MAX_IDS / 64]; /**< Read-only: bit set for each ID in use */
+    uint64_t full_words[ID_POOL_MAX_IDS / 64 / 64]; /**< Read-only: bit set for each word of used that has all IDs in use */
+    int size; /**< Read-only: number of IDs, including ID 0 */
+    int num_free; /**< Read-only: number of free IDs */
+} id_pool;
+
+/**
+ * Initializes the pool with all IDs free
+ * @param pool Pool
+ * @param size Number of IDs including ID 0, at most ID_POOL_MAX_IDS
+ */
+void id_pool_init(id_pool *pool, int size);
+
+/**
+ * Changes the number of IDs. IDs added at the end are free, IDs removed
+ * from the end must be free.
+ * @param pool Pool
+ * @param size New number of IDs including ID 0, at most ID_POOL_MAX_IDS
+ */
+void id_pool_resize(id_pool *pool, int size);
+
+/**
+ * Marks an ID as being in use, does nothing if it already is
+ * @param pool Pool
+ * @param id ID
+ */
+void id_pool_set_used(id_pool *pool, int id);
+
+/**
+ * Marks an ID as free, does nothing if it already is
+ * @param pool Pool
+ * @param id ID
+ */
+void id_pool_set_free(id_pool *pool, int id);
+
+/**
+ * Returns whether an ID is free
+ * @param pool Pool
+ * @param id ID
+ * @return Boolean true if the ID is free
+ */
+int id_pool_is_free(const id_pool *pool, int id);
+
+/**
+ * Returns the lowest free ID
+ * @param pool Pool
+ * @return ID, 0 if all IDs are in use
+ */
+int id_pool_first_free(const id_pool *pool);
+
+/**
+ * Returns the lowest free ID higher than the given ID
+ * @param pool Pool
+ * @param id ID, does not have to be free
+ * @return ID, 0 if there is no such free ID
+ */
+int id_pool_next_free(const id_pool *pool, int id);
+
+/**
+ * Returns the number of free IDs
+ * @param pool Pool
+ * @return Number of free IDs, not counting ID 0
+ */
+int id_pool_num_free(const id_pool *pool);
+
+#endif // CORE_ID_POOL_H
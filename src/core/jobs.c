@@ -0,0 +1,426 @@
+#include "core/jobs.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ATOMIC_ADD(var, n) __atomic_add_fetch(&(var), (n), __ATOMIC_SEQ_CST)
+#define ATOMIC_LOAD(var) __atomic_load_n(&(var), __ATOMIC_SEQ_CST)
+
+typedef struct {
+    job_function function;
+    void *data;
+    job_group *group;
+} job;
+
+typedef struct {
+    unsigned char *memory;
+    int used;
+} arena;
+
+// queue 0 is shared by all threads that are not workers
+typedef struct {
+    pthread_mutex_t mutex;
+    job jobs[JOBS_QUEUE_SIZE];
+    int oldest;
+    int count;
+} queue;
+
+typedef struct {
+    pthread_t thread;
+    int index;
+    arena scratch;
+} worker;
+
+static struct {
+    int num_workers;
+    int num_queues;
+    worker workers[JOBS_MAX_WORKERS + 1];
+    queue queues[JOBS_MAX_WORKERS + 1];
+    int queued;
+    int sleeping;
+    int quit;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+} data;
+
+static __thread int current_worker;
+// threads that are not workers get their own arena on first use, kept for the life of the thread
+static __thread arena *current_arena;
+
+static int push(queue *q, const job *j)
+{
+    pthread_mutex_lock(&q->mutex);
+    int pushed = q->count < JOBS_QUEUE_SIZE;
+    if (pushed) {
+        q->jobs[(q->oldest + q->count) % JOBS_QUEUE_SIZE] = *j;
+        ATOMIC_ADD(q->count, 1);
+        ATOMIC_ADD(data.queued, 1);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return pushed;
+}
+
+static int pop(queue *q, int newest, job *j)
+{
+    if (!ATOMIC_LOAD(q->count)) {
+        return 0;
+    }
+    pthread_mutex_lock(&q->mutex);
+    int popped = q->count > 0;
+    if (popped) {
+        if (newest) {
+            *j = q->jobs[(q->oldest + q->count - 1) % JOBS_QUEUE_SIZE];
+        } else {
+            *j = q->jobs[q->oldest];
+            q->oldest = (q->oldest + 1) % JOBS_QUEUE_SIZE;
+        }
+        ATOMIC_ADD(q->count, -1);
+        ATOMIC_ADD(data.queued, -1);
+    }
+    pthread_mutex_unlock(&q->mutex);
+    return popped;
+}
+
+static int find_job(int self, unsigned int *victim, job *j)
+{
+    if (self && pop(&data.queues[self], 1, j)) {
+        return 1;
+    }
+    for (int i = 0; i < data.num_queues; i++) {
+        int index = (*victim + i) % data.num_queues;
+        if (index != self && pop(&data.queues[index], 0, j)) {
+            *victim = index;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void finish(job_group *group)
+{
+    // the group may be gone as soon as pending reaches zero
+    if (ATOMIC_ADD(group->pending, -1) == 0) {
+        pthread_mutex_lock(&data.mutex);
+        pthread_cond_broadcast(&data.done);
+        pthread_mutex_unlock(&data.mutex);
+    }
+}
+
+static void run_job(const job *j)
+{
+    int used = current_arena ? current_arena->used : 0;
+    j->function(j->data);
+    if (current_arena) {
+        current_arena->used = used;
+    }
+    if (j->group) {
+        finish(j->group);
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    worker *w = (worker *) arg;
+    current_worker = w->index;
+    current_arena = &w->scratch;
+    unsigned int victim = w->index;
+    while (1) {
+        job j;
+        if (find_job(w->index, &victim, &j)) {
+            run_job(&j);
+            continue;
+        }
+        pthread_mutex_lock(&data.mutex);
+        ATOMIC_ADD(data.sleeping, 1);
+        while (ATOMIC_LOAD(data.queued) <= 0 && !data.quit) {
+            pthread_cond_wait(&data.wake, &data.mutex);
+        }
+        ATOMIC_ADD(data.sleeping, -1);
+        int quit = data.quit && ATOMIC_LOAD(data.queued) <= 0;
+        pthread_mutex_unlock(&data.mutex);
+        if (quit) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static int num_processors()
+{
+    long num = sysconf(_SC_NPROCESSORS_ONLN);
+    return num > 0 ? (int) num : 1;
+}
+
+int jobs_start(int num_workers)
+{
+    if (data.num_workers) {
+        return data.num_workers;
+    }
+    if (num_workers <= 0) {
+        num_workers = num_processors();
+    }
+    if (num_workers > JOBS_MAX_WORKERS) {
+        num_workers = JOBS_MAX_WORKERS;
+    }
+    data.quit = 0;
+    pthread_mutex_init(&data.mutex, 0);
+    pthread_cond_init(&data.wake, 0);
+    pthread_cond_init(&data.done, 0);
+    data.num_queues = num_workers + 1;
+    for (int i = 0; i < data.num_queues; i++) {
+        memset(&data.queues[i], 0, sizeof(queue));
+        pthread_mutex_init(&data.queues[i].mutex, 0);
+    }
+    int started = 0;
+    for (int i = 1; i <= num_workers; i++) {
+        worker *w = &data.workers[i];
+        w->index = i;
+        w->scratch.used = 0;
+        w->scratch.memory = (unsigned char *) malloc(JOBS_SCRATCH_SIZE);
+        if (!w->scratch.memory) {
+            break;
+        }
+        if (pthread_create(&w->thread, 0, worker_main, w) != 0) {
+            free(w->scratch.memory);
+            w->scratch.memory = 0;
+            break;
+        }
+        started = i;
+    }
+    data.num_workers = started;
+    if (!started) {
+        jobs_stop();
+    }
+    return started;
+}
+
+void jobs_stop()
+{
+    if (!data.num_queues) {
+        return;
+    }
+    pthread_mutex_lock(&data.mutex);
+    data.quit = 1;
+    pthread_cond_broadcast(&data.wake);
+    pthread_mutex_unlock(&data.mutex);
+    for (int i = 1; i <= data.num_workers; i++) {
+        pthread_join(data.workers[i].thread, 0);
+        free(data.workers[i].scratch.memory);
+        data.workers[i].scratch.memory = 0;
+    }
+    for (int i = 0; i < data.num_queues; i++) {
+        pthread_mutex_destroy(&data.queues[i].mutex);
+    }
+    pthread_cond_destroy(&data.done);
+    pthread_cond_destroy(&data.wake);
+    pthread_mutex_destroy(&data.mutex);
+    data.num_workers = 0;
+    data.num_queues = 0;
+}
+
+int jobs_num_workers()
+{
+    return data.num_workers;
+}
+
+int jobs_current_worker()
+{
+    return current_worker;
+}
+
+void job_group_init(job_group *group)
+{
+    group->pending = 0;
+}
+
+void jobs_spawn(job_group *group, job_function function, void *user_data)
+{
+    job j = { function, user_data, group };
+    if (!data.num_workers) {
+        j.group = 0;
+        run_job(&j);
+        return;
+    }
+    ATOMIC_ADD(group->pending, 1);
+    if (!push(&data.queues[current_worker], &j)) {
+        run_job(&j);
+        return;
+    }
+    if (ATOMIC_LOAD(data.sleeping)) {
+        pthread_mutex_lock(&data.mutex);
+        pthread_cond_signal(&data.wake);
+        pthread_mutex_unlock(&data.mutex);
+    }
+}
+
+void jobs_wait(job_group *group)
+{
+    if (ATOMIC_LOAD(group->pending) <= 0) {
+        return;
+    }
+    if (current_worker) {
+        // workers keep running jobs, which may be the ones of this group
+        unsigned int victim = current_worker;
+        while (ATOMIC_LOAD(group->pending) > 0) {
+            job j;
+            if (find_job(current_worker, &victim, &j)) {
+                run_job(&j);
+            } else {
+                sched_yield();
+            }
+        }
+        return;
+    }
+    pthread_mutex_lock(&data.mutex);
+    while (ATOMIC_LOAD(group->pending) > 0) {
+        pthread_cond_wait(&data.done, &data.mutex);
+    }
+    pthread_mutex_unlock(&data.mutex);
+}
+
+typedef struct {
+    job_range_function function;
+    void *data;
+    int begin;
+    int end;
+    int grain;
+    int num_ranges;
+    int next_range;
+} range_job;
+
+static void run_ranges(void *arg)
+{
+    range_job *r = (range_job *) arg;
+    int range;
+    while ((range = ATOMIC_ADD(r->next_range, 1) - 1) < r->num_ranges) {
+        int begin = r->begin + range * r->grain;
+        int end = r->end - begin > r->grain ? begin + r->grain : r->end;
+        r->function(begin, end, r->data);
+    }
+}
+
+void jobs_parallel_for(int begin, int end, int grain, job_range_function function, void *user_data)
+{
+    if (end <= begin) {
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+    range_job r = { function, user_data, begin, end, grain, (end - begin - 1) / grain + 1, 0 };
+    int num_jobs = r.num_ranges < data.num_workers ? r.num_ranges : data.num_workers;
+    job_group group;
+    job_group_init(&group);
+    // the calling thread takes ranges too, so one job less is spawned
+    for (int i = 1; i < num_jobs; i++) {
+        jobs_spawn(&group, run_ranges, &r);
+    }
+    job j = { run_ranges, &r, 0 };
+    run_job(&j);
+    jobs_wait(&group);
+}
+
+typedef struct {
+    job_reduce_function reduce;
+    unsigned char *partials;
+    int result_size;
+    int begin;
+    int end;
+    int grain;
+    void *data;
+} reduce_job;
+
+static void reduce_ranges(int begin, int end, void *arg)
+{
+    reduce_job *r = (reduce_job *) arg;
+    for (int range = begin; range < end; range++) {
+        int range_begin = r->begin + range * r->grain;
+        int range_end = r->end - range_begin > r->grain ? range_begin + r->grain : r->end;
+        r->reduce(range_begin, range_end, &r->partials[range * r->result_size], r->data);
+    }
+}
+
+int jobs_parallel_reduce(int begin, int end, int grain,
+                         job_reduce_function reduce, job_combine_function combine,
+                         void *result, int result_size, void *user_data)
+{
+    if (end <= begin) {
+        return 1;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+    int num_ranges = (end - begin - 1) / grain + 1;
+    unsigned char *partials = (unsigned char *) malloc((size_t) num_ranges * result_size);
+    if (!partials) {
+        return 0;
+    }
+    for (int i = 0; i < num_ranges; i++) {
+        memcpy(&partials[i * result_size], result, result_size);
+    }
+    reduce_job r = { reduce, partials, result_size, begin, end, grain, user_data };
+    jobs_parallel_for(0, num_ranges, 1, reduce_ranges, &r);
+    for (int i = 0; i < num_ranges; i++) {
+        combine(result, &partials[i * result_size], user_data);
+    }
+    free(partials);
+    return 1;
+}
+
+typedef struct {
+    double (*value)(int index, void *data);
+    void *data;
+} sum_job;
+
+static void sum_range(int begin, int end, void *partial, void *arg)
+{
+    sum_job *s = (sum_job *) arg;
+    double *sum = (double *) partial;
+    for (int i = begin; i < end; i++) {
+        *sum += s->value(i, s->data);
+    }
+}
+
+static void sum_combine(void *result, const void *partial, void *arg)
+{
+    *(double *) result += *(const double *) partial;
+}
+
+double jobs_parallel_sum(int begin, int end, int grain, double (*value)(int index, void *data), void *user_data)
+{
+    sum_job s = { value, user_data };
+    double sum = 0;
+    jobs_parallel_reduce(begin, end, grain, sum_range, sum_combine, &sum, sizeof(double), &s);
+    return sum;
+}
+
+void *jobs_scratch_alloc(int size)
+{
+    if (!current_arena) {
+        current_arena = (arena *) malloc(sizeof(arena));
+        if (!current_arena) {
+            return 0;
+        }
+        current_arena->used = 0;
+        current_arena->memory = (unsigned char *) malloc(JOBS_SCRATCH_SIZE);
+    }
+    arena *scratch = current_arena;
+    int aligned_size = (size + 15) & ~15;
+    if (!scratch->memory || size < 0 || aligned_size > JOBS_SCRATCH_SIZE - scratch->used) {
+        return 0;
+    }
+    void *memory = &scratch->memory[scratch->used];
+    scratch->used += aligned_size;
+    return memory;
+}
+
+void jobs_scratch_reset()
+{
+    if (current_arena) {
+        current_arena->used = 0;
+    }
+}
@@ -0,0 +1,161 @@
+#ifndef CORE_JOBS_H
+#define CORE_JOBS_H
+
+/**
+ * @file
+ * Small work-stealing job system.
+ *
+ * Each worker thread has its own job queue: it runs its newest job first
+ * and steals the oldest job of another queue when its own is empty. Jobs
+ * spawned by threads that are not workers go to a shared queue. A thread
+ * waiting for a group of jobs runs other jobs in the meantime if it is a
+ * worker, and sleeps otherwise.
+ *
+ * When the job system is not started, all jobs run immediately on the
+ * calling thread, so code using it works the same without threads.
+ */
+
+#define JOBS_MAX_WORKERS 32
+#define JOBS_QUEUE_SIZE 1024
+#define JOBS_SCRATCH_SIZE (1024 * 1024)
+
+/**
+ * Job function
+ * @param data Data passed to jobs_spawn()
+ */
+typedef void (*job_function)(void *data);
+
+/**
+ * Function for a range of indices
+ * @param begin First index
+ * @param end Index after the last
+ * @param data Data passed to jobs_parallel_for()
+ */
+typedef void (*job_range_function)(int begin, int end, void *data);
+
+/**
+ * Function accumulating a range of indices into a partial result
+ * @param begin First index
+ * @param end Index after the last
+ * @param partial Partial result of the range, starts as a copy of the initial result
+ * @param data Data passed to jobs_parallel_reduce()
+ */
+typedef void (*job_reduce_function)(int begin, int end, void *partial, void *data);
+
+/**
+ * Function combining a partial result into the result
+ * @param result Result
+ * @param partial Partial result of the next range
+ * @param data Data passed to jobs_parallel_reduce()
+ */
+typedef void (*job_combine_function)(void *result, const void *partial, void *data);
+
+/**
+ * Group of jobs that can be waited for
+ */
+typedef struct {
+    int pending; /**< Read-only: number of jobs not finished yet */
+} job_group;
+
+/**
+ * Starts the worker threads, does nothing if they are already running
+ * @param num_workers Number of workers, 0 for one per processor
+ * @return Number of workers started, 0 if threads are not available
+ */
+int jobs_start(int num_workers);
+
+/**
+ * Waits for all queued jobs and stops the worker threads
+ */
+void jobs_stop();
+
+/**
+ * Gets the number of worker threads
+ * @return Number of workers, 0 when the job system is not started
+ */
+int jobs_num_workers();
+
+/**
+ * Gets the worker running the current thread
+ * @return Worker index from 1 to jobs_num_workers(), 0 for other threads
+ */
+int jobs_current_worker();
+
+/**
+ * Initializes an empty job group
+ * @param group Group
+ */
+void job_group_init(job_group *group);
+
+/**
+ * Queues a job, or runs it immediately when the job system is not started
+ * or the queue is full
+ * @param group Group to add the job to
+ * @param function Job function
+ * @param data Data for the function, must stay valid until the job is finished
+ */
+void jobs_spawn(job_group *group, job_function function, void *data);
+
+/**
+ * Waits until all jobs of the group are finished
+ * @param group Group
+ */
+void jobs_wait(job_group *group);
+
+/**
+ * Calls a function for fixed-size ranges of indices, in parallel.
+ * Returns when all ranges are done.
+ * @param begin First index
+ * @param end Index after the last
+ * @param grain Number of indices per range, at least 1
+ * @param function Function to call for each range
+ * @param data Data for the function
+ */
+void jobs_parallel_for(int begin, int end, int grain, job_range_function function, void *data);
+
+/**
+ * Reduces a range of indices in parallel. The range is split into ranges
+ * of grain indices, independent of the number of workers. Each range is
+ * accumulated into its own partial result, and the partial results are
+ * combined in index order, so the result is always the same as the serial
+ * result for the same grain, even for floating point sums.
+ * @param begin First index
+ * @param end Index after the last
+ * @param grain Number of indices per range, at least 1
+ * @param reduce Function accumulating a range into a partial result
+ * @param combine Function combining a partial result into the result
+ * @param result Result, holds the initial value on entry: the identity of combine
+ * @param result_size Size of the result in bytes
+ * @param data Data for the functions
+ * @return Boolean true on success, false if there was no memory for the partial results
+ */
+int jobs_parallel_reduce(int begin, int end, int grain,
+                         job_reduce_function reduce, job_combine_function combine,
+                         void *result, int result_size, void *data);
+
+/**
+ * Sums a value over a range of indices, in parallel and deterministically
+ * @param begin First index
+ * @param end Index after the last
+ * @param grain Number of indices per range, at least 1
+ * @param value Function returning the value of an index
+ * @param data Data for the function
+ * @return Sum of the values, added up per range and then in range order
+ */
+double jobs_parallel_sum(int begin, int end, int grain, double (*value)(int index, void *data), void *data);
+
+/**
+ * Allocates memory from the scratch arena of the current thread. The
+ * memory stays valid until the current job returns; outside of a job,
+ * until jobs_scratch_reset() is called.
+ * @param size Size in bytes
+ * @return Memory aligned to 16 bytes, 0 if the arena is full
+ */
+void *jobs_scratch_alloc(int size);
+
+/**
+ * Frees all scratch memory allocated outside of a job by the current thread
+ */
+void jobs_scratch_reset();
+
+#endif // CORE_JOBS_H
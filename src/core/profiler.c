@@ -0,0 +1,125 @@
+#include "core/profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static struct {
+    int enabled;
+    const char *csv_filename;
+    profiler_section sections[PROFILER_MAX_SECTIONS];
+} data;
+
+static uint64_t now_nanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+static int histogram_bucket(uint64_t nanos)
+{
+    uint64_t micros = nanos / 1000;
+    int bucket = 0;
+    while (micros && bucket < PROFILER_HISTOGRAM_BUCKETS - 1) {
+        micros >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void profiler_enable(const char *csv_filename)
+{
+    for (int i = 0; i < PROFILER_MAX_SECTIONS; i++) {
+        const char *name = data.sections[i].name;
+        memset(&data.sections[i], 0, sizeof(profiler_section));
+        data.sections[i].name = name;
+    }
+    data.csv_filename = csv_filename;
+    data.enabled = 1;
+}
+
+int profiler_enabled()
+{
+    return data.enabled;
+}
+
+void profiler_set_name(int section, const char *name)
+{
+    if (section >= 0 && section < PROFILER_MAX_SECTIONS) {
+        data.sections[section].name = name;
+    }
+}
+
+uint64_t profiler_start()
+{
+    return data.enabled ? now_nanos() : 0;
+}
+
+void profiler_stop(int section, uint64_t start)
+{
+    if (start) {
+        profiler_record(section, now_nanos() - start);
+    }
+}
+
+void profiler_record(int section, uint64_t nanos)
+{
+    if (section < 0 || section >= PROFILER_MAX_SECTIONS) {
+        return;
+    }
+    profiler_section *s = &data.sections[section];
+    if (!s->count || nanos < s->min_nanos) {
+        s->min_nanos = nanos;
+    }
+    if (nanos > s->max_nanos) {
+        s->max_nanos = nanos;
+    }
+    s->count++;
+    s->total_nanos += nanos;
+    s->histogram[histogram_bucket(nanos)]++;
+}
+
+const profiler_section *profiler_get_section(int section)
+{
+    if (section < 0 || section >= PROFILER_MAX_SECTIONS) {
+        return 0;
+    }
+    return &data.sections[section];
+}
+
+int profiler_write_csv(const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        return 0;
+    }
+    fprintf(fp, "section,name,count,min_us,mean_us,max_us,total_us");
+    for (int b = 0; b < PROFILER_HISTOGRAM_BUCKETS - 1; b++) {
+        fprintf(fp, ",lt_%u_us", 1u << b);
+    }
+    fprintf(fp, ",ge_%u_us\n", 1u << (PROFILER_HISTOGRAM_BUCKETS - 2));
+    for (int i = 0; i < PROFILER_MAX_SECTIONS; i++) {
+        const profiler_section *s = &data.sections[i];
+        if (!s->count) {
+            continue;
+        }
+        fprintf(fp, "%d,%s,%u,%.3f,%.3f,%.3f,%.3f", i, s->name ? s->name : "",
+            s->count, s->min_nanos / 1000.0, s->total_nanos / 1000.0 / s->count,
+            s->max_nanos / 1000.0, s->total_nanos / 1000.0);
+        for (int b = 0; b < PROFILER_HISTOGRAM_BUCKETS; b++) {
+            fprintf(fp, ",%u", s->histogram[b]);
+        }
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+    return 1;
+}
+
+void profiler_finish()
+{
+    if (data.enabled && data.csv_filename) {
+        profiler_write_csv(data.csv_filename);
+    }
+    data.enabled = 0;
+}
@@ -0,0 +1,88 @@
+#ifndef CORE_PROFILER_H
+#define CORE_PROFILER_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * High-resolution timing of code sections.
+ *
+ * Each section keeps min, mean and max durations plus a histogram with
+ * power-of-two microsecond buckets. When the profiler is disabled,
+ * profiler_start() returns 0 and profiler_stop() does nothing.
+ */
+
+#define PROFILER_MAX_SECTIONS 64
+#define PROFILER_HISTOGRAM_BUCKETS 16
+
+/**
+ * Timing statistics of one section
+ */
+typedef struct {
+    const char *name; /**< Section name, used in the CSV output */
+    uint32_t count; /**< Number of recorded samples */
+    uint64_t total_nanos; /**< Sum of all durations */
+    uint64_t min_nanos; /**< Shortest duration */
+    uint64_t max_nanos; /**< Longest duration */
+    uint32_t histogram[PROFILER_HISTOGRAM_BUCKETS]; /**< Bucket i: duration < 2^i microseconds, last bucket: all longer */
+} profiler_section;
+
+/**
+ * Enables the profiler and clears all statistics
+ * @param csv_filename File to write the statistics to on profiler_finish(), may be 0
+ */
+void profiler_enable(const char *csv_filename);
+
+/**
+ * Checks whether the profiler is enabled
+ * @return Boolean true if enabled
+ */
+int profiler_enabled();
+
+/**
+ * Sets the name of a section
+ * @param section Section ID
+ * @param name Name, must stay valid while the profiler is used
+ */
+void profiler_set_name(int section, const char *name);
+
+/**
+ * Starts timing
+ * @return Start timestamp to pass to profiler_stop(), 0 if the profiler is disabled
+ */
+uint64_t profiler_start();
+
+/**
+ * Stops timing and records the duration for the section
+ * @param section Section ID
+ * @param start Timestamp returned by profiler_start()
+ */
+void profiler_stop(int section, uint64_t start);
+
+/**
+ * Records a duration for the section
+ * @param section Section ID
+ * @param nanos Duration in nanoseconds
+ */
+void profiler_record(int section, uint64_t nanos);
+
+/**
+ * Gets the statistics of a section
+ * @param section Section ID
+ * @return Section statistics
+ */
+const profiler_section *profiler_get_section(int section);
+
+/**
+ * Writes the statistics of all sections with samples as CSV
+ * @param filename File to write to
+ * @return Boolean true on success
+ */
+int profiler_write_csv(const char *filename);
+
+/**
+ * Writes the statistics to the file passed to profiler_enable() and disables the profiler
+ */
+void profiler_finish();
+
+#endif // CORE_PROFILER_H
@@ -1,5 +1,7 @@
 #include "core/time.h"
 
+#include <time.h>
+
 static time_millis current_time;
 
 time_millis time_get_millis()
@@ -11,3 +13,10 @@ void time_set_millis(time_millis millis)
 {
     current_time = millis;
 }
+
+time_millis time_get_wall_millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (time_millis) (ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
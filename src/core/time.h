@@ -22,4 +22,10 @@ time_millis time_get_millis();
  */
 void time_set_millis(time_millis millis);
 
+/**
+ * Gets the real time, independent of the time set by time_set_millis()
+ * @return Monotonic wall clock time in milliseconds
+ */
+time_millis time_get_wall_millis();
+
 #endif // CORE_TIME_H
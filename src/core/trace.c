@@ -0,0 +1,180 @@
+#include "core/trace.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BUFFER_MASK (TRACE_BUFFER_SIZE - 1)
+#define FILE_VERSION 1
+
+static const char FILE_MAGIC[4] = {'J', 'T', 'R', 'C'};
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t event_size;
+    uint32_t num_events;
+} trace_file_header;
+
+static const struct {
+    const char *name;
+    const char *format;
+} EVENT_DESCRIPTIONS[TRACE_EVENT_MAX] = {
+    {"NONE", ""},
+    {"TICK", "month %d day %d tick %d"},
+    {"ROUTE", "figure %d from %d to %d length %d"},
+    {"ROUTE_NO_FREE_PATH", "figure %d"},
+    {"SAVEGAME_READ_PIECE", "piece %d size %d compressed %d"},
+    {"SAVEGAME_WRITE_PIECE", "piece %d size %d compressed %d"},
+    {"SAVEGAME_BUFFER_NOT_EMPTY", "piece %d: %d of %d bytes used"},
+    {"IMAGE_NOT_ISOMETRIC", "image %d is not isometric"},
+    {"IMAGE_IS_ISOMETRIC", "image %d is isometric, use drawIsometricFootprint"},
+    {"CLIP_OUTSIDE_SCREEN", "clip end %d,%d outside screen %dx%d"},
+    {"ROUTING_GRID_MISMATCH", "tile %d grid %d: stored %d, full rebuild %d"},
+    {"DESIRABILITY_MISMATCH", "tile %d: stored %d, full recompute %d"},
+};
+
+static const char *LEVEL_NAMES[] = {"NONE", "ERROR", "INFO", "DEBUG"};
+
+static struct {
+    trace_level level;
+    const char *filename;
+    uint32_t head;
+    trace_event events[TRACE_BUFFER_SIZE];
+} data = {TRACE_LEVEL_ERROR};
+
+static uint64_t now_nanos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+void trace_enable(trace_level level, const char *filename)
+{
+    data.level = level;
+    data.filename = filename;
+    __atomic_store_n(&data.head, 0, __ATOMIC_RELAXED);
+    memset(data.events, 0, sizeof(data.events));
+}
+
+trace_level trace_get_level()
+{
+    return data.level;
+}
+
+int trace_level_enabled(trace_level level)
+{
+    return level <= data.level;
+}
+
+void trace_emit(trace_level level, trace_event_type type, int32_t p0, int32_t p1, int32_t p2, int32_t p3)
+{
+    if (level > data.level) {
+        return;
+    }
+    uint32_t index = __atomic_fetch_add(&data.head, 1, __ATOMIC_RELAXED);
+    trace_event *event = &data.events[index & BUFFER_MASK];
+    // Sequence 0 marks the slot as being written for concurrent readers
+    __atomic_store_n(&event->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    event->type = (uint16_t) type;
+    event->level = (uint8_t) level;
+    event->unused = 0;
+    event->nanos = now_nanos();
+    event->params[0] = p0;
+    event->params[1] = p1;
+    event->params[2] = p2;
+    event->params[3] = p3;
+    __atomic_store_n(&event->sequence, index + 1, __ATOMIC_RELEASE);
+}
+
+int trace_get_events(trace_event *events, int max_events)
+{
+    uint32_t head = __atomic_load_n(&data.head, __ATOMIC_ACQUIRE);
+    uint32_t first = head > TRACE_BUFFER_SIZE ? head - TRACE_BUFFER_SIZE : 0;
+    if (max_events < (int) (head - first)) {
+        first = head - max_events;
+    }
+    int count = 0;
+    for (uint32_t i = first; i != head; i++) {
+        const trace_event *event = &data.events[i & BUFFER_MASK];
+        uint32_t sequence = __atomic_load_n(&event->sequence, __ATOMIC_ACQUIRE);
+        if (sequence != i + 1) {
+            continue; // being written or already overwritten
+        }
+        events[count] = *event;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&event->sequence, __ATOMIC_RELAXED) != sequence) {
+            continue;
+        }
+        events[count].sequence = sequence;
+        count++;
+    }
+    return count;
+}
+
+int trace_write_file(const char *filename)
+{
+    static trace_event events[TRACE_BUFFER_SIZE];
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        return 0;
+    }
+    trace_file_header header;
+    memcpy(header.magic, FILE_MAGIC, 4);
+    header.version = FILE_VERSION;
+    header.event_size = sizeof(trace_event);
+    header.num_events = trace_get_events(events, TRACE_BUFFER_SIZE);
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+        fwrite(events, sizeof(trace_event), header.num_events, fp) == header.num_events;
+    fclose(fp);
+    return ok;
+}
+
+int trace_read_file(const char *filename, trace_event *events, int max_events)
+{
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) {
+        return -1;
+    }
+    trace_file_header header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, FILE_MAGIC, 4) != 0 ||
+        header.version != FILE_VERSION ||
+        header.event_size != sizeof(trace_event)) {
+        fclose(fp);
+        return -1;
+    }
+    int num_events = (int) header.num_events < max_events ? (int) header.num_events : max_events;
+    num_events = (int) fread(events, sizeof(trace_event), (size_t) num_events, fp);
+    fclose(fp);
+    return num_events;
+}
+
+void trace_format_event(const trace_event *event, char *buffer, int size)
+{
+    const char *name = "UNKNOWN";
+    const char *format = "%d %d %d %d";
+    if (event->type < TRACE_EVENT_MAX) {
+        name = EVENT_DESCRIPTIONS[event->type].name;
+        format = EVENT_DESCRIPTIONS[event->type].format;
+    }
+    const char *level = event->level <= TRACE_LEVEL_DEBUG ? LEVEL_NAMES[event->level] : "?";
+    int length = snprintf(buffer, size, "%u %llu.%06llu %s %s: ", event->sequence,
+        (unsigned long long) (event->nanos / 1000000000),
+        (unsigned long long) (event->nanos % 1000000000 / 1000), level, name);
+    if (length >= 0 && length < size) {
+        snprintf(&buffer[length], size - length, format,
+            event->params[0], event->params[1], event->params[2], event->params[3]);
+    }
+}
+
+void trace_finish()
+{
+    if (data.filename) {
+        trace_write_file(data.filename);
+    }
+    data.filename = 0;
+    data.level = TRACE_LEVEL_ERROR;
+}
@@ -0,0 +1,145 @@
+#ifndef CORE_TRACE_H
+#define CORE_TRACE_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Low-overhead tracing of binary events.
+ *
+ * Events are fixed-size records written to a lock-free ring buffer,
+ * which keeps the most recent TRACE_BUFFER_SIZE events. Formatting to
+ * text only happens when dumping, see trace_format_event().
+ */
+
+/**
+ * Trace levels, lower is more important
+ */
+typedef enum {
+    TRACE_LEVEL_NONE = 0,
+    TRACE_LEVEL_ERROR = 1,
+    TRACE_LEVEL_INFO = 2,
+    TRACE_LEVEL_DEBUG = 3
+} trace_level;
+
+/**
+ * Highest level compiled in, events above it are removed by the compiler
+ */
+#ifndef TRACE_COMPILE_LEVEL
+#define TRACE_COMPILE_LEVEL TRACE_LEVEL_DEBUG
+#endif
+
+#define TRACE_BUFFER_SIZE 8192
+#define TRACE_MAX_PARAMS 4
+
+/**
+ * Event types. Append only: the values are stored in trace files.
+ */
+typedef enum {
+    TRACE_EVENT_NONE = 0,
+    TRACE_EVENT_TICK = 1, /**< month, day, tick */
+    TRACE_EVENT_ROUTE = 2, /**< figure ID, source grid offset, destination grid offset, path length */
+    TRACE_EVENT_ROUTE_NO_FREE_PATH = 3, /**< figure ID */
+    TRACE_EVENT_SAVEGAME_READ_PIECE = 4, /**< piece index, size, compressed */
+    TRACE_EVENT_SAVEGAME_WRITE_PIECE = 5, /**< piece index, size, compressed */
+    TRACE_EVENT_SAVEGAME_BUFFER_NOT_EMPTY = 6, /**< piece index, bytes used, size */
+    TRACE_EVENT_IMAGE_NOT_ISOMETRIC = 7, /**< graphic ID */
+    TRACE_EVENT_IMAGE_IS_ISOMETRIC = 8, /**< graphic ID */
+    TRACE_EVENT_CLIP_OUTSIDE_SCREEN = 9, /**< requested clip x end, requested clip y end, screen width, screen height */
+    TRACE_EVENT_ROUTING_GRID_MISMATCH = 10, /**< grid offset, grid (0 = citizen, 1 = non-citizen), stored value, full rebuild value */
+    TRACE_EVENT_DESIRABILITY_MISMATCH = 11, /**< grid offset, stored value, full recompute value */
+    TRACE_EVENT_MAX
+} trace_event_type;
+
+/**
+ * A trace event as stored in the ring buffer and in trace files
+ */
+typedef struct {
+    uint32_t sequence; /**< Sequence number, starting at 1 */
+    uint16_t type; /**< Event type, see trace_event_type */
+    uint8_t level; /**< Trace level */
+    uint8_t unused;
+    uint64_t nanos; /**< Monotonic timestamp */
+    int32_t params[TRACE_MAX_PARAMS]; /**< Event parameters */
+} trace_event;
+
+/**
+ * Records an event if its level is compiled in and enabled at runtime.
+ * The parameters are only evaluated when the event is recorded.
+ */
+#define TRACE(level, type, p0, p1, p2, p3) \
+    do { \
+        if ((level) <= TRACE_COMPILE_LEVEL && trace_level_enabled(level)) { \
+            trace_emit((level), (type), (p0), (p1), (p2), (p3)); \
+        } \
+    } while (0)
+
+#define TRACE_ERROR(type, p0, p1, p2, p3) TRACE(TRACE_LEVEL_ERROR, type, p0, p1, p2, p3)
+#define TRACE_INFO(type, p0, p1, p2, p3) TRACE(TRACE_LEVEL_INFO, type, p0, p1, p2, p3)
+#define TRACE_DEBUG(type, p0, p1, p2, p3) TRACE(TRACE_LEVEL_DEBUG, type, p0, p1, p2, p3)
+
+/**
+ * Enables tracing up to the given level and clears the buffer
+ * @param level Highest level to record
+ * @param filename File to write the buffer to on trace_finish(), may be 0
+ */
+void trace_enable(trace_level level, const char *filename);
+
+/**
+ * Gets the runtime trace level. Defaults to TRACE_LEVEL_ERROR.
+ * @return Highest level that is recorded
+ */
+trace_level trace_get_level();
+
+/**
+ * Checks whether events of a level are recorded
+ * @param level Level
+ * @return Boolean true if the level is enabled at runtime
+ */
+int trace_level_enabled(trace_level level);
+
+/**
+ * Records an event, use the TRACE macros instead
+ * @param level Level
+ * @param type Event type
+ */
+void trace_emit(trace_level level, trace_event_type type, int32_t p0, int32_t p1, int32_t p2, int32_t p3);
+
+/**
+ * Copies the events in the buffer, oldest first
+ * @param events Array to copy to
+ * @param max_events Size of the array
+ * @return Number of events copied
+ */
+int trace_get_events(trace_event *events, int max_events);
+
+/**
+ * Writes the events in the buffer to a binary trace file
+ * @param filename File to write to
+ * @return Boolean true on success
+ */
+int trace_write_file(const char *filename);
+
+/**
+ * Reads events from a binary trace file
+ * @param filename File to read from
+ * @param events Array to read into
+ * @param max_events Size of the array
+ * @return Number of events read, -1 if the file is not a valid trace file
+ */
+int trace_read_file(const char *filename, trace_event *events, int max_events);
+
+/**
+ * Formats an event as text
+ * @param event Event
+ * @param buffer Buffer to write to
+ * @param size Size of the buffer
+ */
+void trace_format_event(const trace_event *event, char *buffer, int size);
+
+/**
+ * Writes the buffer to the file passed to trace_enable() and resets tracing to errors only
+ */
+void trace_finish();
+
+#endif // CORE_TRACE_H
@@ -0,0 +1,92 @@
+#include "live_list.h"
+
+#include <string.h>
+
+static struct {
+    char live[FIGURE_LIVE_LIST_MAX_FIGURES];
+    short ids[FIGURE_LIVE_LIST_MAX_FIGURES];
+    int count;
+    int cursor; // position of the figure last returned by figure_live_list_next()
+} data;
+
+static int is_valid(int figure_id)
+{
+    return figure_id > 0 && figure_id < FIGURE_LIVE_LIST_MAX_FIGURES;
+}
+
+// Position of the first figure with an ID of at least figure_id
+static int lower_bound(int figure_id)
+{
+    int low = 0;
+    int high = data.count;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (data.ids[middle] < figure_id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void figure_live_list_clear()
+{
+    memset(&data, 0, sizeof(data));
+}
+
+void figure_live_list_add(int figure_id)
+{
+    if (!is_valid(figure_id) || data.live[figure_id]) {
+        return;
+    }
+    int index = data.count;
+    if (index > 0 && data.ids[index - 1] > figure_id) {
+        index = lower_bound(figure_id);
+        memmove(&data.ids[index + 1], &data.ids[index], (data.count - index) * sizeof(short));
+    }
+    data.ids[index] = (short) figure_id;
+    data.count++;
+    data.live[figure_id] = 1;
+}
+
+void figure_live_list_remove(int figure_id)
+{
+    if (!is_valid(figure_id) || !data.live[figure_id]) {
+        return;
+    }
+    int index = lower_bound(figure_id);
+    data.count--;
+    memmove(&data.ids[index], &data.ids[index + 1], (data.count - index) * sizeof(short));
+    data.live[figure_id] = 0;
+}
+
+int figure_live_list_contains(int figure_id)
+{
+    return is_valid(figure_id) && data.live[figure_id];
+}
+
+int figure_live_list_count()
+{
+    return data.count;
+}
+
+int figure_live_list_get(int index)
+{
+    return index >= 0 && index < data.count ? data.ids[index] : 0;
+}
+
+int figure_live_list_next(int figure_id)
+{
+    int index;
+    if (data.cursor < data.count && data.ids[data.cursor] == figure_id) {
+        index = data.cursor + 1;
+    } else {
+        index = lower_bound(figure_id + 1);
+    }
+    if (index >= data.count) {
+        return 0;
+    }
+    data.cursor = index;
+    return data.ids[index];
+}
@@ -0,0 +1,72 @@
+#ifndef FIGURE_LIVE_LIST_H
+#define FIGURE_LIVE_LIST_H
+
+/**
+ * @file
+ * Dense list of the IDs of the figures in use, sorted by ascending ID.
+ *
+ * Iterating over the list visits the figures in the same order as a scan
+ * over all figure IDs, without touching the unused figure slots. The list
+ * is not saved: it is rebuilt from the figure list after loading.
+ */
+
+/**
+ * Highest figure ID + 1, same as MAX_FIGURES: checked where both are known
+ */
+#define FIGURE_LIVE_LIST_MAX_FIGURES 8000
+
+/**
+ * Iterates over all live figures in ascending ID order.
+ * Figures may be added and removed inside the loop: figures added with a
+ * higher ID than the current one are visited in the same loop.
+ */
+#define FOR_EACH_LIVE_FIGURE(figure_id) \
+    for (int figure_id = figure_live_list_next(0); figure_id; \
+        figure_id = figure_live_list_next(figure_id))
+
+/**
+ * Removes all figures from the list
+ */
+void figure_live_list_clear();
+
+/**
+ * Adds a figure to the list, does nothing if it is already in the list
+ * @param figure_id Figure ID
+ */
+void figure_live_list_add(int figure_id);
+
+/**
+ * Removes a figure from the list, does nothing if it is not in the list
+ * @param figure_id Figure ID
+ */
+void figure_live_list_remove(int figure_id);
+
+/**
+ * Returns whether the figure is in the list
+ * @param figure_id Figure ID
+ * @return Boolean true if the figure is in the list
+ */
+int figure_live_list_contains(int figure_id);
+
+/**
+ * Returns the number of live figures
+ * @return Number of figures
+ */
+int figure_live_list_count();
+
+/**
+ * Returns the live figure at a position in the list
+ * @param index Position, from 0 to figure_live_list_count() - 1
+ * @return Figure ID, 0 if the index is out of range
+ */
+int figure_live_list_get(int index);
+
+/**
+ * Returns the live figure with the lowest ID higher than the given ID.
+ * Calling it with the previously returned ID takes constant time.
+ * @param figure_id Figure ID, does not have to be in the list
+ * @return Figure ID, 0 if there is no such figure
+ */
+int figure_live_list_next(int figure_id);
+
+#endif // FIGURE_LIVE_LIST_H
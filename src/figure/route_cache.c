@@ -0,0 +1,129 @@
+#include "figure/route_cache.h"
+
+#define HASH_SIZE 512
+
+// Entry IDs start at 1, 0 marks the end of a list
+typedef struct {
+    route_cache_key key;
+    route_cache_path path;
+    int hash_next;
+    int lru_prev;
+    int lru_next;
+} cache_entry;
+
+static struct {
+    int version;
+    int num_entries;
+    int lru_first;
+    int lru_last;
+    int hash[HASH_SIZE];
+    cache_entry entries[ROUTE_CACHE_SIZE + 1];
+} data;
+
+static unsigned int hash_key(const route_cache_key *key)
+{
+    unsigned int hash = (unsigned int) key->source * 2654435761u;
+    hash ^= (unsigned int) key->destination * 40503u;
+    hash ^= (unsigned int) key->terrain_usage << 20;
+    hash ^= (unsigned int) key->building_id * 97u;
+    return (hash ^ (hash >> 16)) & (HASH_SIZE - 1);
+}
+
+static int same_key(const route_cache_key *a, const route_cache_key *b)
+{
+    return a->source == b->source && a->destination == b->destination &&
+        a->terrain_usage == b->terrain_usage && a->building_id == b->building_id;
+}
+
+static void lru_remove(int id)
+{
+    cache_entry *entry = &data.entries[id];
+    if (entry->lru_prev) {
+        data.entries[entry->lru_prev].lru_next = entry->lru_next;
+    } else {
+        data.lru_first = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        data.entries[entry->lru_next].lru_prev = entry->lru_prev;
+    } else {
+        data.lru_last = entry->lru_prev;
+    }
+}
+
+static void lru_add_first(int id)
+{
+    cache_entry *entry = &data.entries[id];
+    entry->lru_prev = 0;
+    entry->lru_next = data.lru_first;
+    if (data.lru_first) {
+        data.entries[data.lru_first].lru_prev = id;
+    } else {
+        data.lru_last = id;
+    }
+    data.lru_first = id;
+}
+
+static void hash_remove(int id)
+{
+    int *link = &data.hash[hash_key(&data.entries[id].key)];
+    while (*link != id) {
+        link = &data.entries[*link].hash_next;
+    }
+    *link = data.entries[id].hash_next;
+}
+
+static void check_version(int version)
+{
+    if (version != data.version) {
+        route_cache_clear();
+        data.version = version;
+    }
+}
+
+void route_cache_clear()
+{
+    for (int i = 0; i < HASH_SIZE; i++) {
+        data.hash[i] = 0;
+    }
+    data.num_entries = 0;
+    data.lru_first = 0;
+    data.lru_last = 0;
+}
+
+const route_cache_path *route_cache_get(const route_cache_key *key, int version)
+{
+    check_version(version);
+    for (int id = data.hash[hash_key(key)]; id; id = data.entries[id].hash_next) {
+        if (same_key(&data.entries[id].key, key)) {
+            if (data.lru_first != id) {
+                lru_remove(id);
+                lru_add_first(id);
+            }
+            return &data.entries[id].path;
+        }
+    }
+    return 0;
+}
+
+route_cache_path *route_cache_add(const route_cache_key *key, int version)
+{
+    check_version(version);
+    int id;
+    if (data.num_entries < ROUTE_CACHE_SIZE) {
+        id = ++data.num_entries;
+    } else {
+        id = data.lru_last;
+        hash_remove(id);
+        lru_remove(id);
+    }
+    cache_entry *entry = &data.entries[id];
+    unsigned int hash = hash_key(key);
+    entry->key = *key;
+    entry->path.length = 0;
+    entry->path.routes_calculated = 0;
+    entry->path.enemy_routes_calculated = 0;
+    entry->hash_next = data.hash[hash];
+    data.hash[hash] = id;
+    lru_add_first(id);
+    return &entry->path;
+}
@@ -0,0 +1,50 @@
+#ifndef FIGURE_ROUTE_CACHE_H
+#define FIGURE_ROUTE_CACHE_H
+
+/**
+ * @file
+ * Least recently used cache of calculated figure routes.
+ *
+ * Entries are only valid for the terrain version they were calculated for,
+ * using another version clears the cache.
+ */
+
+#define ROUTE_CACHE_SIZE 256
+#define ROUTE_CACHE_MAX_PATH_LENGTH 500
+
+typedef struct {
+    int source; /**< Grid offset of the source tile */
+    int destination; /**< Grid offset of the destination tile */
+    int terrain_usage; /**< Terrain usage of the figure */
+    int building_id; /**< Building the route may pass through, 0 for none */
+} route_cache_key;
+
+typedef struct {
+    int length; /**< Path length, 0 if there is no route */
+    int routes_calculated; /**< Number of routing queries needed to calculate the route */
+    int enemy_routes_calculated; /**< Number of enemy routing queries needed */
+    unsigned char directions[ROUTE_CACHE_MAX_PATH_LENGTH]; /**< Path directions */
+} route_cache_path;
+
+/**
+ * Removes all routes from the cache
+ */
+void route_cache_clear();
+
+/**
+ * Looks up a route and marks it as most recently used
+ * @param key Route to look up
+ * @param version Current terrain version
+ * @return Cached route or 0 if the route is not in the cache
+ */
+const route_cache_path *route_cache_get(const route_cache_key *key, int version);
+
+/**
+ * Adds a route, replacing the least recently used route if the cache is full
+ * @param key Route to add
+ * @param version Current terrain version
+ * @return Path to fill in for the route
+ */
+route_cache_path *route_cache_add(const route_cache_key *key, int version);
+
+#endif // FIGURE_ROUTE_CACHE_H
@@ -0,0 +1,136 @@
+#include "tick_scheduler.h"
+
+struct task_state {
+    tick_task task;
+    int in_progress;
+    int buckets_done;
+    int next_entity_id;
+};
+
+static struct {
+    struct task_state tasks[TICK_SCHEDULER_MAX_TASKS];
+    int num_tasks;
+    tick_scheduler_mode mode;
+} data;
+
+static int is_valid(const tick_task *task)
+{
+    if (task->cadence <= 0 || TICK_SCHEDULER_TICKS_PER_DAY % task->cadence != 0 || task->slot < 0) {
+        return 0;
+    }
+    if (task->run) {
+        return !task->update;
+    }
+    return task->update && task->num_entities;
+}
+
+void tick_scheduler_clear()
+{
+    data.num_tasks = 0;
+    data.mode = TICK_SCHEDULER_COMPATIBLE;
+}
+
+int tick_scheduler_add(const tick_task *task)
+{
+    if (data.num_tasks >= TICK_SCHEDULER_MAX_TASKS || !is_valid(task)) {
+        return -1;
+    }
+    struct task_state *state = &data.tasks[data.num_tasks];
+    state->task = *task;
+    state->in_progress = 0;
+    return data.num_tasks++;
+}
+
+void tick_scheduler_set_mode(tick_scheduler_mode mode)
+{
+    data.mode = mode;
+    tick_scheduler_reset();
+}
+
+tick_scheduler_mode tick_scheduler_get_mode()
+{
+    return data.mode;
+}
+
+void tick_scheduler_reset()
+{
+    for (int i = 0; i < data.num_tasks; i++) {
+        data.tasks[i].in_progress = 0;
+    }
+}
+
+// The entity count is checked before each update: updates may add or remove entities
+static void update_entities(struct task_state *state, int last_entity_id)
+{
+    const tick_task *task = &state->task;
+    while (state->next_entity_id < last_entity_id && state->next_entity_id < task->num_entities()) {
+        task->update(state->next_entity_id++);
+    }
+}
+
+static void begin_pass(struct task_state *state)
+{
+    state->in_progress = 1;
+    state->buckets_done = 0;
+    state->next_entity_id = 1;
+    if (state->task.begin) {
+        state->task.begin();
+    }
+}
+
+static void finish_pass(struct task_state *state)
+{
+    const tick_task *task = &state->task;
+    while (state->next_entity_id < task->num_entities()) {
+        task->update(state->next_entity_id++);
+    }
+    state->in_progress = 0;
+    if (task->end) {
+        task->end();
+    }
+}
+
+// Each bucket updates an equal share of the entity IDs as counted on that tick
+static void run_spread_bucket(struct task_state *state)
+{
+    const tick_task *task = &state->task;
+    state->buckets_done++;
+    if (state->buckets_done < task->cadence) {
+        int num_ids = task->num_entities() - 1;
+        update_entities(state, 1 + num_ids * state->buckets_done / task->cadence);
+    } else {
+        finish_pass(state);
+    }
+}
+
+static void run_task(struct task_state *state, int tick)
+{
+    const tick_task *task = &state->task;
+    int starts_pass = tick % task->cadence == task->slot % task->cadence;
+    if (task->run) {
+        if (starts_pass) {
+            task->run();
+        }
+        return;
+    }
+    if (data.mode == TICK_SCHEDULER_COMPATIBLE) {
+        if (starts_pass) {
+            begin_pass(state);
+            finish_pass(state);
+        }
+        return;
+    }
+    if (starts_pass && !state->in_progress) {
+        begin_pass(state);
+    }
+    if (state->in_progress) {
+        run_spread_bucket(state);
+    }
+}
+
+void tick_scheduler_run(int tick)
+{
+    for (int i = 0; i < data.num_tasks; i++) {
+        run_task(&data.tasks[i], tick);
+    }
+}
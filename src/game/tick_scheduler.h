@@ -0,0 +1,74 @@
+#ifndef GAME_TICK_SCHEDULER_H
+#define GAME_TICK_SCHEDULER_H
+
+/**
+ * @file
+ * Scheduler for the city updates that run once every few ticks.
+ *
+ * Each task has a cadence: the number of ticks between two passes over the
+ * city. A task either does its whole pass in one go, or updates one entity
+ * at a time. In compatible mode every pass runs on the tick of its slot,
+ * in registration order, exactly like the original game. In spread mode the
+ * entity tasks split their pass over all ticks of their cadence, so that
+ * each tick updates about the same number of entities.
+ */
+
+#define TICK_SCHEDULER_TICKS_PER_DAY 50
+#define TICK_SCHEDULER_MAX_TASKS 64
+
+typedef enum {
+    TICK_SCHEDULER_COMPATIBLE = 0,
+    TICK_SCHEDULER_SPREAD = 1
+} tick_scheduler_mode;
+
+/**
+ * Task description. A task has either a run function or an update function.
+ */
+typedef struct {
+    const char *name; /**< Task name */
+    int cadence; /**< Ticks between passes, must divide TICK_SCHEDULER_TICKS_PER_DAY */
+    int slot; /**< Tick on which a pass starts, modulo the cadence */
+    void (*run)(void); /**< Does the whole pass, 0 for an entity task */
+    void (*begin)(void); /**< Entity task: called before the first entity of a pass, may be 0 */
+    void (*update)(int entity_id); /**< Entity task: updates one entity */
+    void (*end)(void); /**< Entity task: called after the last entity of a pass, may be 0 */
+    int (*num_entities)(void); /**< Entity task: entity IDs run from 1 to num_entities() - 1 */
+} tick_task;
+
+/**
+ * Removes all tasks and sets compatible mode
+ */
+void tick_scheduler_clear();
+
+/**
+ * Adds a task, tasks on the same tick run in the order they were added
+ * @param task Task, copied
+ * @return Task index, -1 if the task is invalid or there are too many tasks
+ */
+int tick_scheduler_add(const tick_task *task);
+
+/**
+ * Sets the scheduling mode, passes in progress are dropped
+ * @param mode Mode
+ */
+void tick_scheduler_set_mode(tick_scheduler_mode mode);
+
+/**
+ * Gets the scheduling mode
+ * @return Mode
+ */
+tick_scheduler_mode tick_scheduler_get_mode();
+
+/**
+ * Drops the passes in progress, for when the game state is replaced.
+ * Each dropped pass starts over on the next tick of its slot.
+ */
+void tick_scheduler_reset();
+
+/**
+ * Runs the tasks of a tick
+ * @param tick Tick within the day, 0 to TICK_SCHEDULER_TICKS_PER_DAY - 1
+ */
+void tick_scheduler_run(int tick);
+
+#endif // GAME_TICK_SCHEDULER_H
@@ -0,0 +1,117 @@
+#include "aqueduct.h"
+
+#include <string.h>
+
+#define GRID_TILES (MAP_AQUEDUCT_GRID_SIZE * MAP_AQUEDUCT_GRID_SIZE)
+
+static const int ADJACENT_OFFSETS[] = { -MAP_AQUEDUCT_GRID_SIZE, 1, MAP_AQUEDUCT_GRID_SIZE, -1 };
+// tiles next to the middle of each side of a reservoir, from its top left tile
+static const int CONNECTOR_OFFSETS[] = {
+    1 - MAP_AQUEDUCT_GRID_SIZE, 3 + MAP_AQUEDUCT_GRID_SIZE,
+    1 + 3 * MAP_AQUEDUCT_GRID_SIZE, -1 + MAP_AQUEDUCT_GRID_SIZE
+};
+
+static struct {
+    map_aqueduct_grid grid;
+    int num_segments;
+    int segment[GRID_TILES];
+    int first_link[GRID_TILES];
+    unsigned char has_water[GRID_TILES];
+    int num_links;
+    struct {
+        int building_id;
+        int next;
+    } links[MAP_AQUEDUCT_MAX_LINKS];
+    int items[GRID_TILES];
+    int queue[MAP_AQUEDUCT_MAX_RESERVOIRS];
+} data;
+
+static void add_link(int segment, int building_id)
+{
+    for (int e = data.first_link[segment]; e; e = data.links[e].next) {
+        if (data.links[e].building_id == building_id) {
+            return;
+        }
+    }
+    if (data.num_links >= MAP_AQUEDUCT_MAX_LINKS) {
+        return;
+    }
+    int e = data.num_links++;
+    data.links[e].building_id = building_id;
+    data.links[e].next = data.first_link[segment];
+    data.first_link[segment] = e;
+}
+
+static void label_segment(int grid_offset, int segment)
+{
+    data.first_link[segment] = 0;
+    data.segment[grid_offset] = segment;
+    int head = 0;
+    int tail = 0;
+    data.items[tail++] = grid_offset;
+    while (head < tail) {
+        int offset = data.items[head++];
+        for (int i = 0; i < 4; i++) {
+            int next = offset + ADJACENT_OFFSETS[i];
+            int type = data.grid.tile_type(next);
+            if (type > 0) {
+                add_link(segment, type);
+            } else if (type == MAP_AQUEDUCT_PIPE && !data.segment[next]) {
+                data.segment[next] = segment;
+                data.items[tail++] = next;
+            }
+        }
+    }
+}
+
+void map_aqueduct_build(const map_aqueduct_grid *grid)
+{
+    data.grid = *grid;
+    memset(data.segment, 0, sizeof(data.segment));
+    data.num_segments = 0;
+    // link 0 ends the lists
+    data.num_links = 1;
+    int grid_offset = grid->start_offset;
+    for (int y = 0; y < grid->height; y++, grid_offset += MAP_AQUEDUCT_GRID_SIZE - grid->width) {
+        for (int x = 0; x < grid->width; x++, grid_offset++) {
+            if (!data.segment[grid_offset] && grid->tile_type(grid_offset) == MAP_AQUEDUCT_PIPE) {
+                label_segment(grid_offset, ++data.num_segments);
+            }
+        }
+    }
+}
+
+void map_aqueduct_fill(const int *reservoirs, int num_reservoirs, map_aqueduct_reservoir_reached reached)
+{
+    memset(data.has_water, 0, (data.num_segments + 1) * sizeof(data.has_water[0]));
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < num_reservoirs && tail < MAP_AQUEDUCT_MAX_RESERVOIRS; i++) {
+        data.queue[tail++] = reservoirs[i];
+    }
+    while (head < tail) {
+        int reservoir_offset = data.grid.reservoir_offset(data.queue[head++]);
+        for (int d = 0; d < 4; d++) {
+            int segment = data.segment[reservoir_offset + CONNECTOR_OFFSETS[d]];
+            if (!segment || data.has_water[segment]) {
+                continue;
+            }
+            data.has_water[segment] = 1;
+            for (int e = data.first_link[segment]; e; e = data.links[e].next) {
+                if (reached(data.links[e].building_id) && tail < MAP_AQUEDUCT_MAX_RESERVOIRS) {
+                    data.queue[tail++] = data.links[e].building_id;
+                }
+            }
+        }
+    }
+}
+
+int map_aqueduct_has_water(int grid_offset)
+{
+    return data.has_water[data.segment[grid_offset]];
+}
+
+int map_aqueduct_num_segments()
+{
+    return data.num_segments;
+}
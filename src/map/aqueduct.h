@@ -0,0 +1,96 @@
+#ifndef MAP_AQUEDUCT_H
+#define MAP_AQUEDUCT_H
+
+/**
+ * @file
+ * Water in the aqueduct network.
+ *
+ * Connected aqueduct tiles form a segment, which is linked to the reservoirs
+ * whose sides it touches. Filling the segments from the reservoirs that have
+ * water gives the same aqueducts and reservoirs with water as flooding the
+ * aqueducts tile by tile, but visits each segment once. The segments only
+ * have to be built again when aqueducts or reservoirs change.
+ */
+
+// follows the GRID_SIZE build option of the game grids
+#ifdef GRID_SIZE
+#define MAP_AQUEDUCT_GRID_SIZE GRID_SIZE
+#else
+#define MAP_AQUEDUCT_GRID_SIZE 162
+#endif
+#define MAP_AQUEDUCT_MAX_RESERVOIRS 8000
+#define MAP_AQUEDUCT_MAX_LINKS (4 * MAP_AQUEDUCT_MAX_RESERVOIRS)
+
+/**
+ * Tile types, besides the building IDs of reservoirs
+ */
+enum {
+    MAP_AQUEDUCT_NONE = 0,
+    MAP_AQUEDUCT_PIPE = -1
+};
+
+/**
+ * Gets the type of a tile
+ * @param grid_offset Grid offset
+ * @return MAP_AQUEDUCT_PIPE for an aqueduct, the building ID of the reservoir
+ *         for a tile on the side of a reservoir, MAP_AQUEDUCT_NONE otherwise,
+ *         also for the corner tiles of a reservoir
+ */
+typedef int (*map_aqueduct_tile_type)(int grid_offset);
+
+/**
+ * Gets the grid offset of the top left tile of a 3x3 reservoir
+ * @param building_id Reservoir
+ * @return Grid offset
+ */
+typedef int (*map_aqueduct_reservoir_offset)(int building_id);
+
+/**
+ * Called each time the water reaches a reservoir through an aqueduct,
+ * also for reservoirs that already have water
+ * @param building_id Reservoir
+ * @return Boolean true if the water flows on into the aqueducts of this reservoir
+ */
+typedef int (*map_aqueduct_reservoir_reached)(int building_id);
+
+/**
+ * Map to build the segments from
+ */
+typedef struct {
+    int start_offset; /**< Grid offset of map tile (0, 0) */
+    int width; /**< Map width */
+    int height; /**< Map height */
+    map_aqueduct_tile_type tile_type; /**< Tile types */
+    map_aqueduct_reservoir_offset reservoir_offset; /**< Reservoir positions */
+} map_aqueduct_grid;
+
+/**
+ * Labels the aqueduct segments and links them to the reservoirs they touch
+ * @param grid Map, copied
+ */
+void map_aqueduct_build(const map_aqueduct_grid *grid);
+
+/**
+ * Removes the water from all segments and fills them from reservoirs.
+ * The aqueducts next to the middle of each side of a reservoir with water
+ * get water, and so do the reservoirs linked to them, one after the other.
+ * @param reservoirs Reservoirs that have water of their own
+ * @param num_reservoirs Number of reservoirs
+ * @param reached Called for the reservoirs the water reaches
+ */
+void map_aqueduct_fill(const int *reservoirs, int num_reservoirs, map_aqueduct_reservoir_reached reached);
+
+/**
+ * Checks whether a tile is an aqueduct with water
+ * @param grid_offset Grid offset
+ * @return Boolean true if the tile is in a segment with water
+ */
+int map_aqueduct_has_water(int grid_offset);
+
+/**
+ * Gets the number of segments found by the last build
+ * @return Number of segments
+ */
+int map_aqueduct_num_segments();
+
+#endif // MAP_AQUEDUCT_H
@@ -0,0 +1,93 @@
+#include "building_coverage.h"
+
+#include <string.h>
+
+#define GRID_TILES (MAP_BUILDING_COVERAGE_GRID_SIZE * MAP_BUILDING_COVERAGE_GRID_SIZE)
+#define RADIUS MAP_BUILDING_COVERAGE_RADIUS
+
+static struct {
+    map_building_coverage_grid grid;
+    unsigned char valid[GRID_TILES];
+    building_coverage lists[GRID_TILES];
+    // list for tiles outside the map, never kept
+    building_coverage scratch;
+} data;
+
+void map_building_coverage_init(const map_building_coverage_grid *grid)
+{
+    data.grid = *grid;
+    map_building_coverage_clear();
+}
+
+void map_building_coverage_clear()
+{
+    memset(data.valid, 0, sizeof(data.valid));
+}
+
+void map_building_coverage_tile_changed(int grid_offset)
+{
+    for (int dy = -RADIUS; dy <= RADIUS; dy++) {
+        for (int dx = -RADIUS; dx <= RADIUS; dx++) {
+            // offsets wrapping around a row only invalidate a few lists too many
+            int offset = grid_offset + dy * MAP_BUILDING_COVERAGE_GRID_SIZE + dx;
+            if (offset >= 0 && offset < GRID_TILES) {
+                data.valid[offset] = 0;
+            }
+        }
+    }
+}
+
+static int building_index(building_coverage *list, int building_id)
+{
+    for (int i = 0; i < list->num_buildings; i++) {
+        if (list->building_ids[i] == building_id) {
+            return i;
+        }
+    }
+    int index = list->num_buildings++;
+    list->building_ids[index] = building_id;
+    list->building_tiles[index] = 0;
+    return index;
+}
+
+static void build_list(building_coverage *list, int x, int y)
+{
+    list->num_buildings = 0;
+    list->num_tiles = 0;
+    if (!data.grid.building_ids) {
+        return;
+    }
+    int x_min = x - RADIUS < 0 ? 0 : x - RADIUS;
+    int y_min = y - RADIUS < 0 ? 0 : y - RADIUS;
+    int x_max = x + RADIUS >= data.grid.width ? data.grid.width - 1 : x + RADIUS;
+    int y_max = y + RADIUS >= data.grid.height ? data.grid.height - 1 : y + RADIUS;
+    for (int yy = y_min; yy <= y_max; yy++) {
+        int grid_offset = data.grid.start_offset + yy * MAP_BUILDING_COVERAGE_GRID_SIZE + x_min;
+        for (int xx = x_min; xx <= x_max; xx++, grid_offset++) {
+            int building_id = data.grid.building_ids[grid_offset];
+            if (!building_id) {
+                continue;
+            }
+            if (data.grid.main_building) {
+                building_id = data.grid.main_building(building_id);
+            }
+            int index = building_index(list, building_id);
+            list->building_tiles[index]++;
+            list->tile_buildings[list->num_tiles++] = index;
+        }
+    }
+}
+
+const building_coverage *map_building_coverage_get(int x, int y)
+{
+    if (x < 0 || y < 0 || x >= data.grid.width || y >= data.grid.height) {
+        build_list(&data.scratch, x, y);
+        return &data.scratch;
+    }
+    int grid_offset = data.grid.start_offset + y * MAP_BUILDING_COVERAGE_GRID_SIZE + x;
+    if (!data.valid[grid_offset]) {
+        build_list(&data.lists[grid_offset], x, y);
+        data.valid[grid_offset] = 1;
+    }
+    return &data.lists[grid_offset];
+}
@@ -0,0 +1,79 @@
+#ifndef MAP_BUILDING_COVERAGE_H
+#define MAP_BUILDING_COVERAGE_H
+
+/**
+ * @file
+ * Buildings within service range of each tile, for walkers that provide services.
+ *
+ * The list of a tile holds the buildings on the tiles within
+ * MAP_BUILDING_COVERAGE_RADIUS, each building once, along with the order in which
+ * a row by row scan of those tiles meets them. Lists are built the first time a
+ * tile is asked for and rebuilt after a building tile in range has changed.
+ */
+
+// follows the GRID_SIZE build option of the game grids
+#ifdef GRID_SIZE
+#define MAP_BUILDING_COVERAGE_GRID_SIZE GRID_SIZE
+#else
+#define MAP_BUILDING_COVERAGE_GRID_SIZE 162
+#endif
+#define MAP_BUILDING_COVERAGE_RADIUS 2
+#define MAP_BUILDING_COVERAGE_MAX_TILES \
+    ((2 * MAP_BUILDING_COVERAGE_RADIUS + 1) * (2 * MAP_BUILDING_COVERAGE_RADIUS + 1))
+
+/**
+ * Maps the building on a tile to the building that receives its services
+ * @param building_id Building on the tile, never 0
+ * @return Building to list
+ */
+typedef int (*map_building_coverage_main_building)(int building_id);
+
+/**
+ * Grid of building IDs to build the lists from
+ */
+typedef struct {
+    const unsigned short *building_ids; /**< Grid of MAP_BUILDING_COVERAGE_GRID_SIZE x MAP_BUILDING_COVERAGE_GRID_SIZE tiles */
+    int start_offset; /**< Grid offset of map tile (0, 0) */
+    int width; /**< Map width */
+    int height; /**< Map height */
+    map_building_coverage_main_building main_building; /**< Building mapping, 0 to list the buildings as they are */
+} map_building_coverage_grid;
+
+/**
+ * Buildings within range of a tile
+ */
+typedef struct {
+    int num_buildings; /**< Number of different buildings */
+    int num_tiles; /**< Number of tiles with a building */
+    unsigned short building_ids[MAP_BUILDING_COVERAGE_MAX_TILES]; /**< Buildings, in order of the first tile seen */
+    unsigned char building_tiles[MAP_BUILDING_COVERAGE_MAX_TILES]; /**< Number of tiles of each building */
+    unsigned char tile_buildings[MAP_BUILDING_COVERAGE_MAX_TILES]; /**< Index in building_ids for each tile with a building, row by row */
+} building_coverage;
+
+/**
+ * Sets the grid to build lists from and removes all lists
+ * @param grid Grid, copied
+ */
+void map_building_coverage_init(const map_building_coverage_grid *grid);
+
+/**
+ * Removes all lists, for when the building grid or the building mapping changed
+ */
+void map_building_coverage_clear();
+
+/**
+ * Invalidates the lists of the tiles in range of a tile, to be called when
+ * the building on the tile changed
+ * @param grid_offset Grid offset of the changed tile
+ */
+void map_building_coverage_tile_changed(int grid_offset);
+
+/**
+ * Gets the buildings within range of a tile
+ * @param x X of the tile
+ * @param y Y of the tile
+ * @return List, valid until the building grid changes
+ */
+const building_coverage *map_building_coverage_get(int x, int y);
+
+#endif // MAP_BUILDING_COVERAGE_H
@@ -0,0 +1,321 @@
+#include "ring.h"
+
+#define MAX_TILES 1080
+#define RING_SIZE(s,d) (4 * ((s) - 1) + 8 * (d))
+
+#define STAMP_SIDE (MAP_RING_MAX_SIZE + 2 * MAP_RING_MAX_DISTANCE)
+#define STAMP_ROW 32
+#define MIN_STAMP_RANGE 2
+#define MAX_STAMPS 64
+#define MAX_STAMP_PROBES 4
+#define MAX_REPEATS 8
+
+struct stamp {
+    int in_use;
+    int usable;
+    map_ring_desirability desirability;
+    int range;
+    signed char add[STAMP_SIDE * STAMP_ROW];
+    unsigned char written[STAMP_SIDE * STAMP_ROW];
+    // tiles written more than once: the quirk for size 4 distance 2
+    int num_repeats;
+    struct {
+        int x;
+        int y;
+        short add;
+    } repeats[MAX_REPEATS];
+};
+
+static struct {
+    ring_tile tiles[MAX_TILES];
+    int index[MAP_RING_MAX_SIZE + 1][MAP_RING_MAX_DISTANCE + 1];
+} data;
+
+// each thread has its own stamp cache, so threads can add desirability to different rows at once
+static __thread struct stamp stamps[MAX_STAMPS];
+
+void map_ring_init()
+{
+    int index = 0;
+    int x, y;
+    for (int s = 1; s <= MAP_RING_MAX_SIZE; s++) {
+        for (int d = 1; d <= MAP_RING_MAX_DISTANCE; d++) {
+            data.index[s][d] = index;
+            // top row, from x=0
+            for (y = -d, x = 0; x < s + d; x++, index++) {
+                data.tiles[index].x = x;
+                data.tiles[index].y = y;
+            }
+            // right row down
+            for (x = s + d - 1, y = -d + 1; y < s + d; y++, index++) {
+                data.tiles[index].x = x;
+                data.tiles[index].y = y;
+            }
+            // bottom row to the left
+            for (y = s + d - 1, x = s + d - 2; x >= -d; x--, index++) {
+                data.tiles[index].x = x;
+                data.tiles[index].y = y;
+            }
+            // exception (bug in game): size 4 distance 2, left corner is off by x+1, y-1
+            if (s == 4 && d == 2) {
+                data.tiles[index-1].x += 1;
+                data.tiles[index-1].y -= 1;
+            }
+            // left row up
+            for (x = -d, y = s + d - 2; y >= -d; y--, index++) {
+                data.tiles[index].x = x;
+                data.tiles[index].y = y;
+            }
+            // top row up to x=0
+            for (y = -d, x = -d + 1; x < 0; x++, index++) {
+                data.tiles[index].x = x;
+                data.tiles[index].y = y;
+            }
+        }
+    }
+    for (int i = 0; i < index; i++) {
+        data.tiles[i].grid_offset = data.tiles[i].y * MAP_RING_GRID_SIZE + data.tiles[i].x;
+    }
+    for (int i = 0; i < MAX_STAMPS; i++) {
+        stamps[i].in_use = 0;
+    }
+}
+
+int map_ring_start(int size, int distance)
+{
+    return data.index[size][distance];
+}
+
+int map_ring_end(int size, int distance)
+{
+    return data.index[size][distance] + RING_SIZE(size, distance);
+}
+
+const ring_tile *map_ring_tile(int index)
+{
+    return &data.tiles[index];
+}
+
+static int clamp_desirability(int value)
+{
+    if (value < -100) {
+        return -100;
+    }
+    return value > 100 ? 100 : value;
+}
+
+static int is_inside_map(const map_ring_grid *grid, int x, int y)
+{
+    return x >= -1 && x <= grid->width && y >= -1 && y <= grid->height;
+}
+
+static int is_inside_area(const map_ring_area *area, int x, int y)
+{
+    return !area || (x >= area->x_min && x <= area->x_max && y >= area->y_min && y <= area->y_max);
+}
+
+static int is_partially_outside_map(const map_ring_grid *grid, int x, int y, int size, int distance)
+{
+    return x - distance < -1 || x + distance + size - 1 > grid->width ||
+        y - distance < -1 || y + distance + size - 1 > grid->height;
+}
+
+static int get_range(const map_ring_desirability *desirability)
+{
+    if (desirability->size <= 0 || desirability->size > MAP_RING_MAX_SIZE) {
+        return 0;
+    }
+    return desirability->range > MAP_RING_MAX_DISTANCE ? MAP_RING_MAX_DISTANCE : desirability->range;
+}
+
+static void add_ring(const map_ring_grid *grid, int x, int y, int size, int distance, int value,
+    const map_ring_area *area)
+{
+    int start = map_ring_start(size, distance);
+    int end = map_ring_end(size, distance);
+    int base_offset = grid->start_offset + y * MAP_RING_GRID_SIZE + x;
+    char *base = &grid->grid[base_offset];
+    int base_in_area = is_inside_area(area, x, y);
+
+    if (is_partially_outside_map(grid, x, y, size, distance)) {
+        for (int i = start; i < end; i++) {
+            const ring_tile *tile = &data.tiles[i];
+            if (is_inside_map(grid, x + tile->x, y + tile->y)) {
+                if (is_inside_area(area, x + tile->x, y + tile->y)) {
+                    base[tile->grid_offset] += value;
+                }
+                if (base_in_area) {
+                    // BUG in the original game: bounding on wrong tile
+                    *base = clamp_desirability(*base);
+                }
+            }
+        }
+    } else {
+        for (int i = start; i < end; i++) {
+            const ring_tile *tile = &data.tiles[i];
+            if (is_inside_area(area, x + tile->x, y + tile->y)) {
+                base[tile->grid_offset] = clamp_desirability(base[tile->grid_offset] + value);
+            }
+        }
+    }
+}
+
+void map_ring_add_desirability_per_ring(const map_ring_grid *grid, int x, int y,
+    const map_ring_desirability *desirability, const map_ring_area *area)
+{
+    int range = get_range(desirability);
+    int value = desirability->value;
+    int tiles_within_step = 0;
+    for (int distance = 1; distance <= range; distance++) {
+        add_ring(grid, x, y, desirability->size, distance, value, area);
+        tiles_within_step++;
+        if (tiles_within_step >= desirability->step) {
+            value += desirability->step_size;
+            tiles_within_step = 0;
+        }
+    }
+}
+
+static int is_same_desirability(const struct stamp *stamp, const map_ring_desirability *desirability, int range)
+{
+    return stamp->range == range && stamp->desirability.size == desirability->size &&
+        stamp->desirability.value == desirability->value && stamp->desirability.step == desirability->step &&
+        stamp->desirability.step_size == desirability->step_size;
+}
+
+static void build_stamp(struct stamp *stamp, const map_ring_desirability *desirability, int range)
+{
+    int size = desirability->size;
+    stamp->in_use = 1;
+    stamp->usable = 1;
+    stamp->desirability = *desirability;
+    stamp->range = range;
+    stamp->num_repeats = 0;
+    for (int i = 0; i < STAMP_SIDE * STAMP_ROW; i++) {
+        stamp->add[i] = 0;
+        stamp->written[i] = 0;
+    }
+    int value = desirability->value;
+    int tiles_within_step = 0;
+    for (int distance = 1; distance <= range; distance++) {
+        if (value < -128 || value > 127) {
+            // does not fit the stamp, the rings are added one by one
+            stamp->usable = 0;
+        }
+        int end = map_ring_end(size, distance);
+        for (int i = map_ring_start(size, distance); i < end; i++) {
+            int index = (data.tiles[i].y + range) * STAMP_ROW + data.tiles[i].x + range;
+            if (!stamp->written[index]) {
+                stamp->written[index] = 1;
+                stamp->add[index] = value;
+            } else if (stamp->num_repeats < MAX_REPEATS) {
+                stamp->repeats[stamp->num_repeats].x = data.tiles[i].x;
+                stamp->repeats[stamp->num_repeats].y = data.tiles[i].y;
+                stamp->repeats[stamp->num_repeats].add = value;
+                stamp->num_repeats++;
+            } else {
+                stamp->usable = 0;
+            }
+        }
+        tiles_within_step++;
+        if (tiles_within_step >= desirability->step) {
+            value += desirability->step_size;
+            tiles_within_step = 0;
+        }
+    }
+}
+
+static const struct stamp *get_stamp(const map_ring_desirability *desirability, int range)
+{
+    unsigned int hash = (unsigned int) (desirability->size * 7 + desirability->value * 31 +
+        desirability->step * 127 + desirability->step_size * 61 + range * 17);
+    int first_slot = hash % MAX_STAMPS;
+    for (int i = 0; i < MAX_STAMP_PROBES; i++) {
+        struct stamp *stamp = &stamps[(first_slot + i) % MAX_STAMPS];
+        if (!stamp->in_use) {
+            build_stamp(stamp, desirability, range);
+            return stamp;
+        }
+        if (is_same_desirability(stamp, desirability, range)) {
+            return stamp;
+        }
+    }
+    // all probed slots taken by other models: replace the first one
+    build_stamp(&stamps[first_slot], desirability, range);
+    return &stamps[first_slot];
+}
+
+static void add_row(char *restrict tiles, const signed char *restrict add,
+    const unsigned char *restrict written, int count)
+{
+    for (int i = 0; i < count; i++) {
+        short value = (short) (tiles[i] + add[i]);
+        value = value < -100 ? -100 : value;
+        value = value > 100 ? 100 : value;
+        tiles[i] = written[i] ? (char) value : tiles[i];
+    }
+}
+
+static void add_full_row(char *restrict tiles, const signed char *restrict add,
+    const unsigned char *restrict written)
+{
+    // same as add_row, but the fixed count lets compilers use vector instructions without
+    // a scalar tail. Tiles past the stamp are not written to, so they keep their value.
+    for (int i = 0; i < STAMP_ROW; i++) {
+        short value = (short) (tiles[i] + add[i]);
+        value = value < -100 ? -100 : value;
+        value = value > 100 ? 100 : value;
+        tiles[i] = written[i] ? (char) value : tiles[i];
+    }
+}
+
+void map_ring_add_desirability(const map_ring_grid *grid, int x, int y,
+    const map_ring_desirability *desirability, const map_ring_area *area)
+{
+    int range = get_range(desirability);
+    int size = desirability->size;
+    if (range < MIN_STAMP_RANGE || is_partially_outside_map(grid, x, y, size, range)) {
+        // small rings are faster one by one
+        map_ring_add_desirability_per_ring(grid, x, y, desirability, area);
+        return;
+    }
+    const struct stamp *stamp = get_stamp(desirability, range);
+    if (!stamp->usable) {
+        map_ring_add_desirability_per_ring(grid, x, y, desirability, area);
+        return;
+    }
+    int x_min = x - range;
+    int y_min = y - range;
+    int x_max = x + size - 1 + range;
+    int y_max = y + size - 1 + range;
+    int full_rows = 1;
+    if (area) {
+        if (area->x_min > x_min) x_min = area->x_min;
+        if (area->y_min > y_min) y_min = area->y_min;
+        if (area->x_max < x_max) x_max = area->x_max;
+        if (area->y_max < y_max) y_max = area->y_max;
+        if (x_min > x_max || y_min > y_max) {
+            return;
+        }
+        full_rows = x_min == x - range && x_max == x + size - 1 + range;
+    }
+    for (int row = y_min; row <= y_max; row++) {
+        int grid_offset = grid->start_offset + row * MAP_RING_GRID_SIZE + x_min;
+        int stamp_index = (row - y + range) * STAMP_ROW + x_min - x + range;
+        // a full row must not spill into the next grid row, which may be written by another thread
+        if (full_rows && grid_offset % MAP_RING_GRID_SIZE + STAMP_ROW <= MAP_RING_GRID_SIZE) {
+            add_full_row(&grid->grid[grid_offset], &stamp->add[stamp_index], &stamp->written[stamp_index]);
+        } else {
+            add_row(&grid->grid[grid_offset], &stamp->add[stamp_index], &stamp->written[stamp_index],
+                x_max - x_min + 1);
+        }
+    }
+    for (int i = 0; i < stamp->num_repeats; i++) {
+        int tile_x = x + stamp->repeats[i].x;
+        int tile_y = y + stamp->repeats[i].y;
+        if (is_inside_area(area, tile_x, tile_y)) {
+            char *tile = &grid->grid[grid->start_offset + tile_y * MAP_RING_GRID_SIZE + tile_x];
+            *tile = clamp_desirability(*tile + stamp->repeats[i].add);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef MAP_RING_H
+#define MAP_RING_H
+
+/**
+ * @file
+ * Distance rings around tiles and buildings, and desirability spread over them.
+ *
+ * Ring d of a building of size s is the square outline at distance d from the
+ * building. The tables reproduce the original game, including its quirk for
+ * size 4 at distance 2.
+ */
+
+// follows the GRID_SIZE build option of the game grids
+#ifdef GRID_SIZE
+#define MAP_RING_GRID_SIZE GRID_SIZE
+#else
+#define MAP_RING_GRID_SIZE 162
+#endif
+#define MAP_RING_MAX_SIZE 5
+#define MAP_RING_MAX_DISTANCE 6
+
+/**
+ * Tile of a ring, relative to the top-left tile of the building
+ */
+typedef struct {
+    int x;
+    int y;
+    int grid_offset;
+} ring_tile;
+
+/**
+ * Grid that desirability is written to
+ */
+typedef struct {
+    char *grid; /**< Grid of MAP_RING_GRID_SIZE x MAP_RING_GRID_SIZE tiles */
+    int start_offset; /**< Grid offset of map tile (0, 0) */
+    int width; /**< Map width */
+    int height; /**< Map height */
+} map_ring_grid;
+
+/**
+ * Rectangle of map tiles, inclusive
+ */
+typedef struct {
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} map_ring_area;
+
+/**
+ * Desirability of a building or tile, as in the building model
+ */
+typedef struct {
+    int size; /**< Building size, 1 to MAP_RING_MAX_SIZE */
+    int value; /**< Value at distance 1 */
+    int step; /**< Number of rings with the same value */
+    int step_size; /**< Change of the value after each step */
+    int range; /**< Number of rings, capped at MAP_RING_MAX_DISTANCE */
+} map_ring_desirability;
+
+/**
+ * Builds the ring tables, must be called before any other function
+ */
+void map_ring_init();
+
+/**
+ * Gets the first ring tile index of a ring
+ * @param size Building size
+ * @param distance Ring distance, 1 to MAP_RING_MAX_DISTANCE
+ * @return Index for map_ring_tile()
+ */
+int map_ring_start(int size, int distance);
+
+/**
+ * Gets the ring tile index after the last tile of a ring
+ * @param size Building size
+ * @param distance Ring distance, 1 to MAP_RING_MAX_DISTANCE
+ * @return Index for map_ring_tile()
+ */
+int map_ring_end(int size, int distance);
+
+/**
+ * Gets a ring tile
+ * @param index Index between map_ring_start() and map_ring_end()
+ * @return Ring tile
+ */
+const ring_tile *map_ring_tile(int index);
+
+/**
+ * Adds desirability around a building, one ring at a time. Rings inside the map
+ * clamp every tile to -100..100; rings partially outside it add without clamping
+ * and clamp the building tile instead, as the original game does.
+ * @param grid Grid to write to
+ * @param x X of the top-left building tile
+ * @param y Y of the top-left building tile
+ * @param desirability Desirability of the building
+ * @param area Only tiles in this area are written, 0 for the whole grid
+ */
+void map_ring_add_desirability_per_ring(const map_ring_grid *grid, int x, int y,
+    const map_ring_desirability *desirability, const map_ring_area *area);
+
+/**
+ * Adds desirability around a building with the same result as
+ * map_ring_add_desirability_per_ring(). Buildings whose rings are inside the map
+ * use a cached stamp of all rings that is applied in row spans.
+ * Threads may call this at the same time when their areas have no grid row in common.
+ * @param grid Grid to write to
+ * @param x X of the top-left building tile
+ * @param y Y of the top-left building tile
+ * @param desirability Desirability of the building
+ * @param area Only tiles in this area are written, 0 for the whole grid
+ */
+void map_ring_add_desirability(const map_ring_grid *grid, int x, int y,
+    const map_ring_desirability *desirability, const map_ring_area *area);
+
+#endif // MAP_RING_H
@@ -0,0 +1,12 @@
+#include "route_limit.h"
+
+int map_route_limit_tiles_before(int distance)
+{
+    int steps = distance - 1;
+    if (steps <= 0) {
+        return 0;
+    }
+    // a diamond of radius steps - 1, and the ring of 4 * steps tiles around it
+    int radius = steps - 1;
+    return 2 * radius * radius + 2 * radius + 1 + 4 * steps;
+}
@@ -0,0 +1,22 @@
+#ifndef MAP_ROUTE_LIMIT_H
+#define MAP_ROUTE_LIMIT_H
+
+/**
+ * @file
+ * Tile limit of the routing flood fill.
+ *
+ * Routes with a tile limit give up after the flood fill has taken that many
+ * tiles from its queue. A faster search may only replace the flood fill when
+ * the flood fill is certain to reach the destination within the limit.
+ */
+
+/**
+ * Gets the most tiles the 4-way flood fill takes from its queue before the
+ * destination: all tiles with fewer steps, on open terrain, plus the tiles
+ * with the same number of steps queued before the destination.
+ * @param distance Routing distance of the destination: 1 + number of steps
+ * @return Number of tiles
+ */
+int map_route_limit_tiles_before(int distance);
+
+#endif // MAP_ROUTE_LIMIT_H
@@ -0,0 +1,114 @@
+#include "loki/loki.h"
+#include "building/index.h"
+
+void setup()
+{
+    building_index_clear();
+}
+
+INIT_MOCKS(
+    SETUP(setup)
+)
+
+void test_building_index_sorted_by_id()
+{
+    building_index_add(7, BUILDING_WAREHOUSE);
+    building_index_add(3, BUILDING_WAREHOUSE);
+    building_index_add(5, BUILDING_GRANARY);
+    building_index_add(4, BUILDING_WAREHOUSE);
+
+    assert_eq(3, building_index_count(BUILDING_WAREHOUSE));
+    assert_eq(3, building_index_first(BUILDING_WAREHOUSE));
+    assert_eq(4, building_index_next(3));
+    assert_eq(7, building_index_next(4));
+    assert_eq(0, building_index_next(7));
+    assert_eq(5, building_index_first(BUILDING_GRANARY));
+    assert_eq(0, building_index_next(5));
+}
+
+void test_building_index_for_each()
+{
+    building_index_add(10, BUILDING_WELL);
+    building_index_add(2, BUILDING_WELL);
+    building_index_add(6, BUILDING_FOUNTAIN);
+
+    int ids[3];
+    int count = 0;
+    FOR_EACH_BUILDING_OF_TYPE(id, BUILDING_WELL) {
+        ids[count++] = id;
+    }
+    assert_eq(2, count);
+    assert_eq(2, ids[0]);
+    assert_eq(10, ids[1]);
+
+    count = 0;
+    FOR_EACH_INDEXED_BUILDING(id) {
+        ids[count++] = id;
+    }
+    assert_eq(3, count);
+    assert_eq(2, ids[0]);
+    assert_eq(6, ids[1]);
+    assert_eq(10, ids[2]);
+}
+
+void test_building_index_remove()
+{
+    building_index_add(1, BUILDING_WAREHOUSE);
+    building_index_add(2, BUILDING_WAREHOUSE);
+    building_index_add(3, BUILDING_WAREHOUSE);
+    building_index_remove(2);
+    building_index_remove(2);
+    building_index_remove(3);
+
+    assert_false(building_index_contains(2));
+    assert_eq(1, building_index_count(BUILDING_WAREHOUSE));
+    assert_eq(0, building_index_next(1));
+    assert_eq(1, building_index_first_of_any_type());
+    assert_eq(0, building_index_next_of_any_type(1));
+}
+
+void test_building_index_change_type()
+{
+    building_index_add(4, BUILDING_HOUSE_SMALL_TENT);
+    building_index_add(8, BUILDING_HOUSE_LARGE_TENT);
+    building_index_add(4, BUILDING_HOUSE_LARGE_TENT);
+
+    assert_eq(0, building_index_count(BUILDING_HOUSE_SMALL_TENT));
+    assert_eq(2, building_index_count(BUILDING_HOUSE_LARGE_TENT));
+    assert_eq(4, building_index_first(BUILDING_HOUSE_LARGE_TENT));
+    assert_eq(8, building_index_next(4));
+    assert_eq(8, building_index_next_of_any_type(4));
+}
+
+void test_building_index_find_next()
+{
+    building_index_add(3, BUILDING_WAREHOUSE);
+    building_index_add(9, BUILDING_WAREHOUSE);
+    building_index_add(5, BUILDING_GRANARY);
+
+    assert_eq(3, building_index_find_next(BUILDING_WAREHOUSE, 0));
+    assert_eq(9, building_index_find_next(BUILDING_WAREHOUSE, 3));
+    assert_eq(9, building_index_find_next(BUILDING_WAREHOUSE, 5));
+    assert_eq(0, building_index_find_next(BUILDING_WAREHOUSE, 9));
+    assert_eq(0, building_index_find_next(BUILDING_GRANARY, 5));
+}
+
+void test_building_index_invalid()
+{
+    building_index_add(0, BUILDING_WAREHOUSE);
+    building_index_add(BUILDING_INDEX_MAX_BUILDINGS, BUILDING_WAREHOUSE);
+    building_index_add(1, BUILDING_TYPE_MAX);
+
+    assert_eq(0, building_index_first_of_any_type());
+    assert_eq(0, building_index_count(BUILDING_TYPE_MAX));
+    assert_eq(0, building_index_next(BUILDING_INDEX_MAX_BUILDINGS));
+}
+
+RUN_TESTS(building.index,
+    ADD_TEST(test_building_index_sorted_by_id)
+    ADD_TEST(test_building_index_for_each)
+    ADD_TEST(test_building_index_remove)
+    ADD_TEST(test_building_index_change_type)
+    ADD_TEST(test_building_index_find_next)
+    ADD_TEST(test_building_index_invalid)
+)
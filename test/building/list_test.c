@@ -55,13 +55,13 @@ void test_building_list_large_add()
 
 void test_building_list_large_add_too_many()
 {
-    for (int i = 0; i < 2010; i++) {
+    for (int i = 0; i < 8010; i++) {
         building_list_large_add(i);
     }
     
-    assert_eq(2000, building_list_large_size());
+    assert_eq(8000, building_list_large_size());
     const int *items = building_list_large_items();
-    assert_eq(1999, items[1999]);
+    assert_eq(7999, items[7999]);
 }
 
 void test_building_list_large_clear()
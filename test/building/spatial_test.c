@@ -0,0 +1,134 @@
+#include "loki/loki.h"
+#include "building/spatial.h"
+
+static struct {
+    int x;
+    int y;
+    int skip;
+} positions[BUILDING_SPATIAL_MAX_BUILDINGS];
+
+static int query_x;
+static int query_y;
+
+void setup()
+{
+    building_spatial_clear();
+}
+
+INIT_MOCKS(
+    SETUP(setup)
+)
+
+static void add(int building_id, building_type type, int x, int y)
+{
+    positions[building_id].x = x;
+    positions[building_id].y = y;
+    positions[building_id].skip = 0;
+    building_spatial_update(building_id, type, x, y);
+}
+
+static int distance(int building_id, void *data)
+{
+    if (positions[building_id].skip) {
+        return -1;
+    }
+    int dx = positions[building_id].x - query_x;
+    int dy = positions[building_id].y - query_y;
+    dx = dx < 0 ? -dx : dx;
+    dy = dy < 0 ? -dy : dy;
+    return dx > dy ? dx : dy;
+}
+
+static int find(building_type first, building_type last, int x, int y, int max_distance)
+{
+    query_x = x;
+    query_y = y;
+    return building_spatial_find_nearest(first, last, x, y, max_distance, distance, 0);
+}
+
+void test_building_spatial_nearest()
+{
+    add(1, BUILDING_GRANARY, 10, 10);
+    add(2, BUILDING_GRANARY, 100, 100);
+    add(3, BUILDING_WAREHOUSE, 50, 50);
+
+    assert_eq(1, find(BUILDING_GRANARY, BUILDING_GRANARY, 40, 40, 10000));
+    assert_eq(2, find(BUILDING_GRANARY, BUILDING_GRANARY, 80, 80, 10000));
+    assert_eq(3, find(BUILDING_GRANARY, BUILDING_WAREHOUSE, 45, 45, 10000));
+    assert_eq(0, find(BUILDING_WELL, BUILDING_WELL, 45, 45, 10000));
+}
+
+void test_building_spatial_ties_go_to_lowest_id()
+{
+    add(7, BUILDING_WELL, 30, 20);
+    add(4, BUILDING_WELL, 10, 20);
+    add(9, BUILDING_WELL, 20, 30);
+
+    assert_eq(4, find(BUILDING_WELL, BUILDING_WELL, 20, 20, 10000));
+}
+
+void test_building_spatial_max_distance()
+{
+    add(1, BUILDING_FOUNTAIN, 0, 0);
+
+    assert_eq(0, find(BUILDING_FOUNTAIN, BUILDING_FOUNTAIN, 20, 0, 20));
+    assert_eq(1, find(BUILDING_FOUNTAIN, BUILDING_FOUNTAIN, 20, 0, 21));
+}
+
+void test_building_spatial_filter()
+{
+    add(1, BUILDING_MARKET, 10, 10);
+    add(2, BUILDING_MARKET, 150, 150);
+    positions[1].skip = 1;
+
+    assert_eq(2, find(BUILDING_MARKET, BUILDING_MARKET, 10, 10, 10000));
+}
+
+void test_building_spatial_move_and_remove()
+{
+    add(1, BUILDING_HOUSE_SMALL_TENT, 10, 10);
+    add(2, BUILDING_HOUSE_SMALL_TENT, 20, 20);
+    add(1, BUILDING_HOUSE_LARGE_TENT, 140, 140);
+
+    assert_eq(2, find(BUILDING_HOUSE_SMALL_TENT, BUILDING_HOUSE_LARGE_TENT, 0, 0, 10000));
+    assert_eq(1, find(BUILDING_HOUSE_LARGE_TENT, BUILDING_HOUSE_LARGE_TENT, 0, 0, 10000));
+
+    building_spatial_remove(2);
+    building_spatial_remove(2);
+    assert_eq(1, find(BUILDING_HOUSE_SMALL_TENT, BUILDING_HOUSE_LARGE_TENT, 0, 0, 10000));
+}
+
+void test_building_spatial_k_nearest()
+{
+    int ids[4];
+    add(5, BUILDING_WELL, 12, 10);
+    add(6, BUILDING_WELL, 30, 10);
+    add(2, BUILDING_WELL, 8, 10);
+    add(3, BUILDING_WELL, 100, 10);
+
+    query_x = 10;
+    query_y = 10;
+    assert_eq(3, building_spatial_find_k_nearest(BUILDING_WELL, BUILDING_WELL, 10, 10, 50, distance, 0, 4, ids));
+    assert_eq(2, ids[0]);
+    assert_eq(5, ids[1]);
+    assert_eq(6, ids[2]);
+}
+
+void test_building_spatial_outside_map()
+{
+    add(1, BUILDING_GRANARY, 0, 0);
+    add(2, BUILDING_GRANARY, 161, 161);
+
+    assert_eq(1, find(BUILDING_GRANARY, BUILDING_GRANARY, -1, -1, 10000));
+    assert_eq(2, find(BUILDING_GRANARY, BUILDING_GRANARY, 170, 170, 10000));
+}
+
+RUN_TESTS(building.spatial,
+    ADD_TEST(test_building_spatial_nearest)
+    ADD_TEST(test_building_spatial_ties_go_to_lowest_id)
+    ADD_TEST(test_building_spatial_max_distance)
+    ADD_TEST(test_building_spatial_filter)
+    ADD_TEST(test_building_spatial_move_and_remove)
+    ADD_TEST(test_building_spatial_k_nearest)
+    ADD_TEST(test_building_spatial_outside_map)
+)
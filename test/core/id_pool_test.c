@@ -0,0 +1,118 @@
+#include "loki/loki.h"
+
+#include "core/id_pool.h"
+
+#include <stdlib.h>
+
+NO_MOCKS()
+
+static id_pool pool;
+
+void test_id_pool_init()
+{
+    id_pool_init(&pool, 100);
+
+    assert_eq(99, id_pool_num_free(&pool));
+    assert_eq(1, id_pool_first_free(&pool));
+    assert_false(id_pool_is_free(&pool, 0));
+    assert_false(id_pool_is_free(&pool, 100));
+}
+
+void test_id_pool_lowest_free_first()
+{
+    id_pool_init(&pool, 200);
+    for (int id = 1; id < 150; id++) {
+        id_pool_set_used(&pool, id);
+    }
+    id_pool_set_free(&pool, 70);
+    id_pool_set_free(&pool, 3);
+
+    assert_eq(3, id_pool_first_free(&pool));
+    assert_eq(70, id_pool_next_free(&pool, 3));
+    assert_eq(150, id_pool_next_free(&pool, 70));
+    assert_eq(52, id_pool_num_free(&pool));
+}
+
+void test_id_pool_full()
+{
+    id_pool_init(&pool, 65);
+    for (int id = 1; id < 65; id++) {
+        id_pool_set_used(&pool, id);
+    }
+
+    assert_eq(0, id_pool_first_free(&pool));
+    assert_eq(0, id_pool_num_free(&pool));
+}
+
+void test_id_pool_resize()
+{
+    id_pool_init(&pool, 64);
+    for (int id = 1; id < 64; id++) {
+        id_pool_set_used(&pool, id);
+    }
+    id_pool_resize(&pool, 200);
+
+    assert_eq(64, id_pool_first_free(&pool));
+    assert_eq(136, id_pool_num_free(&pool));
+    assert_false(id_pool_is_free(&pool, 200));
+
+    id_pool_resize(&pool, ID_POOL_MAX_IDS + 1);
+    assert_eq(ID_POOL_MAX_IDS - 64, id_pool_num_free(&pool));
+}
+
+void test_id_pool_repeated_changes_counted_once()
+{
+    id_pool_init(&pool, 10);
+    id_pool_set_used(&pool, 4);
+    id_pool_set_used(&pool, 4);
+    id_pool_set_free(&pool, 5);
+    id_pool_set_used(&pool, 0);
+    id_pool_set_used(&pool, 10);
+
+    assert_eq(8, id_pool_num_free(&pool));
+}
+
+void test_id_pool_matches_linear_scan()
+{
+    static char used[ID_POOL_MAX_IDS];
+    int size = 2000;
+    id_pool_init(&pool, size);
+    for (int i = 0; i < size; i++) {
+        used[i] = i == 0;
+    }
+    srand(19);
+    for (int step = 0; step < 20000; step++) {
+        int id = rand() % size;
+        if (rand() % 3) {
+            int expected = 0;
+            for (int i = 1; i < size; i++) {
+                if (!used[i]) {
+                    expected = i;
+                    break;
+                }
+            }
+            assert_eq(expected, id_pool_first_free(&pool));
+            if (expected) {
+                id_pool_set_used(&pool, expected);
+                used[expected] = 1;
+            }
+        } else if (id) {
+            id_pool_set_free(&pool, id);
+            used[id] = 0;
+        }
+    }
+    int num_free = 0;
+    for (int i = 1; i < size; i++) {
+        num_free += !used[i];
+    }
+    assert_eq(num_free, id_pool_num_free(&pool));
+}
+
+RUN_TESTS(core/id_pool,
+    ADD_TEST(test_id_pool_init)
+    ADD_TEST(test_id_pool_lowest_free_first)
+    ADD_TEST(test_id_pool_full)
+    ADD_TEST(test_id_pool_resize)
+    ADD_TEST(test_id_pool_repeated_changes_counted_once)
+    ADD_TEST(test_id_pool_matches_linear_scan)
+)
@@ -0,0 +1,281 @@
+#include "loki/loki.h"
+#include "core/jobs.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#define NUM_WORKERS 4
+#define NUM_VALUES 100000
+
+static int counts[NUM_VALUES];
+
+void setup()
+{
+    jobs_stop();
+    jobs_scratch_reset();
+}
+
+INIT_MOCKS(
+    SETUP(setup)
+)
+
+static void count_range(int begin, int end, void *data)
+{
+    for (int i = begin; i < end; i++) {
+        counts[i]++;
+    }
+}
+
+static void set_worker(void *data)
+{
+    *(int *) data = jobs_current_worker() + 100;
+}
+
+static double value(int index, void *data)
+{
+    // values of very different magnitude, so the order of the additions matters
+    return index % 7 ? 1.0 / (index + 1) : 1e12 / (index + 1);
+}
+
+void test_jobs_run_inline_when_not_started()
+{
+    int worker = 0;
+    job_group group;
+    job_group_init(&group);
+
+    jobs_spawn(&group, set_worker, &worker);
+
+    assert_eq(100, worker);
+    assert_eq(0, group.pending);
+    jobs_wait(&group);
+    assert_eq(0, jobs_num_workers());
+}
+
+void test_jobs_start_and_stop()
+{
+    assert_eq(NUM_WORKERS, jobs_start(NUM_WORKERS));
+    assert_eq(NUM_WORKERS, jobs_start(2));
+    assert_eq(NUM_WORKERS, jobs_num_workers());
+    assert_eq(0, jobs_current_worker());
+
+    jobs_stop();
+    assert_eq(0, jobs_num_workers());
+    assert_eq(2, jobs_start(2));
+}
+
+void test_jobs_spawn_runs_on_workers()
+{
+    int workers[64];
+    job_group group;
+    jobs_start(NUM_WORKERS);
+    job_group_init(&group);
+
+    for (int i = 0; i < 64; i++) {
+        workers[i] = 0;
+        jobs_spawn(&group, set_worker, &workers[i]);
+    }
+    jobs_wait(&group);
+
+    assert_eq(0, group.pending);
+    for (int i = 0; i < 64; i++) {
+        assert_true(workers[i] >= 101 && workers[i] <= 100 + NUM_WORKERS);
+    }
+}
+
+void test_jobs_parallel_for_covers_range_once()
+{
+    memset(counts, 0, sizeof(counts));
+    jobs_start(NUM_WORKERS);
+
+    jobs_parallel_for(10, NUM_VALUES - 5, 37, count_range, 0);
+
+    for (int i = 0; i < NUM_VALUES; i++) {
+        assert_eq(i >= 10 && i < NUM_VALUES - 5 ? 1 : 0, counts[i]);
+    }
+    jobs_parallel_for(5, 5, 10, count_range, 0);
+    assert_eq(0, counts[5]);
+}
+
+typedef struct {
+    int n;
+    int result;
+} fib_job;
+
+static void fib(void *data)
+{
+    fib_job *f = (fib_job *) data;
+    if (f->n < 2) {
+        f->result = f->n;
+        return;
+    }
+    fib_job a = { f->n - 1, 0 };
+    fib_job b = { f->n - 2, 0 };
+    job_group group;
+    job_group_init(&group);
+    jobs_spawn(&group, fib, &a);
+    fib(&b);
+    jobs_wait(&group);
+    f->result = a.result + b.result;
+}
+
+void test_jobs_nested_fork_join()
+{
+    fib_job f = { 20, 0 };
+    fib(&f);
+    assert_eq(6765, f.result);
+
+    jobs_start(NUM_WORKERS);
+    f.result = 0;
+    fib(&f);
+    assert_eq(6765, f.result);
+}
+
+void test_jobs_parallel_sum_is_deterministic()
+{
+    double expected = 0;
+    for (int begin = 0; begin < NUM_VALUES; begin += 1000) {
+        double partial = 0;
+        for (int i = begin; i < begin + 1000 && i < NUM_VALUES; i++) {
+            partial += value(i, 0);
+        }
+        expected += partial;
+    }
+
+    double serial = jobs_parallel_sum(0, NUM_VALUES, 1000, value, 0);
+    jobs_start(NUM_WORKERS);
+    for (int run = 0; run < 20; run++) {
+        double parallel = jobs_parallel_sum(0, NUM_VALUES, 1000, value, 0);
+        assert_true(memcmp(&expected, &parallel, sizeof(double)) == 0);
+    }
+    assert_true(memcmp(&expected, &serial, sizeof(double)) == 0);
+}
+
+typedef struct {
+    int num_ranges;
+    int range_begins[16];
+} range_list;
+
+static void list_range(int begin, int end, void *partial, void *data)
+{
+    range_list *list = (range_list *) partial;
+    list->range_begins[list->num_ranges++] = begin;
+}
+
+static void append_ranges(void *result, const void *partial, void *data)
+{
+    range_list *list = (range_list *) result;
+    const range_list *other = (const range_list *) partial;
+    for (int i = 0; i < other->num_ranges; i++) {
+        list->range_begins[list->num_ranges++] = other->range_begins[i];
+    }
+}
+
+void test_jobs_parallel_reduce_combines_in_order()
+{
+    range_list list = { 0, {0} };
+    jobs_start(NUM_WORKERS);
+
+    assert_true(jobs_parallel_reduce(3, 100, 10, list_range, append_ranges, &list, sizeof(list), 0));
+
+    assert_eq(10, list.num_ranges);
+    for (int i = 0; i < 10; i++) {
+        assert_eq(3 + 10 * i, list.range_begins[i]);
+    }
+}
+
+static void use_scratch(void *data)
+{
+    void **memory = (void **) data;
+    memory[0] = jobs_scratch_alloc(100);
+    memory[1] = jobs_scratch_alloc(100);
+}
+
+void test_jobs_scratch_arena()
+{
+    void *memory[2];
+    void *first = jobs_scratch_alloc(10);
+    assert_true(first != 0);
+    assert_eq(0, (int) ((uintptr_t) first % 16));
+
+    job_group group;
+    job_group_init(&group);
+    jobs_spawn(&group, use_scratch, memory);
+    assert_eq(16, (int) ((char *) memory[0] - (char *) first));
+    assert_eq(112, (int) ((char *) memory[1] - (char *) memory[0]));
+    // memory allocated by the job is freed when it returns
+    assert_true(jobs_scratch_alloc(1) == memory[0]);
+
+    assert_true(jobs_scratch_alloc(JOBS_SCRATCH_SIZE) == 0);
+    jobs_scratch_reset();
+    assert_true(jobs_scratch_alloc(JOBS_SCRATCH_SIZE) == first);
+    jobs_scratch_reset();
+
+    jobs_start(NUM_WORKERS);
+    jobs_spawn(&group, use_scratch, memory);
+    jobs_wait(&group);
+    assert_true(memory[0] != 0);
+    assert_true(memory[0] != first);
+}
+
+static uint64_t now_micros()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000;
+}
+
+static void empty_job(void *data)
+{
+}
+
+static double work(int index, void *data)
+{
+    double x = index;
+    for (int i = 0; i < 200; i++) {
+        x = x * 0.999 + 1.0 / (i + 1);
+    }
+    return x;
+}
+
+void test_jobs_benchmark()
+{
+    const int num_jobs = 100000;
+    const int num_items = 200000;
+    double serial_sum = jobs_parallel_sum(0, num_items, 256, work, 0);
+
+    uint64_t start = now_micros();
+    double serial_check = jobs_parallel_sum(0, num_items, 256, work, 0);
+    uint64_t serial = now_micros() - start;
+
+    int num_workers = jobs_start(0);
+    start = now_micros();
+    job_group group;
+    job_group_init(&group);
+    for (int i = 0; i < num_jobs; i++) {
+        jobs_spawn(&group, empty_job, 0);
+    }
+    jobs_wait(&group);
+    uint64_t spawn = now_micros() - start;
+
+    start = now_micros();
+    double parallel_sum = jobs_parallel_sum(0, num_items, 256, work, 0);
+    uint64_t parallel = now_micros() - start;
+
+    printf("jobs: %d workers, %d empty jobs in %d us (%d jobs/ms), sum of %d items: serial %d us, parallel %d us\n",
+           num_workers, num_jobs, (int) spawn, (int) (num_jobs * 1000LL / (spawn + 1)),
+           num_items, (int) serial, (int) parallel);
+    assert_true(memcmp(&serial_sum, &serial_check, sizeof(double)) == 0);
+    assert_true(memcmp(&serial_sum, &parallel_sum, sizeof(double)) == 0);
+}
+
+RUN_TESTS(core/jobs,
+    ADD_TEST(test_jobs_run_inline_when_not_started)
+    ADD_TEST(test_jobs_start_and_stop)
+    ADD_TEST(test_jobs_spawn_runs_on_workers)
+    ADD_TEST(test_jobs_parallel_for_covers_range_once)
+    ADD_TEST(test_jobs_nested_fork_join)
+    ADD_TEST(test_jobs_parallel_sum_is_deterministic)
+    ADD_TEST(test_jobs_parallel_reduce_combines_in_order)
+    ADD_TEST(test_jobs_scratch_arena)
+    ADD_TEST(test_jobs_benchmark)
+)
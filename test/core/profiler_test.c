@@ -0,0 +1,107 @@
+#include "loki/loki.h"
+
+#include "core/profiler.h"
+
+#include <stdio.h>
+
+NO_MOCKS()
+
+void test_profiler_disabled_records_nothing()
+{
+    profiler_finish();
+    uint64_t start = profiler_start();
+    profiler_stop(1, start);
+
+    assert_eq(0, start);
+    assert_eq(0, profiler_get_section(1)->count);
+}
+
+void test_profiler_min_mean_max()
+{
+    profiler_enable(0);
+    profiler_record(2, 3000);
+    profiler_record(2, 1000);
+    profiler_record(2, 8000);
+
+    const profiler_section *s = profiler_get_section(2);
+    assert_eq(3, s->count);
+    assert_eq(1000, s->min_nanos);
+    assert_eq(8000, s->max_nanos);
+    assert_eq(12000, s->total_nanos);
+}
+
+void test_profiler_histogram_buckets()
+{
+    profiler_enable(0);
+    profiler_record(3, 500); // < 1us
+    profiler_record(3, 1500); // < 2us
+    profiler_record(3, 3000); // < 4us
+    profiler_record(3, 3999); // < 4us
+    profiler_record(3, 1000000000); // overflow
+
+    const profiler_section *s = profiler_get_section(3);
+    assert_eq(1, s->histogram[0]);
+    assert_eq(1, s->histogram[1]);
+    assert_eq(2, s->histogram[2]);
+    assert_eq(1, s->histogram[PROFILER_HISTOGRAM_BUCKETS - 1]);
+}
+
+void test_profiler_enable_resets_stats_keeps_names()
+{
+    profiler_set_name(4, "section");
+    profiler_enable(0);
+    profiler_record(4, 100);
+    profiler_enable(0);
+
+    assert_eq(0, profiler_get_section(4)->count);
+    assert_eq_string("section", profiler_get_section(4)->name);
+}
+
+void test_profiler_start_stop()
+{
+    profiler_enable(0);
+    uint64_t start = profiler_start();
+    profiler_stop(5, start);
+
+    assert_true(start != 0);
+    assert_eq(1, profiler_get_section(5)->count);
+}
+
+void test_profiler_invalid_section()
+{
+    profiler_enable(0);
+    profiler_record(-1, 100);
+    profiler_record(PROFILER_MAX_SECTIONS, 100);
+
+    assert_true(profiler_get_section(PROFILER_MAX_SECTIONS) == 0);
+}
+
+void test_profiler_write_csv()
+{
+    char line[1000];
+    profiler_set_name(6, "slot");
+    profiler_enable("profiler_test.csv");
+    profiler_record(6, 2000);
+    profiler_finish();
+
+    FILE *fp = fopen("profiler_test.csv", "r");
+    assert_true(fp != 0);
+    assert_true(fgets(line, 1000, fp) != 0);
+    assert_true(fgets(line, 1000, fp) != 0);
+    fclose(fp);
+    remove("profiler_test.csv");
+
+    line[39] = 0;
+    assert_eq_string("6,slot,1,2.000,2.000,2.000,2.000,0,0,1,", line);
+    assert_false(profiler_enabled());
+}
+
+RUN_TESTS(core/profiler,
+    ADD_TEST(test_profiler_disabled_records_nothing)
+    ADD_TEST(test_profiler_min_mean_max)
+    ADD_TEST(test_profiler_histogram_buckets)
+    ADD_TEST(test_profiler_enable_resets_stats_keeps_names)
+    ADD_TEST(test_profiler_start_stop)
+    ADD_TEST(test_profiler_invalid_section)
+    ADD_TEST(test_profiler_write_csv)
+)
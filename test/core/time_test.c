@@ -10,6 +10,16 @@ void test_time_set_correctly()
     assert_eq_u(123456, time_get_millis());
 }
 
+void test_time_wall_clock_is_independent()
+{
+    time_set_millis(0);
+    time_millis first = time_get_wall_millis();
+    time_millis second = time_get_wall_millis();
+    assert_true(second - first < 1000);
+    assert_eq_u(0, time_get_millis());
+}
+
 RUN_TESTS(time,
     ADD_TEST(test_time_set_correctly)
+    ADD_TEST(test_time_wall_clock_is_independent)
 )
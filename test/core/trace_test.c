@@ -0,0 +1,147 @@
+#include "loki/loki.h"
+
+#include "core/trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+NO_MOCKS()
+
+static trace_event events[TRACE_BUFFER_SIZE];
+
+void test_trace_default_level_records_errors_only()
+{
+    trace_finish();
+    TRACE_INFO(TRACE_EVENT_TICK, 1, 2, 3, 0);
+    TRACE_ERROR(TRACE_EVENT_IMAGE_NOT_ISOMETRIC, 42, 0, 0, 0);
+
+    assert_eq(TRACE_LEVEL_ERROR, trace_get_level());
+}
+
+void test_trace_level_filter()
+{
+    trace_enable(TRACE_LEVEL_INFO, 0);
+    TRACE_DEBUG(TRACE_EVENT_ROUTE, 1, 2, 3, 4);
+    TRACE_INFO(TRACE_EVENT_TICK, 1, 2, 3, 0);
+    TRACE_ERROR(TRACE_EVENT_IMAGE_NOT_ISOMETRIC, 42, 0, 0, 0);
+
+    assert_eq(2, trace_get_events(events, TRACE_BUFFER_SIZE));
+    assert_eq(TRACE_EVENT_TICK, events[0].type);
+    assert_eq(TRACE_LEVEL_INFO, events[0].level);
+    assert_eq(3, events[0].params[2]);
+    assert_eq(TRACE_EVENT_IMAGE_NOT_ISOMETRIC, events[1].type);
+    assert_eq(42, events[1].params[0]);
+}
+
+static int calls;
+
+static int counted(int value)
+{
+    calls++;
+    return value;
+}
+
+void test_trace_disabled_level_skips_parameters()
+{
+    trace_enable(TRACE_LEVEL_INFO, 0);
+    calls = 0;
+    TRACE_DEBUG(TRACE_EVENT_ROUTE, counted(1), counted(2), 0, 0);
+    assert_eq(0, calls);
+    assert_false(trace_level_enabled(TRACE_LEVEL_DEBUG));
+
+    TRACE_INFO(TRACE_EVENT_TICK, counted(1), 0, 0, 0);
+    assert_eq(1, calls);
+    assert_true(trace_level_enabled(TRACE_LEVEL_INFO));
+}
+
+void test_trace_sequence_numbers()
+{
+    trace_enable(TRACE_LEVEL_DEBUG, 0);
+    TRACE_DEBUG(TRACE_EVENT_ROUTE, 1, 0, 0, 0);
+    TRACE_DEBUG(TRACE_EVENT_ROUTE, 2, 0, 0, 0);
+
+    assert_eq(2, trace_get_events(events, TRACE_BUFFER_SIZE));
+    assert_eq(1, events[0].sequence);
+    assert_eq(2, events[1].sequence);
+    assert_true(events[0].nanos <= events[1].nanos);
+}
+
+void test_trace_ring_keeps_newest_events()
+{
+    trace_enable(TRACE_LEVEL_DEBUG, 0);
+    for (int i = 0; i < TRACE_BUFFER_SIZE + 10; i++) {
+        TRACE_DEBUG(TRACE_EVENT_ROUTE, i, 0, 0, 0);
+    }
+
+    assert_eq(TRACE_BUFFER_SIZE, trace_get_events(events, TRACE_BUFFER_SIZE));
+    assert_eq(10, events[0].params[0]);
+    assert_eq(TRACE_BUFFER_SIZE + 9, events[TRACE_BUFFER_SIZE - 1].params[0]);
+}
+
+void test_trace_get_events_limited()
+{
+    trace_enable(TRACE_LEVEL_DEBUG, 0);
+    for (int i = 0; i < 5; i++) {
+        TRACE_DEBUG(TRACE_EVENT_ROUTE, i, 0, 0, 0);
+    }
+
+    assert_eq(2, trace_get_events(events, 2));
+    assert_eq(3, events[0].params[0]);
+    assert_eq(4, events[1].params[0]);
+}
+
+void test_trace_write_and_read_file()
+{
+    trace_enable(TRACE_LEVEL_DEBUG, "trace_test.trace");
+    TRACE_INFO(TRACE_EVENT_SAVEGAME_WRITE_PIECE, 7, 1200, 1, 0);
+    TRACE_DEBUG(TRACE_EVENT_ROUTE, 5, 100, 200, 12);
+    trace_finish();
+
+    int num_events = trace_read_file("trace_test.trace", events, TRACE_BUFFER_SIZE);
+    remove("trace_test.trace");
+
+    assert_eq(2, num_events);
+    assert_eq(TRACE_EVENT_SAVEGAME_WRITE_PIECE, events[0].type);
+    assert_eq(1200, events[0].params[1]);
+    assert_eq(12, events[1].params[3]);
+    assert_eq(TRACE_LEVEL_ERROR, trace_get_level());
+}
+
+void test_trace_read_invalid_file()
+{
+    assert_eq(-1, trace_read_file("data/input.txt", events, TRACE_BUFFER_SIZE));
+    assert_eq(-1, trace_read_file("does_not_exist.trace", events, TRACE_BUFFER_SIZE));
+}
+
+void test_trace_format_event()
+{
+    char line[200];
+    trace_event event = {3, TRACE_EVENT_TICK, TRACE_LEVEL_INFO, 0, 1500000000, {4, 12, 49, 0}};
+
+    trace_format_event(&event, line, sizeof(line));
+
+    assert_eq_string("3 1.500000 INFO TICK: month 4 day 12 tick 49", line);
+}
+
+void test_trace_format_unknown_event()
+{
+    char line[200];
+    trace_event event = {1, 999, TRACE_LEVEL_DEBUG, 0, 0, {1, 2, 3, 4}};
+
+    trace_format_event(&event, line, sizeof(line));
+
+    assert_eq_string("1 0.000000 DEBUG UNKNOWN: 1 2 3 4", line);
+}
+
+RUN_TESTS(core/trace,
+    ADD_TEST(test_trace_default_level_records_errors_only)
+    ADD_TEST(test_trace_level_filter)
+    ADD_TEST(test_trace_disabled_level_skips_parameters)
+    ADD_TEST(test_trace_sequence_numbers)
+    ADD_TEST(test_trace_ring_keeps_newest_events)
+    ADD_TEST(test_trace_get_events_limited)
+    ADD_TEST(test_trace_write_and_read_file)
+    ADD_TEST(test_trace_read_invalid_file)
+    ADD_TEST(test_trace_format_event)
+    ADD_TEST(test_trace_format_unknown_event)
+)
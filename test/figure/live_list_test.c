@@ -0,0 +1,93 @@
+#include "loki/loki.h"
+
+#include "figure/live_list.h"
+
+NO_MOCKS()
+
+void test_live_list_sorted()
+{
+    figure_live_list_clear();
+    figure_live_list_add(5);
+    figure_live_list_add(2);
+    figure_live_list_add(9);
+    figure_live_list_add(2);
+
+    assert_eq(3, figure_live_list_count());
+    assert_eq(2, figure_live_list_get(0));
+    assert_eq(5, figure_live_list_get(1));
+    assert_eq(9, figure_live_list_get(2));
+    assert_eq(0, figure_live_list_get(3));
+}
+
+void test_live_list_remove()
+{
+    figure_live_list_clear();
+    figure_live_list_add(1);
+    figure_live_list_add(3);
+    figure_live_list_add(7);
+    figure_live_list_remove(3);
+    figure_live_list_remove(4);
+
+    assert_eq(2, figure_live_list_count());
+    assert_true(figure_live_list_contains(1));
+    assert_false(figure_live_list_contains(3));
+    assert_eq(7, figure_live_list_get(1));
+}
+
+void test_live_list_invalid_ids()
+{
+    figure_live_list_clear();
+    figure_live_list_add(0);
+    figure_live_list_add(-1);
+    figure_live_list_add(FIGURE_LIVE_LIST_MAX_FIGURES);
+
+    assert_eq(0, figure_live_list_count());
+    assert_false(figure_live_list_contains(FIGURE_LIVE_LIST_MAX_FIGURES));
+}
+
+void test_live_list_next()
+{
+    figure_live_list_clear();
+    figure_live_list_add(4);
+    figure_live_list_add(8);
+
+    assert_eq(4, figure_live_list_next(0));
+    assert_eq(8, figure_live_list_next(4));
+    assert_eq(8, figure_live_list_next(5));
+    assert_eq(0, figure_live_list_next(8));
+}
+
+void test_live_list_iterate_while_changing()
+{
+    int visited[10];
+    int num_visited = 0;
+    figure_live_list_clear();
+    figure_live_list_add(2);
+    figure_live_list_add(4);
+    figure_live_list_add(6);
+
+    FOR_EACH_LIVE_FIGURE(figure_id) {
+        visited[num_visited++] = figure_id;
+        if (figure_id == 2) {
+            figure_live_list_remove(2);
+            figure_live_list_add(1); // lower ID: not visited in this loop
+            figure_live_list_add(5);
+        } else if (figure_id == 4) {
+            figure_live_list_remove(6);
+        }
+    }
+
+    assert_eq(3, num_visited);
+    assert_eq(2, visited[0]);
+    assert_eq(4, visited[1]);
+    assert_eq(5, visited[2]);
+    assert_eq(3, figure_live_list_count());
+}
+
+RUN_TESTS(figure/live_list,
+    ADD_TEST(test_live_list_sorted)
+    ADD_TEST(test_live_list_remove)
+    ADD_TEST(test_live_list_invalid_ids)
+    ADD_TEST(test_live_list_next)
+    ADD_TEST(test_live_list_iterate_while_changing)
+)
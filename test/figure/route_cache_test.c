@@ -0,0 +1,107 @@
+#include "loki/loki.h"
+
+#include "figure/route_cache.h"
+
+NO_MOCKS()
+
+static route_cache_key key(int source, int destination)
+{
+    route_cache_key k = {source, destination, 0, 0};
+    return k;
+}
+
+static void add(int source, int destination, int length, int version)
+{
+    route_cache_key k = key(source, destination);
+    route_cache_path *path = route_cache_add(&k, version);
+    path->length = length;
+    path->directions[0] = (unsigned char) length;
+}
+
+static int get_length(int source, int destination, int version)
+{
+    route_cache_key k = key(source, destination);
+    const route_cache_path *path = route_cache_get(&k, version);
+    return path ? path->length : -1;
+}
+
+void test_route_cache_miss()
+{
+    route_cache_clear();
+    add(1, 2, 10, 1);
+
+    assert_eq(-1, get_length(2, 1, 1));
+    assert_eq(-1, get_length(1, 3, 1));
+}
+
+void test_route_cache_hit()
+{
+    route_cache_clear();
+    add(1, 2, 10, 1);
+    add(1, 3, 0, 1);
+
+    route_cache_key k = key(1, 2);
+    const route_cache_path *path = route_cache_get(&k, 1);
+    assert_true(path != 0);
+    assert_eq(10, path->length);
+    assert_eq(10, path->directions[0]);
+    assert_eq(0, get_length(1, 3, 1));
+}
+
+void test_route_cache_key_fields()
+{
+    route_cache_clear();
+    route_cache_key k = {1, 2, 3, 4};
+    route_cache_add(&k, 1)->length = 5;
+
+    route_cache_key other_usage = {1, 2, 0, 4};
+    route_cache_key other_building = {1, 2, 3, 0};
+    assert_true(route_cache_get(&other_usage, 1) == 0);
+    assert_true(route_cache_get(&other_building, 1) == 0);
+    assert_eq(5, route_cache_get(&k, 1)->length);
+}
+
+void test_route_cache_new_version_clears()
+{
+    route_cache_clear();
+    add(1, 2, 10, 1);
+
+    assert_eq(-1, get_length(1, 2, 2));
+    assert_eq(-1, get_length(1, 2, 1));
+}
+
+void test_route_cache_evicts_least_recently_used()
+{
+    route_cache_clear();
+    for (int i = 0; i < ROUTE_CACHE_SIZE; i++) {
+        add(i, i + 1, i + 1, 1);
+    }
+    assert_eq(1, get_length(0, 1, 1));
+    add(1000, 1001, 7, 1);
+
+    assert_eq(1, get_length(0, 1, 1));
+    assert_eq(-1, get_length(1, 2, 1));
+    assert_eq(3, get_length(2, 3, 1));
+    assert_eq(7, get_length(1000, 1001, 1));
+}
+
+void test_route_cache_eviction_keeps_colliding_entries()
+{
+    route_cache_clear();
+    for (int i = 0; i < 3 * ROUTE_CACHE_SIZE; i++) {
+        add(i % 300, i, i, 1);
+    }
+    for (int i = 2 * ROUTE_CACHE_SIZE; i < 3 * ROUTE_CACHE_SIZE; i++) {
+        assert_eq(i, get_length(i % 300, i, 1));
+    }
+    assert_eq(-1, get_length(0, 0, 1));
+}
+
+RUN_TESTS(figure/route_cache,
+    ADD_TEST(test_route_cache_miss)
+    ADD_TEST(test_route_cache_hit)
+    ADD_TEST(test_route_cache_key_fields)
+    ADD_TEST(test_route_cache_new_version_clears)
+    ADD_TEST(test_route_cache_evicts_least_recently_used)
+    ADD_TEST(test_route_cache_eviction_keeps_colliding_entries)
+)
@@ -0,0 +1,217 @@
+#include "loki/loki.h"
+#include "game/tick_scheduler.h"
+
+NO_MOCKS()
+
+#define MAX_EVENTS 4000
+
+static struct {
+    int tick;
+    char what;
+    int id;
+} events[MAX_EVENTS];
+static int num_events;
+static int current_tick;
+static int num_entities;
+
+static void record(char what, int id)
+{
+    if (num_events < MAX_EVENTS) {
+        events[num_events].tick = current_tick;
+        events[num_events].what = what;
+        events[num_events].id = id;
+        num_events++;
+    }
+}
+
+static void run_a() { record('a', 0); }
+static void run_b() { record('b', 0); }
+static void begin() { record('<', 0); }
+static void update(int id) { record('u', id); }
+static void end() { record('>', 0); }
+static int count() { return num_entities; }
+
+static void update_growing(int id)
+{
+    record('u', id);
+    if (id == 3) {
+        num_entities = 12;
+    }
+}
+
+static void run_ticks(int first_tick, int num_ticks)
+{
+    for (int i = 0; i < num_ticks; i++) {
+        current_tick = (first_tick + i) % TICK_SCHEDULER_TICKS_PER_DAY;
+        tick_scheduler_run(current_tick);
+    }
+}
+
+static void reset(int entities)
+{
+    tick_scheduler_clear();
+    num_events = 0;
+    num_entities = entities;
+}
+
+void test_tick_scheduler_rejects_invalid_tasks()
+{
+    reset(0);
+    tick_task no_function = { "none", 50, 0, 0, 0, 0, 0, 0 };
+    tick_task both = { "both", 50, 0, run_a, 0, update, 0, count };
+    tick_task no_count = { "count", 50, 0, 0, 0, update, 0, 0 };
+    tick_task bad_cadence = { "cadence", 7, 0, run_a, 0, 0, 0, 0 };
+    tick_task valid = { "valid", 25, 3, run_a, 0, 0, 0, 0 };
+
+    assert_eq(-1, tick_scheduler_add(&no_function));
+    assert_eq(-1, tick_scheduler_add(&both));
+    assert_eq(-1, tick_scheduler_add(&no_count));
+    assert_eq(-1, tick_scheduler_add(&bad_cadence));
+    assert_eq(0, tick_scheduler_add(&valid));
+}
+
+void test_tick_scheduler_runs_passes_on_slot()
+{
+    reset(0);
+    tick_task a = { "a", 50, 7, run_a, 0, 0, 0, 0 };
+    tick_task b = { "b", 25, 7, run_b, 0, 0, 0, 0 };
+    tick_task a_again = { "a", 50, 7, run_a, 0, 0, 0, 0 };
+    tick_scheduler_add(&a);
+    tick_scheduler_add(&b);
+    tick_scheduler_add(&a_again);
+
+    run_ticks(0, 50);
+
+    assert_eq(4, num_events);
+    assert_eq('a', events[0].what);
+    assert_eq('b', events[1].what);
+    assert_eq('a', events[2].what);
+    assert_eq(7, events[2].tick);
+    assert_eq('b', events[3].what);
+    assert_eq(32, events[3].tick);
+}
+
+void test_tick_scheduler_compatible_runs_whole_pass()
+{
+    reset(6);
+    tick_task task = { "entities", 50, 10, 0, begin, update, end, count };
+    tick_scheduler_add(&task);
+
+    run_ticks(0, 50);
+
+    assert_eq(7, num_events);
+    assert_eq('<', events[0].what);
+    for (int i = 1; i <= 5; i++) {
+        assert_eq('u', events[i].what);
+        assert_eq(i, events[i].id);
+        assert_eq(10, events[i].tick);
+    }
+    assert_eq('>', events[6].what);
+}
+
+void test_tick_scheduler_spread_splits_pass()
+{
+    reset(101);
+    tick_task task = { "entities", 10, 4, 0, begin, update, end, count };
+    tick_scheduler_add(&task);
+    tick_scheduler_set_mode(TICK_SCHEDULER_SPREAD);
+
+    run_ticks(4, 10);
+
+    assert_eq(102, num_events);
+    assert_eq('<', events[0].what);
+    assert_eq('>', events[101].what);
+    assert_eq(13, events[101].tick);
+    int per_tick[TICK_SCHEDULER_TICKS_PER_DAY] = {0};
+    for (int i = 1; i <= 100; i++) {
+        assert_eq('u', events[i].what);
+        assert_eq(i, events[i].id);
+        per_tick[events[i].tick]++;
+    }
+    for (int tick = 4; tick < 14; tick++) {
+        assert_eq(10, per_tick[tick]);
+    }
+}
+
+void test_tick_scheduler_spread_wraps_around_day()
+{
+    reset(51);
+    tick_task task = { "entities", 50, 49, 0, begin, update, end, count };
+    tick_scheduler_add(&task);
+    tick_scheduler_set_mode(TICK_SCHEDULER_SPREAD);
+
+    run_ticks(0, 99);
+
+    assert_eq(52, num_events);
+    assert_eq(49, events[0].tick);
+    assert_eq(1, events[1].id);
+    assert_eq(49, events[1].tick);
+    assert_eq(50, events[50].id);
+    assert_eq(48, events[50].tick);
+    assert_eq('>', events[51].what);
+}
+
+void test_tick_scheduler_entities_added_during_pass()
+{
+    reset(6);
+    tick_task task = { "entities", 50, 0, 0, 0, update_growing, 0, count };
+    tick_scheduler_add(&task);
+
+    run_ticks(0, 1);
+
+    assert_eq(11, num_events);
+    assert_eq(11, events[10].id);
+}
+
+void test_tick_scheduler_reset_drops_pass()
+{
+    reset(101);
+    tick_task task = { "entities", 10, 0, 0, begin, update, end, count };
+    tick_scheduler_add(&task);
+    tick_scheduler_set_mode(TICK_SCHEDULER_SPREAD);
+
+    run_ticks(0, 5);
+    tick_scheduler_reset();
+    num_events = 0;
+    run_ticks(5, 5);
+    assert_eq(0, num_events);
+
+    run_ticks(10, 10);
+    assert_eq(102, num_events);
+    assert_eq('<', events[0].what);
+    assert_eq(1, events[1].id);
+}
+
+void test_tick_scheduler_spread_matches_compatible_order()
+{
+    reset(23);
+    tick_task task = { "entities", 5, 2, 0, begin, update, end, count };
+    tick_scheduler_add(&task);
+    run_ticks(0, 50);
+    int compatible_events = num_events;
+    char compatible[MAX_EVENTS];
+    for (int i = 0; i < num_events; i++) {
+        compatible[i] = events[i].what;
+    }
+
+    reset(23);
+    tick_scheduler_add(&task);
+    tick_scheduler_set_mode(TICK_SCHEDULER_SPREAD);
+    run_ticks(2, 50);
+
+    assert_eq(compatible_events, num_events);
+    for (int i = 0; i < num_events; i++) {
+        assert_eq(compatible[i], events[i].what);
+    }
+}
+
+RUN_TESTS(game/tick_scheduler,
+    ADD_TEST(test_tick_scheduler_rejects_invalid_tasks)
+    ADD_TEST(test_tick_scheduler_runs_passes_on_slot)
+    ADD_TEST(test_tick_scheduler_compatible_runs_whole_pass)
+    ADD_TEST(test_tick_scheduler_spread_splits_pass)
+    ADD_TEST(test_tick_scheduler_spread_wraps_around_day)
+    ADD_TEST(test_tick_scheduler_entities_added_during_pass)
+    ADD_TEST(test_tick_scheduler_reset_drops_pass)
+    ADD_TEST(test_tick_scheduler_spread_matches_compatible_order)
+)
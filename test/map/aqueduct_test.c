@@ -0,0 +1,291 @@
+#include "loki/loki.h"
+#include "map/aqueduct.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define GRID_TILES (MAP_AQUEDUCT_GRID_SIZE * MAP_AQUEDUCT_GRID_SIZE)
+#define MAP_SIZE 80
+#define MAX_RESERVOIRS 64
+
+static const int ADJACENT[] = { -MAP_AQUEDUCT_GRID_SIZE, 1, MAP_AQUEDUCT_GRID_SIZE, -1 };
+static const int CONNECTORS[] = {
+    1 - MAP_AQUEDUCT_GRID_SIZE, 3 + MAP_AQUEDUCT_GRID_SIZE,
+    1 + 3 * MAP_AQUEDUCT_GRID_SIZE, -1 + MAP_AQUEDUCT_GRID_SIZE
+};
+
+static char pipes[GRID_TILES];
+static int reservoir_at[GRID_TILES];
+static int num_reservoirs;
+static struct {
+    int offset;
+    int in_use;
+    int water; // 0: none, 1: has water, 2: has water, aqueducts not filled yet
+} reservoirs[MAX_RESERVOIRS + 1];
+
+static char reference_water[GRID_TILES];
+static int reference_queue[GRID_TILES];
+
+void setup()
+{
+    memset(pipes, 0, sizeof(pipes));
+    memset(reservoir_at, 0, sizeof(reservoir_at));
+    num_reservoirs = 0;
+    srand(12);
+}
+
+INIT_MOCKS(
+    SETUP(setup)
+)
+
+static int start_offset()
+{
+    return MAP_AQUEDUCT_GRID_SIZE * ((MAP_AQUEDUCT_GRID_SIZE - MAP_SIZE) / 2) + (MAP_AQUEDUCT_GRID_SIZE - MAP_SIZE) / 2;
+}
+
+static int offset(int x, int y)
+{
+    return start_offset() + y * MAP_AQUEDUCT_GRID_SIZE + x;
+}
+
+static int is_corner(int building_id, int grid_offset)
+{
+    int diff = grid_offset - reservoirs[building_id].offset;
+    int dx = diff % MAP_AQUEDUCT_GRID_SIZE;
+    int dy = diff / MAP_AQUEDUCT_GRID_SIZE;
+    return (dx == 0 || dx == 2) && (dy == 0 || dy == 2);
+}
+
+static int tile_type(int grid_offset)
+{
+    int building_id = reservoir_at[grid_offset];
+    if (building_id) {
+        return is_corner(building_id, grid_offset) ? MAP_AQUEDUCT_NONE : building_id;
+    }
+    return pipes[grid_offset] ? MAP_AQUEDUCT_PIPE : MAP_AQUEDUCT_NONE;
+}
+
+static int reservoir_offset(int building_id)
+{
+    return reservoirs[building_id].offset;
+}
+
+static int reservoir_reached(int building_id)
+{
+    if (reservoirs[building_id].water) {
+        return 0;
+    }
+    reservoirs[building_id].water = 2;
+    return reservoirs[building_id].in_use;
+}
+
+static int add_reservoir(int x, int y, int in_use, int water)
+{
+    for (int dy = 0; dy < 3; dy++) {
+        for (int dx = 0; dx < 3; dx++) {
+            if (reservoir_at[offset(x + dx, y + dy)] || pipes[offset(x + dx, y + dy)]) {
+                return 0;
+            }
+        }
+    }
+    int id = ++num_reservoirs;
+    reservoirs[id].offset = offset(x, y);
+    reservoirs[id].in_use = in_use;
+    reservoirs[id].water = water;
+    for (int dy = 0; dy < 3; dy++) {
+        for (int dx = 0; dx < 3; dx++) {
+            reservoir_at[offset(x + dx, y + dy)] = id;
+        }
+    }
+    return id;
+}
+
+static void add_pipe(int x, int y)
+{
+    if (!reservoir_at[offset(x, y)]) {
+        pipes[offset(x, y)] = 1;
+    }
+}
+
+static void generate_map()
+{
+    memset(pipes, 0, sizeof(pipes));
+    memset(reservoir_at, 0, sizeof(reservoir_at));
+    num_reservoirs = 0;
+    int wanted = 5 + rand() % (MAX_RESERVOIRS - 5);
+    for (int i = 0; i < 4 * wanted && num_reservoirs < wanted; i++) {
+        int in_use = rand() % 10 != 0;
+        add_reservoir(1 + rand() % (MAP_SIZE - 5), 1 + rand() % (MAP_SIZE - 5), in_use, in_use && rand() % 5 == 0 ? 2 : 0);
+    }
+    int num_walks = 10 + rand() % 60;
+    for (int i = 0; i < num_walks; i++) {
+        int x = 1 + rand() % (MAP_SIZE - 2);
+        int y = 1 + rand() % (MAP_SIZE - 2);
+        int length = rand() % 60;
+        for (int step = 0; step < length; step++) {
+            add_pipe(x, y);
+            int direction = rand() % 4;
+            int nx = x + (direction == 1) - (direction == 3);
+            int ny = y + (direction == 2) - (direction == 0);
+            if (nx >= 1 && nx < MAP_SIZE - 1 && ny >= 1 && ny < MAP_SIZE - 1) {
+                x = nx;
+                y = ny;
+            }
+        }
+    }
+}
+
+// The original tile by tile flood fill, from one tile next to a reservoir
+static void reference_fill_from(int grid_offset)
+{
+    if (!pipes[grid_offset]) {
+        return;
+    }
+    int head = 0;
+    int tail = 0;
+    reference_water[grid_offset] = 1;
+    reference_queue[tail++] = grid_offset;
+    while (head < tail) {
+        int current = reference_queue[head++];
+        for (int i = 0; i < 4; i++) {
+            int next = current + ADJACENT[i];
+            int building_id = reservoir_at[next];
+            if (building_id) {
+                if (!is_corner(building_id, next) && !reservoirs[building_id].water) {
+                    reservoirs[building_id].water = 2;
+                }
+            } else if (pipes[next] && !reference_water[next]) {
+                reference_water[next] = 1;
+                reference_queue[tail++] = next;
+            }
+        }
+    }
+}
+
+static void reference_update()
+{
+    memset(reference_water, 0, sizeof(reference_water));
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int id = 1; id <= num_reservoirs; id++) {
+            if (reservoirs[id].in_use && reservoirs[id].water == 2) {
+                reservoirs[id].water = 1;
+                changed = 1;
+                for (int d = 0; d < 4; d++) {
+                    reference_fill_from(reservoirs[id].offset + CONNECTORS[d]);
+                }
+            }
+        }
+    }
+}
+
+static void segment_update()
+{
+    map_aqueduct_grid grid = { start_offset(), MAP_SIZE, MAP_SIZE, tile_type, reservoir_offset };
+    map_aqueduct_build(&grid);
+    int full[MAX_RESERVOIRS];
+    int num_full = 0;
+    for (int id = 1; id <= num_reservoirs; id++) {
+        if (reservoirs[id].in_use && reservoirs[id].water == 2) {
+            full[num_full++] = id;
+        }
+    }
+    map_aqueduct_fill(full, num_full, reservoir_reached);
+    for (int id = 1; id <= num_reservoirs; id++) {
+        if (reservoirs[id].in_use && reservoirs[id].water == 2) {
+            reservoirs[id].water = 1;
+        }
+    }
+}
+
+void test_aqueduct_segments()
+{
+    for (int x = 10; x < 20; x++) {
+        add_pipe(x, 10);
+        add_pipe(x, 12);
+    }
+    add_pipe(10, 11);
+    add_pipe(30, 30);
+    map_aqueduct_grid grid = { start_offset(), MAP_SIZE, MAP_SIZE, tile_type, reservoir_offset };
+
+    map_aqueduct_build(&grid);
+
+    assert_eq(2, map_aqueduct_num_segments());
+    assert_false(map_aqueduct_has_water(offset(10, 10)));
+}
+
+void test_aqueduct_fills_linked_reservoirs()
+{
+    int source = add_reservoir(10, 10, 1, 2);
+    int linked = add_reservoir(20, 10, 1, 0);
+    int corner_only = add_reservoir(10, 20, 1, 0);
+    int not_in_use = add_reservoir(30, 10, 0, 0);
+    int behind_not_in_use = add_reservoir(40, 10, 1, 0);
+    // from the right side of the source to the left side of the linked reservoir
+    for (int x = 13; x < 20; x++) {
+        add_pipe(x, 11);
+    }
+    // from the bottom of the source to the corner of the third reservoir
+    add_pipe(11, 13);
+    add_pipe(11, 14);
+    add_pipe(10, 14);
+    for (int y = 14; y <= 20; y++) {
+        add_pipe(9, y);
+    }
+    // from the linked reservoir through one that is not in use
+    for (int x = 23; x < 30; x++) {
+        add_pipe(x, 11);
+    }
+    for (int x = 33; x < 40; x++) {
+        add_pipe(x, 11);
+    }
+
+    segment_update();
+
+    assert_eq(1, reservoirs[source].water);
+    assert_eq(1, reservoirs[linked].water);
+    assert_eq(0, reservoirs[corner_only].water);
+    assert_eq(2, reservoirs[not_in_use].water);
+    assert_eq(0, reservoirs[behind_not_in_use].water);
+    assert_true(map_aqueduct_has_water(offset(15, 11)));
+    assert_true(map_aqueduct_has_water(offset(9, 20)));
+    assert_true(map_aqueduct_has_water(offset(25, 11)));
+    assert_false(map_aqueduct_has_water(offset(35, 11)));
+}
+
+void test_aqueduct_matches_flood_fill_on_random_maps()
+{
+    int initial[MAX_RESERVOIRS + 1];
+    int reference[MAX_RESERVOIRS + 1];
+    for (int map = 0; map < 200; map++) {
+        generate_map();
+        for (int id = 1; id <= num_reservoirs; id++) {
+            initial[id] = reservoirs[id].water;
+        }
+        reference_update();
+        for (int id = 1; id <= num_reservoirs; id++) {
+            reference[id] = reservoirs[id].water;
+            reservoirs[id].water = initial[id];
+        }
+
+        segment_update();
+
+        for (int id = 1; id <= num_reservoirs; id++) {
+            assert_eq(reference[id], reservoirs[id].water);
+        }
+        for (int y = 0; y < MAP_SIZE; y++) {
+            for (int x = 0; x < MAP_SIZE; x++) {
+                if (pipes[offset(x, y)]) {
+                    assert_eq(reference_water[offset(x, y)], map_aqueduct_has_water(offset(x, y)));
+                }
+            }
+        }
+    }
+}
+
+RUN_TESTS(map/aqueduct,
+    ADD_TEST(test_aqueduct_segments)
+    ADD_TEST(test_aqueduct_fills_linked_reservoirs)
+    ADD_TEST(test_aqueduct_matches_flood_fill_on_random_maps)
+)
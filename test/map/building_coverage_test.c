@@ -0,0 +1,191 @@
+#include "loki/loki.h"
+#include "map/building_coverage.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define GRID_TILES (MAP_BUILDING_COVERAGE_GRID_SIZE * MAP_BUILDING_COVERAGE_GRID_SIZE)
+#define START_OFFSET (MAP_BUILDING_COVERAGE_GRID_SIZE + 1)
+
+static unsigned short building_ids[GRID_TILES];
+
+static int offset(int x, int y)
+{
+    return START_OFFSET + y * MAP_BUILDING_COVERAGE_GRID_SIZE + x;
+}
+
+// buildings 100 and up are parts of building id - 100
+static int main_building(int building_id)
+{
+    return building_id >= 100 ? building_id - 100 : building_id;
+}
+
+static void init(int width, int height, map_building_coverage_main_building main)
+{
+    map_building_coverage_grid grid = { building_ids, START_OFFSET, width, height, main };
+    map_building_coverage_init(&grid);
+}
+
+void setup()
+{
+    memset(building_ids, 0, sizeof(building_ids));
+    init(40, 30, 0);
+}
+
+INIT_MOCKS(
+    SETUP(setup)
+)
+
+void test_building_coverage_empty()
+{
+    const building_coverage *coverage = map_building_coverage_get(10, 10);
+
+    assert_eq(0, coverage->num_buildings);
+    assert_eq(0, coverage->num_tiles);
+}
+
+void test_building_coverage_counts_each_building_once()
+{
+    for (int y = 8; y < 10; y++) {
+        for (int x = 9; x < 11; x++) {
+            building_ids[offset(x, y)] = 5;
+        }
+    }
+    building_ids[offset(12, 9)] = 7;
+    building_ids[offset(13, 9)] = 8;
+
+    const building_coverage *coverage = map_building_coverage_get(10, 10);
+
+    assert_eq(2, coverage->num_buildings);
+    assert_eq(5, coverage->num_tiles);
+    assert_eq(5, coverage->building_ids[0]);
+    assert_eq(4, coverage->building_tiles[0]);
+    assert_eq(7, coverage->building_ids[1]);
+    assert_eq(1, coverage->building_tiles[1]);
+}
+
+void test_building_coverage_tiles_row_by_row()
+{
+    building_ids[offset(11, 8)] = 3;
+    building_ids[offset(8, 9)] = 4;
+    building_ids[offset(12, 9)] = 3;
+    building_ids[offset(9, 12)] = 4;
+
+    const building_coverage *coverage = map_building_coverage_get(10, 10);
+
+    assert_eq(4, coverage->num_tiles);
+    assert_eq(3, coverage->building_ids[coverage->tile_buildings[0]]);
+    assert_eq(4, coverage->building_ids[coverage->tile_buildings[1]]);
+    assert_eq(3, coverage->building_ids[coverage->tile_buildings[2]]);
+    assert_eq(4, coverage->building_ids[coverage->tile_buildings[3]]);
+}
+
+void test_building_coverage_stays_inside_map()
+{
+    building_ids[offset(-1, 0)] = 1;
+    building_ids[offset(0, -1)] = 2;
+    building_ids[offset(40, 29)] = 3;
+    building_ids[offset(39, 30)] = 4;
+    building_ids[offset(0, 0)] = 5;
+    building_ids[offset(39, 29)] = 6;
+
+    const building_coverage *top_left = map_building_coverage_get(0, 0);
+    assert_eq(1, top_left->num_buildings);
+    assert_eq(5, top_left->building_ids[0]);
+
+    const building_coverage *bottom_right = map_building_coverage_get(39, 29);
+    assert_eq(1, bottom_right->num_buildings);
+    assert_eq(6, bottom_right->building_ids[0]);
+
+    const building_coverage *outside = map_building_coverage_get(41, 29);
+    assert_eq(1, outside->num_buildings);
+    assert_eq(6, outside->building_ids[0]);
+}
+
+void test_building_coverage_main_building()
+{
+    init(40, 30, main_building);
+    building_ids[offset(9, 10)] = 9;
+    building_ids[offset(10, 10)] = 109;
+    building_ids[offset(11, 10)] = 12;
+
+    const building_coverage *coverage = map_building_coverage_get(10, 10);
+
+    assert_eq(2, coverage->num_buildings);
+    assert_eq(9, coverage->building_ids[0]);
+    assert_eq(2, coverage->building_tiles[0]);
+    assert_eq(12, coverage->building_ids[1]);
+}
+
+void test_building_coverage_tile_changed()
+{
+    map_building_coverage_get(10, 10);
+    map_building_coverage_get(14, 10);
+    map_building_coverage_get(15, 10);
+
+    building_ids[offset(12, 12)] = 8;
+    map_building_coverage_tile_changed(offset(12, 12));
+
+    assert_eq(1, map_building_coverage_get(10, 10)->num_buildings);
+    assert_eq(1, map_building_coverage_get(14, 10)->num_buildings);
+    // out of range of the changed tile: the list is kept
+    building_ids[offset(16, 10)] = 9;
+    assert_eq(0, map_building_coverage_get(15, 10)->num_buildings);
+
+    map_building_coverage_clear();
+    assert_eq(1, map_building_coverage_get(15, 10)->num_buildings);
+}
+
+static int scan_tiles(int x, int y, int *tiles)
+{
+    int num_tiles = 0;
+    for (int yy = y - 2; yy <= y + 2; yy++) {
+        for (int xx = x - 2; xx <= x + 2; xx++) {
+            if (xx >= 0 && yy >= 0 && xx < 40 && yy < 30 && building_ids[offset(xx, yy)]) {
+                tiles[num_tiles++] = main_building(building_ids[offset(xx, yy)]);
+            }
+        }
+    }
+    return num_tiles;
+}
+
+void test_building_coverage_matches_scan()
+{
+    int tiles[MAP_BUILDING_COVERAGE_MAX_TILES];
+    init(40, 30, main_building);
+    srand(22);
+    for (int step = 0; step < 20000; step++) {
+        int x = rand() % 40;
+        int y = rand() % 30;
+        if (rand() % 2) {
+            int building_id = rand() % 4 ? 0 : rand() % 120;
+            building_ids[offset(x, y)] = building_id;
+            map_building_coverage_tile_changed(offset(x, y));
+            continue;
+        }
+        const building_coverage *coverage = map_building_coverage_get(x, y);
+        int num_tiles = scan_tiles(x, y, tiles);
+        assert_eq(num_tiles, coverage->num_tiles);
+        int tile_total = 0;
+        for (int i = 0; i < coverage->num_buildings; i++) {
+            tile_total += coverage->building_tiles[i];
+            for (int j = 0; j < i; j++) {
+                assert_false(coverage->building_ids[i] == coverage->building_ids[j]);
+            }
+        }
+        assert_eq(num_tiles, tile_total);
+        for (int t = 0; t < num_tiles; t++) {
+            assert_eq(tiles[t], coverage->building_ids[coverage->tile_buildings[t]]);
+        }
+    }
+}
+
+RUN_TESTS(map/building_coverage,
+    ADD_TEST(test_building_coverage_empty)
+    ADD_TEST(test_building_coverage_counts_each_building_once)
+    ADD_TEST(test_building_coverage_tiles_row_by_row)
+    ADD_TEST(test_building_coverage_stays_inside_map)
+    ADD_TEST(test_building_coverage_main_building)
+    ADD_TEST(test_building_coverage_tile_changed)
+    ADD_TEST(test_building_coverage_matches_scan)
+)
@@ -0,0 +1,281 @@
+#include "loki/loki.h"
+#include "map/ring.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define GRID_TILES (MAP_RING_GRID_SIZE * MAP_RING_GRID_SIZE)
+
+static char expected[GRID_TILES];
+static char actual[GRID_TILES];
+
+void setup()
+{
+    map_ring_init();
+    srand(16);
+}
+
+INIT_MOCKS(
+    SETUP(setup)
+)
+
+static void fill_random(char *grid)
+{
+    for (int i = 0; i < GRID_TILES; i++) {
+        // values outside -100..100 come from unclamped rings at the map edge
+        grid[i] = rand() % 3 ? rand() % 201 - 100 : rand() % 256 - 128;
+    }
+}
+
+static map_ring_grid create_grid(char *tiles, int width, int height)
+{
+    map_ring_grid grid = {
+        tiles,
+        MAP_RING_GRID_SIZE * ((MAP_RING_GRID_SIZE - height) / 2) + (MAP_RING_GRID_SIZE - width) / 2,
+        width,
+        height
+    };
+    return grid;
+}
+
+static void random_desirability(map_ring_desirability *desirability)
+{
+    desirability->size = 1 + rand() % MAP_RING_MAX_SIZE;
+    desirability->value = rand() % 61 - 30;
+    desirability->step = rand() % 4;
+    desirability->step_size = rand() % 11 - 5;
+    desirability->range = rand() % 9 - 1;
+}
+
+static double now_millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+void test_ring_sizes()
+{
+    for (int size = 1; size <= MAP_RING_MAX_SIZE; size++) {
+        for (int distance = 1; distance <= MAP_RING_MAX_DISTANCE; distance++) {
+            assert_eq(4 * (size - 1) + 8 * distance, map_ring_end(size, distance) - map_ring_start(size, distance));
+        }
+    }
+    assert_eq(map_ring_end(1, 1), map_ring_start(1, 2));
+    assert_eq(0, map_ring_start(1, 1));
+}
+
+void test_ring_tiles_distance_one()
+{
+    int start = map_ring_start(1, 1);
+    const ring_tile *first = map_ring_tile(start);
+    const ring_tile *last = map_ring_tile(map_ring_end(1, 1) - 1);
+
+    assert_eq(0, first->x);
+    assert_eq(-1, first->y);
+    assert_eq(-MAP_RING_GRID_SIZE, first->grid_offset);
+    assert_eq(-1, last->x);
+    assert_eq(-1, last->y);
+}
+
+void test_ring_quirk_size_four_distance_two()
+{
+    // the bottom-left corner is replaced by a tile of distance 1
+    int found_corner = 0;
+    int found_inner = 0;
+    for (int i = map_ring_start(4, 2); i < map_ring_end(4, 2); i++) {
+        const ring_tile *tile = map_ring_tile(i);
+        if (tile->x == -2 && tile->y == 5) {
+            found_corner = 1;
+        }
+        if (tile->x == -1 && tile->y == 4) {
+            found_inner = 1;
+        }
+    }
+    assert_false(found_corner);
+    assert_true(found_inner);
+}
+
+void test_ring_add_desirability_clamps()
+{
+    memset(actual, 0, sizeof(actual));
+    map_ring_grid grid = create_grid(actual, 160, 160);
+    map_ring_desirability desirability = {1, 60, 1, -10, 3};
+    map_ring_add_desirability(&grid, 80, 80, &desirability, 0);
+    map_ring_add_desirability(&grid, 80, 80, &desirability, 0);
+
+    int base = grid.start_offset + 80 * MAP_RING_GRID_SIZE + 80;
+    assert_eq(0, actual[base]);
+    assert_eq(100, actual[base + 1]);
+    assert_eq(100, actual[base - 2 * MAP_RING_GRID_SIZE]);
+    assert_eq(80, actual[base + 3]);
+    assert_eq(0, actual[base + 4]);
+}
+
+void test_ring_add_desirability_same_as_per_ring()
+{
+    int mismatches = 0;
+    map_ring_desirability desirability;
+    for (int round = 0; round < 50; round++) {
+        int width = 20 + rand() % 141;
+        int height = 20 + rand() % 141;
+        fill_random(expected);
+        memcpy(actual, expected, sizeof(actual));
+        map_ring_grid expected_grid = create_grid(expected, width, height);
+        map_ring_grid actual_grid = create_grid(actual, width, height);
+        for (int i = 0; i < 500; i++) {
+            random_desirability(&desirability);
+            int x = rand() % (width - desirability.size + 3) - 1;
+            int y = rand() % (height - desirability.size + 3) - 1;
+            map_ring_add_desirability_per_ring(&expected_grid, x, y, &desirability, 0);
+            map_ring_add_desirability(&actual_grid, x, y, &desirability, 0);
+        }
+        if (memcmp(expected, actual, sizeof(actual)) != 0) {
+            mismatches++;
+        }
+    }
+    assert_eq(0, mismatches);
+}
+
+void test_ring_add_desirability_in_area_same_as_per_ring()
+{
+    int mismatches = 0;
+    map_ring_desirability desirability;
+    for (int round = 0; round < 50; round++) {
+        fill_random(expected);
+        memcpy(actual, expected, sizeof(actual));
+        map_ring_grid expected_grid = create_grid(expected, 160, 160);
+        map_ring_grid actual_grid = create_grid(actual, 160, 160);
+        map_ring_area area;
+        area.x_min = rand() % 162 - 1;
+        area.y_min = rand() % 162 - 1;
+        area.x_max = area.x_min + rand() % 30;
+        area.y_max = area.y_min + rand() % 30;
+        for (int i = 0; i < 500; i++) {
+            random_desirability(&desirability);
+            int x = area.x_min + rand() % 40 - 10;
+            int y = area.y_min + rand() % 40 - 10;
+            if (x < -1 || y < -1 || x > 160 || y > 160) {
+                continue;
+            }
+            map_ring_add_desirability_per_ring(&expected_grid, x, y, &desirability, &area);
+            map_ring_add_desirability(&actual_grid, x, y, &desirability, &area);
+        }
+        if (memcmp(expected, actual, sizeof(actual)) != 0) {
+            mismatches++;
+        }
+    }
+    assert_eq(0, mismatches);
+}
+
+#define NUM_THREADS 4
+#define NUM_THREAD_BUILDINGS 2000
+
+static struct {
+    int x;
+    int y;
+    map_ring_desirability desirability;
+} thread_buildings[NUM_THREAD_BUILDINGS];
+
+static void *add_desirability_in_rows(void *arg)
+{
+    int thread = *(int *) arg;
+    map_ring_grid grid = create_grid(actual, 160, 160);
+    map_ring_area rows = { -1, thread * 41 - 1, 160, thread * 41 + 39 };
+    for (int i = 0; i < NUM_THREAD_BUILDINGS; i++) {
+        map_ring_add_desirability(&grid, thread_buildings[i].x, thread_buildings[i].y,
+            &thread_buildings[i].desirability, &rows);
+    }
+    return 0;
+}
+
+void test_ring_add_desirability_rows_in_threads()
+{
+    for (int i = 0; i < NUM_THREAD_BUILDINGS; i++) {
+        random_desirability(&thread_buildings[i].desirability);
+        // many buildings near the right edge, where stamped rows end close to the next grid row
+        thread_buildings[i].x = i % 2 ? 140 + rand() % 21 : rand() % 162 - 1;
+        thread_buildings[i].y = rand() % 162 - 1;
+    }
+    fill_random(expected);
+    memcpy(actual, expected, sizeof(actual));
+    map_ring_grid expected_grid = create_grid(expected, 160, 160);
+    for (int i = 0; i < NUM_THREAD_BUILDINGS; i++) {
+        map_ring_add_desirability_per_ring(&expected_grid, thread_buildings[i].x, thread_buildings[i].y,
+            &thread_buildings[i].desirability, 0);
+    }
+
+    pthread_t threads[NUM_THREADS];
+    int thread_index[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        thread_index[i] = i;
+        pthread_create(&threads[i], 0, add_desirability_in_rows, &thread_index[i]);
+    }
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], 0);
+    }
+
+    assert_eq(0, memcmp(expected, actual, sizeof(actual)));
+}
+
+void test_ring_benchmark()
+{
+    // a full desirability update: 2000 buildings of 30 different models
+    map_ring_desirability models[30];
+    for (int i = 0; i < 30; i++) {
+        models[i].size = 1 + rand() % 3;
+        models[i].value = rand() % 2 ? -2 - rand() % 4 : 2 + rand() % 12;
+        models[i].step = 1 + rand() % 2;
+        models[i].step_size = models[i].value < 0 ? 1 : -1 - rand() % 2;
+        models[i].range = 2 + rand() % 5;
+    }
+    static struct {
+        int x;
+        int y;
+        int model;
+    } buildings[2000];
+    for (int i = 0; i < 2000; i++) {
+        buildings[i].x = rand() % 158;
+        buildings[i].y = rand() % 158;
+        buildings[i].model = rand() % 30;
+    }
+    memset(expected, 0, sizeof(expected));
+    memset(actual, 0, sizeof(actual));
+    map_ring_grid expected_grid = create_grid(expected, 160, 160);
+    map_ring_grid actual_grid = create_grid(actual, 160, 160);
+
+    double start = now_millis();
+    for (int run = 0; run < 20; run++) {
+        for (int i = 0; i < 2000; i++) {
+            map_ring_add_desirability_per_ring(&expected_grid, buildings[i].x, buildings[i].y,
+                &models[buildings[i].model], 0);
+        }
+    }
+    double per_ring_millis = now_millis() - start;
+    start = now_millis();
+    for (int run = 0; run < 20; run++) {
+        for (int i = 0; i < 2000; i++) {
+            map_ring_add_desirability(&actual_grid, buildings[i].x, buildings[i].y,
+                &models[buildings[i].model], 0);
+        }
+    }
+    double stamp_millis = now_millis() - start;
+    printf("  per ring: %.3f ms, stamped: %.3f ms per 2000 buildings\n",
+        per_ring_millis / 20, stamp_millis / 20);
+
+    assert_eq(0, memcmp(expected, actual, sizeof(actual)));
+}
+
+RUN_TESTS(map/ring,
+    ADD_TEST(test_ring_sizes)
+    ADD_TEST(test_ring_tiles_distance_one)
+    ADD_TEST(test_ring_quirk_size_four_distance_two)
+    ADD_TEST(test_ring_add_desirability_clamps)
+    ADD_TEST(test_ring_add_desirability_same_as_per_ring)
+    ADD_TEST(test_ring_add_desirability_in_area_same_as_per_ring)
+    ADD_TEST(test_ring_add_desirability_rows_in_threads)
+    ADD_TEST(test_ring_benchmark)
+)
@@ -0,0 +1,117 @@
+#include "loki/loki.h"
+#include "map/route_limit.h"
+
+#include <string.h>
+
+#define GRID 121
+#define CENTER 60
+#define MAX_TILES 5000
+
+static int distance[GRID * GRID];
+static int queue[GRID * GRID];
+
+NO_MOCKS()
+
+// Same order as the routing flood fill: up, right, down, left
+static const int neighbours[4] = { -GRID, 1, GRID, -1 };
+
+// Floods open terrain from the center and returns the number of tiles
+// taken from the queue before the destination, 0 if it was not reached
+static int tiles_before(int dest)
+{
+    memset(distance, 0, sizeof(distance));
+    int head = 0;
+    int tail = 0;
+    int source = CENTER * GRID + CENTER;
+    distance[source] = 1;
+    queue[tail++] = source;
+    int tiles = 0;
+    while (head < tail) {
+        int offset = queue[head++];
+        if (offset == dest) {
+            return tiles;
+        }
+        tiles++;
+        int x = offset % GRID;
+        int y = offset / GRID;
+        for (int i = 0; i < 4; i++) {
+            if ((i == 1 && x == GRID - 1) || (i == 3 && x == 0) ||
+                (i == 0 && y == 0) || (i == 2 && y == GRID - 1)) {
+                continue;
+            }
+            int next = offset + neighbours[i];
+            if (!distance[next]) {
+                distance[next] = distance[offset] + 1;
+                queue[tail++] = next;
+            }
+        }
+    }
+    return 0;
+}
+
+static int route_distance(int x, int y)
+{
+    int dx = x > CENTER ? x - CENTER : CENTER - x;
+    int dy = y > CENTER ? y - CENTER : CENTER - y;
+    return dx + dy + 1;
+}
+
+void test_route_limit_small_distances()
+{
+    assert_eq(0, map_route_limit_tiles_before(1));
+    assert_eq(5, map_route_limit_tiles_before(2));
+    assert_eq(13, map_route_limit_tiles_before(3));
+}
+
+void test_route_limit_covers_open_terrain()
+{
+    for (int y = 0; y < GRID; y++) {
+        for (int x = 0; x < GRID; x++) {
+            int dist = route_distance(x, y);
+            if (dist > CENTER + 1) {
+                continue;
+            }
+            int tiles = tiles_before(y * GRID + x);
+            assert_true(tiles <= map_route_limit_tiles_before(dist));
+        }
+    }
+}
+
+void test_route_limit_at_tile_limit()
+{
+    // 51 is the first distance where the tiles strictly closer still fit in
+    // the limit but the tiles on the same distance do not
+    int dist = 51;
+    int radius = dist - 2;
+    int closer = 2 * radius * radius + 2 * radius + 1;
+    assert_true(closer <= MAX_TILES);
+    assert_true(map_route_limit_tiles_before(dist) > MAX_TILES);
+
+    // on open terrain, the flood fill gives up before some of those destinations
+    int over_limit = 0;
+    int max_tiles = 0;
+    for (int y = 0; y < GRID; y++) {
+        for (int x = 0; x < GRID; x++) {
+            if (route_distance(x, y) == dist) {
+                int tiles = tiles_before(y * GRID + x);
+                if (tiles > MAX_TILES) {
+                    over_limit++;
+                }
+                if (tiles > max_tiles) {
+                    max_tiles = tiles;
+                }
+            }
+        }
+    }
+    assert_true(over_limit > 0);
+    assert_eq(map_route_limit_tiles_before(dist), max_tiles + 1);
+
+    // one step closer, the whole ring fits
+    assert_true(map_route_limit_tiles_before(dist - 1) <= MAX_TILES);
+}
+
+RUN_TESTS(map/route_limit,
+    ADD_TEST(test_route_limit_small_distances)
+    ADD_TEST(test_route_limit_covers_open_terrain)
+    ADD_TEST(test_route_limit_at_tile_limit)
+)